@@ -3,6 +3,7 @@
 #include "../../../common/drivers/platform/stm32f4/st_gpio.h"
 #include "../../../mcu_support/stm32/f4xx/stm32f4xx.h"
 #include "board.h"
+#include "timebase.h"
 
 namespace MM
 {
@@ -24,6 +25,8 @@ bool board_init()
     bool return_val = true;
     RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;
     return_val &= led.init();
+    // Reset clock (16 MHz HSI), cycle counter only
+    return_val &= Utils::timebase_init(Utils::TimebaseConfig{});
     return return_val;
 }
 
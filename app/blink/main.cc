@@ -1,18 +1,25 @@
 #include <cstdlib>
 #include "board.h"
 #include "gpio.h"
+#include "scheduler.h"
 
 using namespace MM;
 
+static void blink(void*)
+{
+    get_board().led.toggle();
+}
+
+static constexpr auto kTasks = make_task_table({
+    Task{"blink", blink, nullptr, 250000, 1},  // 2 Hz
+});
+
 int main(int argc, char* argv[])
 {
     board_init();
-    Board hw = get_board();
-    while (1)
-    {
-        hw.led.toggle();
-        for (volatile size_t i = 0; i < 100000; i++);  // Delay
-    }
+
+    Scheduler scheduler(kTasks);
+    scheduler.run();
 
     return 0;
 }
@@ -0,0 +1,27 @@
+/**
+ * @file board.h
+ * @brief BSP interface for the GPIO access benchmark
+ * @author TJ
+ * @date 2026-10-18
+ */
+
+#pragma once
+#include "gpio.h"
+#include "st_static_gpio.h"
+
+namespace MM
+{
+
+/// Same physical pin as Board::led, fixed at compile time
+using StaticLed = Stmf4::StaticGpio<GPIOA_BASE, 5>;
+
+struct Board
+{
+    Gpio& led;
+    StaticLed& static_led;
+};
+
+bool bsp_init(void);
+Board& get_board(void);
+
+}  // namespace MM
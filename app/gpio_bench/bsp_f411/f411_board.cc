@@ -0,0 +1,33 @@
+#include "board.h"
+#include "st_gpio.h"
+#include "timebase.h"
+
+namespace MM
+{
+
+// LD2 on the Nucleo F411RE (PA5)
+Stmf4::StGpioSettings led_settings{
+    Stmf4::GpioMode::GPOUT, Stmf4::GpioOtype::PUSH_PULL,
+    Stmf4::GpioOspeed::VERY_HIGH, Stmf4::GpioPupd::NO_PULL, 0};
+
+Stmf4::HwGpio led{Stmf4::StGpioParams{5, GPIOA, led_settings}};
+StaticLed static_led;
+
+Board board{.led = led, .static_led = static_led};
+
+bool bsp_init()
+{
+    bool return_val = true;
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;
+    return_val &= StaticLed::init(led_settings);
+    // Reset clock (16 MHz HSI), cycle counter only
+    return_val &= Utils::timebase_init(Utils::TimebaseConfig{});
+    return return_val;
+}
+
+Board& get_board(void)
+{
+    return board;
+}
+
+}  // namespace MM
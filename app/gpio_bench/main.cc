@@ -0,0 +1,94 @@
+/**
+ * @file main.cc
+ * @brief Cycle cost of a GPIO write through the Gpio interface vs StaticGpio
+ * @author TJ
+ * @date 2026-10-18
+ * @details Each loop drives the same pin kIterations times and is timed
+ * with the DWT cycle counter. Results land in bench_results for a debugger
+ * to read; the build prints the code size of both loops. Everything on
+ * the measured paths is built at -O2 (see CMakeLists.txt); with
+ * TARGET_APP left empty hal keeps the toolchain's -O0 and the virtual
+ * numbers come out high.
+ */
+
+#include <cstdint>
+#include "board.h"
+#include "gpio_cs.h"
+#include "timebase.h"
+
+using namespace MM;
+
+static constexpr uint32_t kIterations = 1000;
+
+struct BenchResults
+{
+    uint32_t virtual_cycles;     ///< Per set(), through Gpio&
+    uint32_t static_cycles;      ///< Per set(), StaticGpio
+    uint32_t virtual_cs_cycles;  ///< Per enable/disable pair, GpioChipSelect
+    uint32_t static_cs_cycles;   ///< Per enable/disable pair, ChipSelect<>
+};
+
+volatile BenchResults bench_results;
+
+// noinline keeps each loop a separate symbol, so nm can size it and the
+// compiler cannot fold the virtual call away using the BSP's concrete type
+[[gnu::noinline]] static void bench_toggle_virtual(Gpio& pin)
+{
+    for (uint32_t i = 0; i < kIterations; i++)
+    {
+        pin.set(true);
+        pin.set(false);
+    }
+}
+
+[[gnu::noinline]] static void bench_toggle_static(StaticLed& pin)
+{
+    for (uint32_t i = 0; i < kIterations; i++)
+    {
+        pin.set(true);
+        pin.set(false);
+    }
+}
+
+template <typename Cs>
+[[gnu::noinline]] static void bench_toggle_cs(Cs& cs)
+{
+    for (uint32_t i = 0; i < kIterations; i++)
+    {
+        cs.cs_enable();
+        cs.cs_disable();
+    }
+}
+
+template <typename Fn>
+static uint32_t cycles_per_iteration(Fn&& fn)
+{
+    const uint32_t begin = Utils::now_cycles();
+    fn();
+    return (Utils::now_cycles() - begin) / kIterations;
+}
+
+int main(void)
+{
+    bsp_init();
+    Board& board = get_board();
+
+    GpioChipSelect virtual_cs{board.led};
+    ChipSelect<StaticLed> static_cs{board.static_led};
+
+    while (1)
+    {
+        // Two set() calls per iteration
+        bench_results.virtual_cycles =
+            cycles_per_iteration([&] { bench_toggle_virtual(board.led); }) / 2;
+        bench_results.static_cycles = cycles_per_iteration([&] {
+            bench_toggle_static(board.static_led);
+        }) / 2;
+        bench_results.virtual_cs_cycles =
+            cycles_per_iteration([&] { bench_toggle_cs(virtual_cs); });
+        bench_results.static_cs_cycles =
+            cycles_per_iteration([&] { bench_toggle_cs(static_cs); });
+    }
+
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include <cstdint>
 #include "board.h"
+#include "st_clock.h"
 #include "st_gpio.h"
 #include "st_i2c.h"
 
@@ -22,16 +23,19 @@ Stmf4::StGpioParams sda_params{9, GPIOB, sda_settings};  // PB9
 Stmf4::HwGpio scl(scl_params);
 Stmf4::HwGpio sda(sda_params);
 
-static constexpr uint16_t CCR_100KHZ = 0x1F4;
-static constexpr uint16_t TRISE_100KHZ = 0x2B;
+static constexpr Stmf4::ClockConfig kClock = Stmf4::kClock100MHz;
 
-Stmf4::StI2cParams i2c_params{I2C1, CCR_100KHZ, TRISE_100KHZ};
+Stmf4::StI2cParams i2c_params =
+    Stmf4::i2c_timing(I2C1, kClock.tree.pclk1_hz, 100000);
 Stmf4::HwI2c i2c(i2c_params);
 
 Board board{.i2c = i2c};
 
 bool bsp_init()
 {
+    if (!Stmf4::clock_init(kClock))
+        return false;
+
     // Enable peripheral clocks for I2C1 and GPIOB
     RCC->AHB1ENR |= RCC_AHB1ENR_GPIOBEN;
     RCC->APB1ENR |= RCC_APB1ENR_I2C1EN;
@@ -42,6 +46,7 @@ bool bsp_init()
     ret = ret && sda.init();
     ret = ret && scl.init();
     ret = ret && i2c.init();
+    ret = ret && i2c.enable_irq(I2C1_EV_IRQn, I2C1_ER_IRQn);
     return ret;
 }
 
@@ -50,4 +55,14 @@ Board& get_board()
     return board;
 }
 
-}  // namespace MM
\ No newline at end of file
+}  // namespace MM
+
+extern "C" void I2C1_EV_IRQHandler()
+{
+    MM::i2c.ev_irq_handler();
+}
+
+extern "C" void I2C1_ER_IRQHandler()
+{
+    MM::i2c.er_irq_handler();
+}
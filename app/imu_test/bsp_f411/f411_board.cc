@@ -1,8 +1,10 @@
 #include <cstdint>
 #include "../board.h"
 #include "bno055_imu.h"
+#include "st_clock.h"
 #include "st_gpio.h"
 #include "st_i2c.h"
+#include "timebase.h"
 
 namespace MM
 {
@@ -17,10 +19,10 @@ Stmf4::StGpioParams sda_params{9, GPIOB, gpio_settings};
 Stmf4::HwGpio scl(scl_params);
 Stmf4::HwGpio sda(sda_params);
 
-static constexpr uint16_t CCR_100KHZ = 0x1F4;
-static constexpr uint16_t TRISE_100KHZ = 0x2B;
+static constexpr Stmf4::ClockConfig kClock = Stmf4::kClock100MHz;
 
-Stmf4::StI2cParams i2c_params{I2C1, CCR_100KHZ, TRISE_100KHZ};
+Stmf4::StI2cParams i2c_params =
+    Stmf4::i2c_timing(I2C1, kClock.tree.pclk1_hz, 100000);
 Stmf4::HwI2c i2c(i2c_params);
 
 Stmf4::StGpioSettings rst_settings{
@@ -35,13 +37,21 @@ Board board{.imu = imu};
 
 bool bsp_init()
 {
-    // Enable GPIOB and I2C1 clocks
+    if (!Stmf4::clock_init(kClock))
+        return false;
+
+    // Enable GPIOB, I2C1 and TIM5 (timebase) clocks
     RCC->AHB1ENR |= RCC_AHB1ENR_GPIOBEN;
-    RCC->APB1ENR |= RCC_APB1ENR_I2C1EN;
+    RCC->APB1ENR |= RCC_APB1ENR_I2C1EN | RCC_APB1ENR_TIM5EN;
+
+    Utils::timebase_init({.core_clock_hz = kClock.tree.hclk_hz,
+                          .timer_clock_hz = kClock.tree.apb1_timer_hz,
+                          .timer_base = TIM5_BASE});
 
     scl.init();
     sda.init();
     i2c.init();
+    i2c.enable_irq(I2C1_EV_IRQn, I2C1_ER_IRQn);
     rst.init();
 
     // BNO055 reset sequence
@@ -67,3 +77,13 @@ Board& get_board()
 }
 
 }  // namespace MM
+
+extern "C" void I2C1_EV_IRQHandler()
+{
+    MM::i2c.ev_irq_handler();
+}
+
+extern "C" void I2C1_ER_IRQHandler()
+{
+    MM::i2c.er_irq_handler();
+}
@@ -0,0 +1,369 @@
+/**
+ * @file main.cc
+ * @brief Host benchmark of the maze model, flood fill and path planner
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Prints the maze footprint and wall set/query rates, then
+ * checks incremental flood-fill updates against a full re-flood on random
+ * mazes. Walls are revealed one at a time, and after each one the two
+ * distance maps are compared. Finally it times the diagonal speed-run
+ * planner on every maze of the regression corpus in
+ * common/core/maze/test/mazes, fully explored. The exit code is non-zero
+ * on any mismatch or unsolvable plan.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+#include "flood_fill.h"
+#include "maze.h"
+#include "maze_corpus.h"
+#include "maze_text.h"
+#include "path_planner.h"
+
+using namespace MM;
+
+namespace
+{
+
+constexpr uint32_t kRounds = 2000;
+
+// Result sink so the optimiser cannot drop the query loops
+volatile uint32_t sink;
+
+template <typename Fn>
+double mops(uint64_t ops, Fn&& fn)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    fn();
+    const auto end = std::chrono::steady_clock::now();
+    const double s = std::chrono::duration<double>(end - begin).count();
+    return static_cast<double>(ops) / s / 1e6;
+}
+
+template <uint8_t W, uint8_t H>
+void bench(const char* name)
+{
+    using M = Maze<W, H>;
+    static M maze;
+    const uint64_t wall_ops = static_cast<uint64_t>(kRounds) * M::kCells * 4;
+
+    // Pseudo-random but repeatable wall pattern
+    const double set_rate = mops(wall_ops, [] {
+        uint32_t lfsr = 0xACE1u;
+        for (uint32_t r = 0; r < kRounds; r++)
+        {
+            for (size_t i = 0; i < M::kCells; i++)
+            {
+                for (Direction d : Dir::kAll)
+                {
+                    lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+                    maze.set_wall(M::cell(i), d, lfsr & 1u);
+                }
+            }
+        }
+    });
+
+    const double query_rate = mops(wall_ops, [] {
+        uint32_t open = 0;
+        for (uint32_t r = 0; r < kRounds; r++)
+        {
+            for (size_t i = 0; i < M::kCells; i++)
+            {
+                for (Direction d : Dir::kAll)
+                    open += maze.is_open(M::cell(i), d);
+            }
+        }
+        sink = open;
+    });
+
+    const double cell_rate =
+        mops(static_cast<uint64_t>(kRounds) * M::kCells, [] {
+            uint32_t acc = 0;
+            for (uint32_t r = 0; r < kRounds; r++)
+            {
+                for (size_t i = 0; i < M::kCells; i++)
+                    acc += maze.walls(M::cell(i));
+            }
+            sink = acc;
+        });
+
+    // One load per row instead of W wall queries
+    const double row_rate = mops(static_cast<uint64_t>(kRounds) * H, [] {
+        uint32_t acc = 0;
+        for (uint32_t r = 0; r < kRounds; r++)
+        {
+            for (uint8_t y = 0; y < H; y++)
+                acc += __builtin_popcountll(
+                    maze.row_walls(y, Direction::NORTH));
+        }
+        sink = acc;
+    });
+
+    std::printf("%-6s %5zu B %10.1f %10.1f %10.1f %10.1f\n", name, sizeof(M),
+                set_rate, query_rate, cell_rate, row_rate);
+}
+
+struct Lfsr
+{
+    uint32_t state;
+
+    uint32_t next()
+    {
+        // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+/**
+ * @brief Random perfect maze (recursive backtracker) with a few loops
+ */
+template <uint8_t W, uint8_t H>
+void generate(Maze<W, H>& truth, uint32_t seed)
+{
+    using M = Maze<W, H>;
+    for (size_t i = 0; i < M::kCells; i++)
+    {
+        for (Direction d : Dir::kAll)
+            truth.set_wall(M::cell(i), d, true);
+    }
+
+    Lfsr rng{seed};
+    static std::array<bool, M::kCells> seen;
+    static std::array<Cell, M::kCells> stack;
+    seen.fill(false);
+    size_t depth = 0;
+    stack[depth++] = Cell{0, 0};
+    seen[0] = true;
+    while (depth > 0)
+    {
+        const Cell c = stack[depth - 1];
+        Direction options[4];
+        uint8_t count = 0;
+        for (Direction d : Dir::kAll)
+        {
+            Cell n;
+            if (M::neighbour(c, d, n) && !seen[M::index(n)])
+                options[count++] = d;
+        }
+        if (count == 0)
+        {
+            depth--;
+            continue;
+        }
+        const Direction d = options[rng.next() % count];
+        Cell n;
+        M::neighbour(c, d, n);
+        truth.set_wall(c, d, false);
+        seen[M::index(n)] = true;
+        stack[depth++] = n;
+    }
+
+    // Knock out some extra walls so there are multiple routes
+    for (size_t k = 0; k < M::kCells / 8; k++)
+        truth.set_wall(M::cell(rng.next() % M::kCells),
+                       Dir::kAll[rng.next() % 4], false);
+}
+
+/**
+ * @brief Reveal @p truth wall by wall; compare incremental vs full flood
+ * @return Number of reveals after which the two distance maps differed
+ */
+template <uint8_t W, uint8_t H>
+uint32_t check_incremental(uint32_t seed, uint32_t& worst_cells,
+                           double& worst_us, uint64_t& total_cells,
+                           uint32_t& updates)
+{
+    using M = Maze<W, H>;
+    using F = FloodFill<W, H>;
+    static M truth;
+    static M known;
+    static F incremental;
+    static F full;
+    generate(truth, seed);
+    known.clear();
+
+    const Cell goals[] = {{W / 2 - 1, H / 2 - 1},
+                          {W / 2, H / 2 - 1},
+                          {W / 2 - 1, H / 2},
+                          {W / 2, H / 2}};
+    incremental.set_goals(goals);
+    full.set_goals(goals);
+    incremental.flood(known);
+    incremental.reset_stats();
+
+    // Reveal cells in a random order, as a mouse would see them
+    Lfsr rng{seed * 7919u + 1u};
+    uint32_t mismatches = 0;
+    for (size_t step = 0; step < M::kCells; step++)
+    {
+        const Cell c = M::cell(rng.next() % M::kCells);
+        for (Direction d : Dir::kAll)
+        {
+            if (known.is_known(c, d))
+                continue;
+            const bool wall = truth.has_wall(c, d);
+            known.set_wall(c, d, wall);
+            if (!wall)
+                continue;
+
+            const auto begin = std::chrono::steady_clock::now();
+            incremental.wall_added(known, c, d);
+            const double us = std::chrono::duration<double, std::micro>(
+                                  std::chrono::steady_clock::now() - begin)
+                                  .count();
+            if (us > worst_us)
+                worst_us = us;
+            total_cells += incremental.stats().last_cells;
+            updates++;
+
+            full.flood(known);
+            for (size_t i = 0; i < M::kCells; i++)
+            {
+                if (incremental.distance(M::cell(i)) !=
+                    full.distance(M::cell(i)))
+                {
+                    mismatches++;
+                    break;
+                }
+            }
+        }
+    }
+    if (incremental.stats().max_cells > worst_cells)
+        worst_cells = incremental.stats().max_cells;
+    return mismatches;
+}
+
+template <uint8_t W, uint8_t H>
+uint32_t verify(const char* name, uint32_t mazes)
+{
+    uint32_t mismatches = 0;
+    uint32_t worst_cells = 0;
+    double worst_us = 0.0;
+    uint64_t total_cells = 0;
+    uint32_t updates = 0;
+    for (uint32_t seed = 1; seed <= mazes; seed++)
+        mismatches += check_incremental<W, H>(seed, worst_cells, worst_us,
+                                              total_cells, updates);
+
+    // Cost of one full flood of the empty maze for comparison
+    static Maze<W, H> empty;
+    static FloodFill<W, H> reference;
+    const Cell goal[] = {{0, 0}};
+    reference.set_goals(goal);
+    reference.flood(empty);
+
+    std::printf("%-6s %3u mazes, %u mismatches; incremental mean %.1f / "
+                "worst %u cells (%.1f us); full flood %u cells\n",
+                name, mazes, mismatches,
+                static_cast<double>(total_cells) / updates, worst_cells,
+                worst_us, reference.stats().last_cells);
+    return mismatches;
+}
+
+constexpr uint32_t kPlanRepeats = 100;
+
+/**
+ * @brief Time the speed-run planner on one fully explored corpus maze
+ * @return false if the maze does not parse or has no plan
+ */
+template <uint8_t W, uint8_t H>
+bool plan(const Corpus::MazeFile& file)
+{
+    using M = Maze<W, H>;
+    static M truth;
+    static PathPlanner<W, H> planner;
+    Cell goals[16];
+    size_t num_goals = 0;
+    if (!MazeText::parse(file.text, truth, std::span<Cell>(goals),
+                         num_goals) ||
+        num_goals == 0)
+    {
+        std::printf("%-20s does not parse\n", file.name.c_str());
+        return false;
+    }
+
+    const std::span<const Cell> g(goals, num_goals);
+    bool found = false;
+    double total_us = 0.0;
+    double worst_us = 0.0;
+    for (uint32_t r = 0; r < kPlanRepeats; r++)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        found = planner.plan(truth, Cell{0, 0}, Direction::NORTH, g);
+        const double us = std::chrono::duration<double, std::micro>(
+                              std::chrono::steady_clock::now() - begin)
+                              .count();
+        total_us += us;
+        if (us > worst_us)
+            worst_us = us;
+    }
+    if (!found)
+    {
+        std::printf("%-20s %2ux%-2u unsolved\n", file.name.c_str(), W, H);
+        return false;
+    }
+
+    std::printf("%-20s %2ux%-2u %8.1f %8.1f %7zu %6zu %7.2f\n",
+                file.name.c_str(), W, H, total_us / kPlanRepeats, worst_us,
+                sizeof(planner), planner.steps().size(),
+                planner.plan_time_us() / 1e6);
+    return true;
+}
+
+/**
+ * @brief plan() on every corpus maze, sized by its text
+ * @return Number of mazes where no plan was found
+ */
+uint32_t plan_corpus()
+{
+    const std::vector<Corpus::MazeFile> files = Corpus::load();
+    if (files.empty())
+    {
+        std::printf("no mazes in %s\n", MAZE_CORPUS_DIR);
+        return 1;
+    }
+
+    std::printf("%-20s %5s %8s %8s %7s %6s %7s\n", "plan", "size",
+                "mean us", "worst us", "size B", "moves", "run s");
+    uint32_t failures = 0;
+    for (const Corpus::MazeFile& f : files)
+    {
+        uint8_t w = 0;
+        uint8_t h = 0;
+        const bool sized = MazeText::size(f.text, w, h);
+        bool ok = false;
+        if (sized && w == 16 && h == 16)
+            ok = plan<16, 16>(f);
+        else if (sized && w == 32 && h == 32)
+            ok = plan<32, 32>(f);
+        else
+            std::printf("%-20s unsupported size\n", f.name.c_str());
+        failures += ok ? 0 : 1;
+    }
+    return failures;
+}
+
+}  // namespace
+
+int main()
+{
+    std::printf("%-6s %7s %10s %10s %10s %10s\n", "maze", "size", "set M/s",
+                "query M/s", "cell M/s", "row M/s");
+    bench<16, 16>("16x16");
+    bench<32, 32>("32x32");
+
+    uint32_t mismatches = 0;
+    mismatches += verify<16, 16>("16x16", 50);
+    mismatches += verify<32, 32>("32x32", 10);
+
+    const uint32_t failures = plan_corpus();
+    return mismatches == 0 && failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file main.cc
+ * @brief Host maze simulator for the exploration and speed-run solvers
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Loads mazes in the ASCII format (see maze_text.h) and lets a
+ * simulated mouse explore each one under an exploration policy (see
+ * explorer.h). The speed run is then planned on what the mouse learned
+ * and compared with the plan on the full maze.
+ *
+ * Per maze and policy it prints cells explored, moves, wall reads, solver
+ * CPU time, the search time under a fixed search-speed model, and the
+ * final path cost against the optimum. A per-policy summary follows, and
+ * the total of search plus speed-run time is what policies are ranked on.
+ * The exit code is non-zero if any maze is not solved, if a plan runs
+ * through a misread wall, or if a path is worse than --max-ratio times the
+ * optimum. The same runs are checked on the corpus by explorer_test.
+ *
+ * @code
+ * maze_sim [--policy greedy|return|coverage|all] [--noise P] [--samples N]
+ *          [--seed N] [--max-ratio R] maze.txt...
+ * @endcode
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include "explorer.h"
+#include "maze.h"
+#include "maze_text.h"
+#include "sim_explore.h"
+
+using namespace MM;
+
+namespace
+{
+
+struct Options
+{
+    Sim::MouseConfig mouse;
+    float max_ratio = 0.0f;  ///< 0 = do not check the path cost
+    bool policies[3] = {false, false, true};
+};
+
+constexpr const char* kPolicyNames[3] = {"greedy", "return", "coverage"};
+
+// Search-run model: one cell at 500 mm/s, 90 degree turns in place
+constexpr double kSearchCellS = 0.36;
+constexpr double kSearchTurnS = 0.30;
+
+struct Summary
+{
+    uint32_t runs;
+    uint32_t solved;
+    uint32_t proven;
+    double search_s;
+    double path_s;
+    double ratio;
+};
+
+Summary summaries[3];
+
+template <uint8_t W, uint8_t H>
+bool run(const Maze<W, H>& truth, std::span<const Cell> goals,
+         const char* name, ExplorePolicy policy, const Options& options)
+{
+    const Sim::ExploreResult r =
+        Sim::explore(truth, goals, policy, options.mouse);
+    const Sim::MouseStats& s = r.mouse;
+    const double search_s = s.moves * kSearchCellS + s.turns * kSearchTurnS;
+    std::printf("%-20s %2ux%-2u %-8s %4u %5u %5u %5u %4u %3u %9.1f %8.1f "
+                "%7.1f %7.3f %7.3f %6.3f %s\n",
+                name, W, H, kPolicyNames[static_cast<int>(policy)],
+                r.explored, s.moves, s.turns, s.wall_reads, s.misreads,
+                r.recoveries, r.solver_us, r.plan_us, search_s,
+                r.cost_us / 1e6, r.optimum_us / 1e6, r.ratio(),
+                r.proven ? "yes" : "no");
+
+    const bool ok = r.ok(options.max_ratio);
+    if (!ok)
+        std::printf("%-20s FAILED\n", name);
+
+    Summary& sum = summaries[static_cast<int>(policy)];
+    sum.runs++;
+    if (ok)
+    {
+        sum.solved++;
+        sum.proven += r.proven;
+        sum.search_s += search_s;
+        sum.path_s += r.cost_us / 1e6;
+        sum.ratio += r.ratio();
+    }
+    return ok;
+}
+
+template <uint8_t W, uint8_t H>
+bool run_all(std::string_view text, const char* name, const Options& options)
+{
+    using F = FloodFill<W, H>;
+    static Maze<W, H> truth;
+
+    std::array<Cell, F::kMaxGoals> goal_cells;
+    size_t num_goals = 0;
+    if (!MazeText::parse(text, truth, std::span<Cell>(goal_cells),
+                         num_goals))
+    {
+        std::printf("%-20s bad maze text\n", name);
+        return false;
+    }
+    if (num_goals == 0)
+    {
+        goal_cells = {Cell{W / 2 - 1, H / 2 - 1}, Cell{W / 2, H / 2 - 1},
+                      Cell{W / 2 - 1, H / 2}, Cell{W / 2, H / 2}};
+        num_goals = 4;
+    }
+    const std::span<const Cell> goals(goal_cells.data(), num_goals);
+
+    bool ok = true;
+    for (int p = 0; p < 3; p++)
+    {
+        if (options.policies[p])
+            ok &= run<W, H>(truth, goals, name, static_cast<ExplorePolicy>(p),
+                            options);
+    }
+    return ok;
+}
+
+bool run_file(const char* path, const Options& options)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::printf("%s: cannot open\n", path);
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    const char* name = std::strrchr(path, '/');
+    name = name == nullptr ? path : name + 1;
+
+    uint8_t w = 0;
+    uint8_t h = 0;
+    if (!MazeText::size(text, w, h))
+    {
+        std::printf("%-20s not a maze\n", name);
+        return false;
+    }
+    if (w == 16 && h == 16)
+        return run_all<16, 16>(text, name, options);
+    if (w == 32 && h == 32)
+        return run_all<32, 32>(text, name, options);
+    std::printf("%-20s unsupported size %ux%u\n", name, w, h);
+    return false;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    int first = 1;
+    for (; first + 1 < argc && std::strncmp(argv[first], "--", 2) == 0;
+         first += 2)
+    {
+        const char* value = argv[first + 1];
+        if (std::strcmp(argv[first], "--noise") == 0)
+            options.mouse.noise = std::strtof(value, nullptr);
+        else if (std::strcmp(argv[first], "--samples") == 0)
+            options.mouse.samples =
+                static_cast<uint8_t>(std::strtoul(value, nullptr, 0));
+        else if (std::strcmp(argv[first], "--seed") == 0)
+            options.mouse.seed = std::strtoul(value, nullptr, 0);
+        else if (std::strcmp(argv[first], "--max-ratio") == 0)
+            options.max_ratio = std::strtof(value, nullptr);
+        else if (std::strcmp(argv[first], "--policy") == 0)
+        {
+            for (int p = 0; p < 3; p++)
+                options.policies[p] = std::strcmp(value, "all") == 0 ||
+                                      std::strcmp(value, kPolicyNames[p]) == 0;
+        }
+        else
+            break;
+    }
+    if (first >= argc)
+    {
+        std::printf("usage: %s [--policy greedy|return|coverage|all] "
+                    "[--noise P] [--samples N] [--seed N] [--max-ratio R] "
+                    "maze.txt...\n",
+                    argv[0]);
+        return 2;
+    }
+
+    std::printf("%-20s %5s %-8s %4s %5s %5s %5s %4s %3s %9s %8s %7s %7s "
+                "%7s %6s %s\n",
+                "maze", "size", "policy", "cell", "moves", "turns", "reads",
+                "err", "rec", "solver us", "plan us", "search", "path s",
+                "best s", "ratio", "proven");
+    uint32_t failures = 0;
+    for (int i = first; i < argc; i++)
+        failures += run_file(argv[i], options) ? 0 : 1;
+
+    // Policies are ranked on search time plus speed-run time
+    std::printf("\n%-8s %6s %6s %8s %8s %8s %8s\n", "policy", "solved",
+                "proven", "search s", "path s", "total s", "ratio");
+    for (int p = 0; p < 3; p++)
+    {
+        const Summary& sum = summaries[p];
+        if (sum.runs == 0)
+            continue;
+        const double n = sum.solved > 0 ? sum.solved : 1;
+        std::printf("%-8s %3u/%-2u %6u %8.1f %8.3f %8.1f %8.3f\n",
+                    kPolicyNames[p], sum.solved, sum.runs, sum.proven,
+                    sum.search_s / n, sum.path_s / n,
+                    (sum.search_s + sum.path_s) / n, sum.ratio / n);
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file main.cc
+ * @brief Host timing of the motion profile generator
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Runs the same sweep of straight moves as motion_profile_test,
+ * for float and Q16_16 and for both profile shapes, and prints the mean
+ * cost of update(). Moves start from rest, and a quarter of them each see
+ * a mid-move limit change, end-velocity change or early stop, so every
+ * branch of update() is in the mix. The checks themselves live in
+ * common/core/control/test/motion_profile_test.cc.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include "fixed_point.h"
+#include "motion_profile.h"
+
+using namespace MM;
+
+namespace
+{
+
+constexpr float kDt = 0.001f;
+constexpr float kVMax = 1.5f;
+constexpr float kAMax = 6.0f;
+constexpr float kJMax = 150.0f;
+constexpr uint32_t kMaxTicks = 20000;
+
+enum class Event : uint8_t
+{
+    NONE = 0,
+    SLOW_DOWN,  ///< Halve v_max at 30 % of the move
+    END_SPEED,  ///< Raise v_end at 30 % of the move
+    STOP        ///< stop() at 30 % of the move
+};
+
+// Result sink so the optimiser cannot drop the moves
+volatile float sink;
+
+/**
+ * @return Ticks the move took
+ */
+template <typename T>
+uint32_t run(ProfileShape shape, float distance, float v_end, Event event)
+{
+    MotionProfile<T> profile(from_float<T>(kDt), shape);
+    ProfileLimits<T> limits{from_float<T>(kVMax), from_float<T>(kAMax),
+                            from_float<T>(kJMax)};
+    profile.reset();
+    profile.start(from_float<T>(distance), limits, from_float<T>(v_end));
+
+    const T trigger = from_float<T>(0.3f * distance);
+    const bool forward = distance >= 0.0f;
+    bool changed = false;
+    T acc{};
+    uint32_t ticks = 0;
+    for (; ticks < kMaxTicks && !profile.done(); ticks++)
+    {
+        const bool past = forward ? trigger < profile.position()
+                                  : profile.position() < trigger;
+        if (!changed && past)
+        {
+            changed = true;
+            if (event == Event::SLOW_DOWN)
+            {
+                limits.v_max = from_float<T>(kVMax / 2);
+                profile.set_limits(limits);
+            }
+            else if (event == Event::END_SPEED)
+            {
+                profile.set_end_velocity(from_float<T>(v_end + 0.4f));
+            }
+            else if (event == Event::STOP)
+            {
+                profile.stop();
+            }
+        }
+        profile.update();
+        acc = acc + profile.velocity();
+    }
+    sink = to_float(acc);
+    return ticks;
+}
+
+template <typename T>
+void sweep(const char* type, ProfileShape shape)
+{
+    uint32_t runs = 0;
+    uint64_t ticks = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (int e = 0; e < 4; e++)
+    {
+        for (float d = 0.01f; d < 2.5f; d += 0.037f)
+        {
+            for (float v_end : {0.0f, 0.3f})
+            {
+                ticks += run<T>(shape, d, v_end, static_cast<Event>(e));
+                ticks += run<T>(shape, -d, v_end, static_cast<Event>(e));
+                runs += 2;
+            }
+        }
+    }
+    const double ns = std::chrono::duration<double, std::nano>(
+                          std::chrono::steady_clock::now() - begin)
+                          .count();
+
+    std::printf("%-7s %-9s %5u %9llu %8.1f\n", type,
+                shape == ProfileShape::TRAPEZOID ? "trapezoid" : "s-curve",
+                runs, static_cast<unsigned long long>(ticks), ns / ticks);
+}
+
+}  // namespace
+
+int main()
+{
+    std::printf("%-7s %-9s %5s %9s %8s\n", "type", "shape", "runs", "ticks",
+                "ns/tick");
+    sweep<float>("float", ProfileShape::TRAPEZOID);
+    sweep<float>("float", ProfileShape::S_CURVE);
+    sweep<Q16_16>("Q16_16", ProfileShape::TRAPEZOID);
+    sweep<Q16_16>("Q16_16", ProfileShape::S_CURVE);
+    return 0;
+}
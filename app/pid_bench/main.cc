@@ -0,0 +1,114 @@
+/**
+ * @file main.cc
+ * @brief Host timing of the PID and drive loops
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Times Pid::update() for each anti-windup mode and a full
+ * DriveController tick, for float and Q16_16. On x86-64 the cost is also
+ * given in TSC cycles. The closed-loop windup and cascade checks live in
+ * common/core/control/test/pid_test.cc and drive_controller_test.cc.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include "drive_controller.h"
+#include "fixed_point.h"
+#include "pid.h"
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+using namespace MM;
+
+namespace
+{
+
+constexpr float kDt = 0.001f;
+
+constexpr float kMotorGain = 2.0f;  // m/s at full duty
+
+constexpr PidConfig kWheelPid{.kp = 1.5f,
+                              .ki = 20.0f,
+                              .kf = 1.0f / kMotorGain,
+                              .anti_windup = AntiWindup::BACK_CALCULATION};
+
+constexpr PidConfig kHeadingPid{.kp = 20.0f,
+                                .ki = 40.0f,
+                                .kd = 0.5f,
+                                .out_min = -20.0f,
+                                .out_max = 20.0f,
+                                .d_cutoff_hz = 100.0f};
+
+constexpr const char* kModeNames[] = {"none", "clamp", "back-calc"};
+
+struct Cost
+{
+    double ns;
+    double cycles;  ///< 0 where there is no TSC
+};
+
+template <typename Fn>
+Cost measure(Fn&& fn)
+{
+    constexpr int kCalls = 1000000;
+#if defined(__x86_64__)
+    const uint64_t tsc = __rdtsc();
+#endif
+    const auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < kCalls; i++)
+        fn(i);
+    const double ns = std::chrono::duration<double, std::nano>(
+                          std::chrono::steady_clock::now() - begin)
+                          .count();
+    double cycles = 0.0;
+#if defined(__x86_64__)
+    cycles = static_cast<double>(__rdtsc() - tsc) / kCalls;
+#endif
+    return Cost{ns / kCalls, cycles};
+}
+
+template <typename T>
+void time_type(const char* type)
+{
+    volatile float sink = 0.0f;
+    for (int mode = 0; mode < 3; mode++)
+    {
+        PidConfig config = kWheelPid;
+        config.anti_windup = static_cast<AntiWindup>(mode);
+        config.d_cutoff_hz = 200.0f;
+        config.kd = 0.01f;
+        Pid<T> pid(kDt, config);
+        const T setpoint = from_float<T>(0.8f);
+        const Cost c = measure([&](int i) {
+            const T y = from_float<T>(0.5f + 0.001f * (i & 255));
+            sink = sink + to_float(pid.update(setpoint, y));
+        });
+        std::printf("%-7s pid %-14s %7.1f %9.1f\n", type, kModeNames[mode],
+                    c.ns, c.cycles);
+    }
+
+    DriveConfig config{.heading = kHeadingPid, .wheel = kWheelPid};
+    DriveController<T> drive(config);
+    const T v = from_float<T>(1.0f);
+    const T w = from_float<T>(2.0f);
+    const Cost c = measure([&](int i) {
+        const DriveFeedback<T> fb{from_float<T>(0.93f + 0.0001f * (i & 255)),
+                                  from_float<T>(1.07f),
+                                  from_float<T>(1.98f)};
+        const MotorCommand<T> duty = drive.update(v, w, fb);
+        sink = sink + to_float(duty.left);
+    });
+    std::printf("%-7s drive tick          %7.1f %9.1f\n", type, c.ns,
+                c.cycles);
+}
+
+}  // namespace
+
+int main()
+{
+    std::printf("%-7s %-18s %7s %9s\n", "type", "update", "ns", "cycles");
+    time_type<float>("float");
+    time_type<Q16_16>("Q16_16");
+    return 0;
+}
@@ -15,7 +15,8 @@ const Stmf4::StGpioParams pwm_output_params{4, GPIOB, pwm_output_settings};
 // PWM Config (TIM3 CH1)
 Stmf4::StPwmSettings pwm_settings{Stmf4::PwmMode::EDGE_ALIGNED,
                                   Stmf4::PwmOutputMode::PWM_MODE_1,
-                                  Stmf4::PwmDir::UPCOUNTING};
+                                  Stmf4::PwmDir::UPCOUNTING,
+                                  Stmf4::PwmResolution::PERCENT};
 
 const Stmf4::StPwmParams pwm_params{TIM3, Stmf4::PwmChannel::CH1, pwm_settings};
 
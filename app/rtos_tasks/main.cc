@@ -0,0 +1,105 @@
+/**
+ * @file main.cc
+ * @brief FreeRTOS task graph on the POSIX port
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Sensor, control and logging tasks at separate priorities,
+ * mirroring the firmware layout: the sensor task publishes a sample and
+ * notifies control; control runs on each notification; logging runs at
+ * the lowest priority and ends the scheduler after a fixed number of
+ * reports so the binary terminates. The exit code reports whether every
+ * sample reached control, so CTest can run it.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include "FreeRTOS.h"
+#include "task.h"
+
+namespace
+{
+
+constexpr UBaseType_t kControlPriority = 4;
+constexpr UBaseType_t kSensorPriority = 3;
+constexpr UBaseType_t kLoggingPriority = 1;
+
+constexpr TickType_t kSensorPeriod = pdMS_TO_TICKS(2);
+constexpr TickType_t kLoggingPeriod = pdMS_TO_TICKS(100);
+constexpr uint32_t kLogReports = 10;
+
+constexpr uint32_t kStackDepth = configMINIMAL_STACK_SIZE * 4;
+
+StaticTask_t sensor_tcb, control_tcb, logging_tcb;
+StackType_t sensor_stack[kStackDepth];
+StackType_t control_stack[kStackDepth];
+StackType_t logging_stack[kStackDepth];
+
+TaskHandle_t control_handle = nullptr;
+
+volatile uint32_t samples = 0;
+volatile uint32_t control_steps = 0;
+
+void sensor_task(void*)
+{
+    TickType_t wake = xTaskGetTickCount();
+    while (true)
+    {
+        vTaskDelayUntil(&wake, kSensorPeriod);
+        samples = samples + 1;
+        xTaskNotifyGive(control_handle);
+    }
+}
+
+void control_task(void*)
+{
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        control_steps = control_steps + 1;
+    }
+}
+
+void logging_task(void*)
+{
+    TickType_t wake = xTaskGetTickCount();
+    for (uint32_t i = 0; i < kLogReports; i++)
+    {
+        vTaskDelayUntil(&wake, kLoggingPeriod);
+        std::printf("t=%4lu ms samples=%5lu control=%5lu\n",
+                    static_cast<unsigned long>(xTaskGetTickCount()),
+                    static_cast<unsigned long>(samples),
+                    static_cast<unsigned long>(control_steps));
+    }
+    vTaskEndScheduler();
+    while (true)
+    {
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    control_handle =
+        xTaskCreateStatic(control_task, "control", kStackDepth, nullptr,
+                          kControlPriority, control_stack, &control_tcb);
+    xTaskCreateStatic(sensor_task, "sensor", kStackDepth, nullptr,
+                      kSensorPriority, sensor_stack, &sensor_tcb);
+    xTaskCreateStatic(logging_task, "logging", kStackDepth, nullptr,
+                      kLoggingPriority, logging_stack, &logging_tcb);
+
+    vTaskStartScheduler();
+
+    // Reached once the logging task ends the scheduler. Both periods are
+    // in ticks, so the sensor count is exact up to which of the two tasks
+    // released first on the last tick.
+    const uint32_t expected = kLogReports * kLoggingPeriod / kSensorPeriod;
+    const bool sampled = samples + 1 >= expected && samples <= expected;
+    const bool controlled = control_steps + 1 >= samples;
+    std::printf("samples %lu/%lu, control %lu: %s\n",
+                static_cast<unsigned long>(samples),
+                static_cast<unsigned long>(expected),
+                static_cast<unsigned long>(control_steps),
+                sampled && controlled ? "ok" : "FAILED");
+    return sampled && controlled ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file main.cc
+ * @brief Native run of the cooperative scheduler on the simulated clock
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Each task burns a fixed amount of simulated time with DelayUs(),
+ * so the printed counts, overruns and load are fully deterministic and can
+ * be diffed between builds. SchedulerTest.MixedLoad asserts the same table.
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include "delay.h"
+#include "scheduler.h"
+#include "timebase.h"
+
+using namespace MM;
+
+namespace
+{
+
+struct Load
+{
+    uint32_t cost_us;
+};
+
+Load control_load{200};
+Load imu_load{1500};
+Load telemetry_load{4000};
+
+void burn(void* ctx)
+{
+    Utils::DelayUs(static_cast<Load*>(ctx)->cost_us);
+}
+
+constexpr auto kTasks = make_task_table({
+    Task{"control", burn, &control_load, 1000, 3},
+    Task{"imu", burn, &imu_load, 10000, 2},
+    Task{"telemetry", burn, &telemetry_load, 100000, 1},
+});
+
+Scheduler scheduler(kTasks);
+
+constexpr uint32_t kRunTimeUs = 1000000;
+
+}  // namespace
+
+int main()
+{
+    Utils::timebase_init({.core_clock_hz = 100'000'000});
+    scheduler.start();
+
+    const uint32_t begin = Utils::now_us();
+    while (Utils::elapsed(begin, Utils::now_us()) < kRunTimeUs)
+    {
+        if (!scheduler.run_once())
+        {
+            const uint32_t next = scheduler.next_release();
+            Utils::timebase_advance_us(next - Utils::now_us());
+        }
+    }
+
+    const uint32_t cpu_mhz = Utils::cycles_per_us();
+    std::printf("%-10s %6s %8s %10s %10s\n", "task", "runs", "overrun",
+                "max_us", "total_us");
+    for (size_t i = 0; i < scheduler.size(); i++)
+    {
+        const TaskStats& s = scheduler.stats(i);
+        std::printf("%-10s %6" PRIu32 " %8" PRIu32 " %10" PRIu32
+                    " %10" PRIu64 "\n",
+                    scheduler.task(i).name, s.runs, s.overruns,
+                    s.max_cycles / cpu_mhz, s.total_cycles / cpu_mhz);
+    }
+    std::printf("load: %" PRIu32 " permille\n",
+                scheduler.cpu_load_permille());
+    return 0;
+}
@@ -18,6 +18,10 @@ MM::Stmf4::StSpiSettings spi_settings{
     MM::Stmf4::SpiBitOrder::MSB, MM::Stmf4::SpiRxThreshold::FIFO_8bit};
 MM::Stmf4::HwSpi spi1{SPI1, spi_settings};
 
+// SPI1_RX on DMA2 stream 0 and SPI1_TX on DMA2 stream 3, both channel 3
+MM::Stmf4::StSpiDmaParams spi_dma{DMA2_Stream0, DMA2_Stream3, 3,
+                                  DMA2_Stream0_IRQn};
+
 // Make GPIO Register Config Settings
 MM::Stmf4::StGpioSettings gpio_settings{
     MM::Stmf4::GpioMode::AF, MM::Stmf4::GpioOtype::PUSH_PULL,
@@ -44,12 +48,16 @@ bool BSP_Init()
     // Enable GPIOA clock (STM32F4 uses AHB1ENR)
     RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;
 
-    // Enable SPI clock
+    // Enable SPI and DMA clocks
     RCC->APB2ENR |= RCC_APB2ENR_SPI1EN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
 
     // Init SPI periph and check if it was successful
     result = result && spi1.init();
 
+    // Move long transfers onto DMA instead of polling
+    result = result && spi1.enable_dma(spi_dma);
+
     // Init Spi pins
     result = result && sck.init();
     result = result && miso.init();
@@ -67,3 +75,8 @@ Board& Get_Board()
     return board;
 }
 }  // namespace MM
+
+extern "C" void DMA2_Stream0_IRQHandler()
+{
+    MM::spi1.irq_handler();
+}
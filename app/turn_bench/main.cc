@@ -0,0 +1,83 @@
+/**
+ * @file main.cc
+ * @brief Host sizing and timing of the compile-time turn tables
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Builds search, fast and half-size table sets at compile time
+ * and prints the speed, peak yaw rate, duration, path length and exit
+ * point of every turn. It also prints the flash size of each table set
+ * and times at(). The checks against the analytic model live in
+ * common/core/control/test/turn_table_test.cc.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include "turn_table.h"
+
+using namespace MM;
+
+namespace
+{
+
+constexpr size_t kSamples = 64;
+
+constexpr TurnParams kSearchParams{.cell = 0.18f, .lateral_accel = 4.0f};
+constexpr TurnParams kFastParams{.cell = 0.18f, .lateral_accel = 9.0f};
+constexpr TurnParams kHalfParams{.cell = 0.09f, .lateral_accel = 9.0f};
+
+// Generated by the compiler; constexpr data goes to .rodata (flash)
+constexpr auto kSearchTurns = make_turn_tables<kSamples>(kSearchParams);
+constexpr auto kFastTurns = make_turn_tables<kSamples>(kFastParams);
+constexpr auto kHalfTurns = make_turn_tables<kSamples>(kHalfParams);
+
+constexpr const char* kTurnNames[kNumTurnTypes] = {
+    "search90", "fast90", "fast180", "diag45", "diag135", "diag90"};
+
+void print_set(const char* name, const TurnTableSet<kSamples>& set)
+{
+    for (size_t type = 0; type < kNumTurnTypes; type++)
+    {
+        const TurnProfile<kSamples>& turn = set.turns[type];
+        std::printf("%-7s %-8s %6.3f %6.2f %7.1f %7.1f %7.1f %7.1f\n", name,
+                    kTurnNames[type], turn.speed, turn.peak_w,
+                    turn.duration * 1e3, turn.length * 1e3, turn.dx * 1e3,
+                    turn.dy * 1e3);
+    }
+}
+
+double time_at(const TurnTableSet<kSamples>& set)
+{
+    constexpr int kCalls = 1000000;
+    const TurnProfile<kSamples>& turn = set[TurnType::FAST_90];
+    const float step = turn.duration / kCalls;
+    volatile float sink = 0.0f;
+    const auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < kCalls; i++)
+    {
+        const TurnSetpoint s = turn.at(static_cast<float>(i) * step);
+        sink = sink + s.w;
+    }
+    const double ns = std::chrono::duration<double, std::nano>(
+                          std::chrono::steady_clock::now() - begin)
+                          .count();
+    return ns / kCalls;
+}
+
+}  // namespace
+
+int main()
+{
+    std::printf("%-7s %-8s %6s %6s %7s %7s %7s %7s\n", "set", "turn",
+                "v m/s", "w peak", "ms", "len mm", "dx mm", "dy mm");
+    print_set("search", kSearchTurns);
+    print_set("fast", kFastTurns);
+    print_set("half", kHalfTurns);
+
+    std::printf("\nflash per table set: %zu bytes (%zu samples x %zu turns, "
+                "%zu bytes per turn)\n",
+                sizeof(kSearchTurns), kSamples, kNumTurnTypes,
+                sizeof(TurnProfile<kSamples>));
+    std::printf("at(): %.1f ns per call\n", time_at(kFastTurns));
+    return 0;
+}
@@ -0,0 +1,240 @@
+/**
+ * @file drive_controller.h
+ * @brief Cascaded heading and wheel-speed control for a differential drive
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Two loops per control tick:
+ * - The outer heading loop compares the commanded heading with the
+ *   measured one and adds a yaw-rate correction to the commanded yaw
+ *   rate. Its measured yaw rate blends the BNO055 gyro with the encoder
+ *   difference (v_r - v_l) / tread. The gyro does not see wheel slip, and
+ *   the encoders do not drift. The loop's D term uses that rate directly
+ *   instead of differencing the integrated heading.
+ * - Two inner loops drive each wheel to v -/+ w * tread / 2. A kf
+ *   feedforward (duty per m/s) gives most of the output, so the PI terms
+ *   only trim.
+ *
+ * Outputs are signed duties in [-1, 1]; MotorPwm maps them onto the two
+ * inputs of an H-bridge. Units are SI: m/s, rad, rad/s. Configure the
+ * VelocityEstimator with units_per_count in metres.
+ *
+ * @code
+ * MM::DriveController<float> drive(config);
+ * // Every 1 ms, after updating both estimators and reading the gyro (dps)
+ * const auto fb = MM::drive_feedback<float>(left_enc, right_enc, imu.gyro);
+ * const auto duty = drive.update(setpoint.v, setpoint.w, fb);
+ * left_motor.set(duty.left);
+ * right_motor.set(duty.right);
+ * @endcode
+ */
+
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include "fixed_point.h"
+#include "imu_math.h"
+#include "pid.h"
+#include "velocity_estimator.h"
+
+namespace MM
+{
+
+struct DriveConfig
+{
+    float dt = 0.001f;          ///< Control tick, s
+    float tread = 0.07f;        ///< Distance between the wheels, m
+    float gyro_weight = 0.98f;  ///< Gyro share of the yaw-rate estimate
+    PidConfig heading;          ///< rad -> rad/s; limits bound the yaw rate
+    PidConfig wheel;            ///< m/s -> duty; kf is duty per m/s
+};
+
+/**
+ * @struct DriveFeedback
+ * @brief Sensor readings for one tick
+ */
+template <typename T>
+struct DriveFeedback
+{
+    T left_v;   ///< m/s
+    T right_v;  ///< m/s
+    T gyro_z;   ///< rad/s, counter-clockwise positive
+};
+
+template <typename T>
+struct MotorCommand
+{
+    T left;   ///< Duty, -1 .. 1
+    T right;
+};
+
+/**
+ * @brief Collect encoder and gyro readings into a DriveFeedback
+ * @param gyro Bno055Data::gyro or read_accel_gyro() output, deg/s as the
+ * BNO055 reports it; converted to rad/s here
+ */
+template <typename T>
+DriveFeedback<T> drive_feedback(const VelocityEstimator& left,
+                                const VelocityEstimator& right,
+                                const Vec3& gyro)
+{
+    return DriveFeedback<T>{from_float<T>(left.velocity()),
+                            from_float<T>(right.velocity()),
+                            from_float<T>(gyro.z * Math::kDegToRad)};
+}
+
+template <typename T>
+class DriveController
+{
+public:
+    explicit DriveController(const DriveConfig& config_)
+        : heading_pid(config_.dt, config_.heading),
+          left_pid(config_.dt, config_.wheel),
+          right_pid(config_.dt, config_.wheel)
+    {
+        configure(config_);
+    }
+
+    /**
+     * @brief Change geometry and gains; loop state is kept
+     */
+    void configure(const DriveConfig& config_)
+    {
+        config = config_;
+        dt = from_float<T>(config_.dt);
+        half_tread = from_float<T>(0.5f * config_.tread);
+        inv_tread = from_float<T>(1.0f / config_.tread);
+        gyro_weight = from_float<T>(config_.gyro_weight);
+        encoder_weight = from_float<T>(1.0f - config_.gyro_weight);
+        heading_pid.configure(config_.heading);
+        left_pid.configure(config_.wheel);
+        right_pid.configure(config_.wheel);
+    }
+
+    /**
+     * @brief One tick; the heading setpoint follows the integral of @p w
+     * @param v Forward speed setpoint, m/s
+     * @param w Yaw-rate setpoint, rad/s
+     */
+    MotorCommand<T> update(T v, T w, const DriveFeedback<T>& feedback)
+    {
+        return update(v, w, target_heading + w * dt, feedback);
+    }
+
+    /**
+     * @brief One tick with an explicit heading setpoint
+     * @details For profiles that carry their own heading, such as the
+     * turn tables in turn_table.h.
+     */
+    MotorCommand<T> update(T v, T w, T heading_setpoint,
+                           const DriveFeedback<T>& feedback)
+    {
+        target_heading = heading_setpoint;
+        rate = gyro_weight * feedback.gyro_z +
+               encoder_weight * (feedback.right_v - feedback.left_v) *
+                   inv_tread;
+        measured_heading += rate * dt;
+
+        // D acts on the error's rate, w - rate, so it does not fight turns
+        const T w_command = heading_pid.update_with_rate(
+            target_heading, measured_heading, rate - w, w);
+
+        const T spread = w_command * half_tread;
+        return MotorCommand<T>{left_pid.update(v - spread, feedback.left_v),
+                               right_pid.update(v + spread,
+                                                feedback.right_v)};
+    }
+
+    /**
+     * @brief Zero both headings and clear all three loops
+     */
+    void reset()
+    {
+        target_heading = T{};
+        measured_heading = T{};
+        rate = T{};
+        heading_pid.reset();
+        left_pid.reset();
+        right_pid.reset();
+    }
+
+    /**
+     * @brief Measured heading since reset(), rad
+     */
+    T heading() const
+    {
+        return measured_heading;
+    }
+
+    T heading_error() const
+    {
+        return target_heading - measured_heading;
+    }
+
+    /**
+     * @brief Blended gyro and encoder yaw rate, rad/s
+     */
+    T yaw_rate() const
+    {
+        return rate;
+    }
+
+    Pid<T> heading_pid;
+    Pid<T> left_pid;
+    Pid<T> right_pid;
+
+private:
+    DriveConfig config;
+    T dt{};
+    T half_tread{};
+    T inv_tread{};
+    T gyro_weight{};
+    T encoder_weight{};
+
+    T target_heading{};
+    T measured_heading{};
+    T rate{};
+};
+
+/**
+ * @class MotorPwm
+ * @brief Signed duty onto the two inputs of an H-bridge channel
+ * @details Forward duty goes to @c forward with @c reverse held low, and
+ * the other way round. PwmT needs set_duty(Q16_16 duty) for duty in
+ * [0, 1], as HwPwm provides.
+ */
+template <typename PwmT>
+class MotorPwm
+{
+public:
+    MotorPwm(PwmT& forward_, PwmT& reverse_)
+        : forward(forward_), reverse(reverse_)
+    {
+    }
+
+    template <typename T>
+    void set(T duty)
+    {
+        Q16_16 d;
+        if constexpr (std::is_same_v<T, Q16_16>)
+            d = duty;
+        else
+            d = Q16_16::from_float(to_float(duty));
+
+        if (d < Q16_16{})
+        {
+            forward.set_duty(Q16_16{});
+            reverse.set_duty(-d);
+        }
+        else
+        {
+            reverse.set_duty(Q16_16{});
+            forward.set_duty(d);
+        }
+    }
+
+private:
+    PwmT& forward;
+    PwmT& reverse;
+};
+
+}  // namespace MM
@@ -0,0 +1,148 @@
+/**
+ * @file duty_ramp.h
+ * @brief Precomputed duty tables for DMA-streamed PWM
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Tables hold raw CCR values, one frame per PWM update event and
+ * one lane per channel, interleaved the way a TIM DMA burst writes them:
+ * [ch_a0, ch_b0, ch_a1, ch_b1, ...]. Everything is constexpr, so fixed
+ * patterns can be built at compile time into flash.
+ *
+ * @code
+ * // 2 motors, 0 -> 80 % of ARR = 4999 over 500 frames (25 ms at 20 kHz)
+ * MM::DutyTable<500, 2> accel;
+ * MM::fill_ramp(accel.lane(0), 0, 4000, MM::RampShape::SMOOTHSTEP);
+ * MM::fill_ramp(accel.lane(1), 0, 4000, MM::RampShape::SMOOTHSTEP);
+ * @endcode
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace MM
+{
+
+enum class RampShape : uint8_t
+{
+    LINEAR = 0,
+    SMOOTHSTEP  ///< 3t^2 - 2t^3: zero slope at both ends, no jerk spike
+};
+
+/**
+ * @class DutyLane
+ * @brief Strided view of one channel's column in an interleaved table
+ */
+class DutyLane
+{
+public:
+    constexpr DutyLane(uint32_t* base_, size_t frames_, size_t stride_)
+        : base(base_), frames(frames_), stride(stride_)
+    {
+    }
+
+    constexpr uint32_t& operator[](size_t frame) const
+    {
+        return base[frame * stride];
+    }
+
+    constexpr size_t size() const
+    {
+        return frames;
+    }
+
+    /**
+     * @brief Sub-range of frames [first, first + count)
+     */
+    constexpr DutyLane sub(size_t first, size_t count) const
+    {
+        return DutyLane(base + first * stride, count, stride);
+    }
+
+private:
+    uint32_t* base;
+    size_t frames;
+    size_t stride;
+};
+
+/**
+ * @class DutyTable
+ * @brief Interleaved CCR table for @p Channels channels
+ */
+template <size_t Frames, size_t Channels>
+struct DutyTable
+{
+    static_assert(Frames > 0 && Channels > 0 && Channels <= 4);
+
+    static constexpr size_t kFrames = Frames;
+    static constexpr size_t kChannels = Channels;
+
+    constexpr DutyLane lane(size_t channel)
+    {
+        return DutyLane(data.data() + channel, Frames, Channels);
+    }
+
+    constexpr uint32_t at(size_t frame, size_t channel) const
+    {
+        return data[frame * Channels + channel];
+    }
+
+    alignas(4) std::array<uint32_t, Frames * Channels> data{};
+};
+
+/**
+ * @brief Shape value at frame @p i of @p n, as a Q16 fraction 0..65536
+ */
+constexpr uint32_t ramp_fraction_q16(size_t i, size_t n, RampShape shape)
+{
+    if (n <= 1)
+        return 0x10000u;
+    const uint64_t t = (static_cast<uint64_t>(i) << 16) / (n - 1);
+    if (shape == RampShape::LINEAR)
+        return static_cast<uint32_t>(t);
+    // 3t^2 - 2t^3 in Q16: t^2 (Q32) * (3 - 2t) (Q16) -> Q48
+    const uint64_t t2 = t * t;
+    const uint64_t k = 3u * 0x10000u - 2u * t;
+    return static_cast<uint32_t>((t2 * k + (1ull << 31)) >> 32);
+}
+
+/**
+ * @brief Fill a lane with a ramp from @p from to @p to (CCR counts)
+ * @details The first frame is exactly @p from and the last exactly @p to.
+ */
+constexpr void fill_ramp(DutyLane lane, uint32_t from, uint32_t to,
+                         RampShape shape = RampShape::LINEAR)
+{
+    const size_t n = lane.size();
+    const int64_t span = static_cast<int64_t>(to) - from;
+    const int64_t half = span < 0 ? -0x8000 : 0x8000;  // Round to nearest
+    for (size_t i = 0; i < n; i++)
+    {
+        const int64_t step =
+            (span * ramp_fraction_q16(i, n, shape) + half) / 0x10000;
+        lane[i] = static_cast<uint32_t>(static_cast<int64_t>(from) + step);
+    }
+}
+
+/**
+ * @brief Fill a lane with a constant CCR value
+ */
+constexpr void fill_hold(DutyLane lane, uint32_t value)
+{
+    for (size_t i = 0; i < lane.size(); i++)
+        lane[i] = value;
+}
+
+/**
+ * @brief Time one pass of a table takes at @p pwm_hz update events
+ * @param repetition Update events per frame (TIM1 RCR + 1, else 1)
+ */
+constexpr uint32_t table_duration_us(size_t frames, uint32_t pwm_hz,
+                                     uint32_t repetition = 1)
+{
+    return static_cast<uint32_t>(static_cast<uint64_t>(frames) * repetition *
+                                 1'000'000u / pwm_hz);
+}
+
+}  // namespace MM
@@ -0,0 +1,451 @@
+/**
+ * @file motion_profile.h
+ * @brief Incremental trapezoidal and S-curve motion profile generator
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details MotionProfile<T> produces one setpoint per control tick for a
+ * one-axis move. Each update() is O(1) and uses only add, subtract,
+ * multiply and compare. Nothing is planned ahead; every tick decides
+ * whether to accelerate, cruise or brake from the remaining distance. A
+ * new end velocity, a lower or higher speed limit, or an early stop
+ * therefore takes effect on the next tick, without a discontinuity.
+ *
+ * - TRAPEZOID changes velocity by at most a_max * dt per tick.
+ * - S_CURVE changes acceleration by at most j_max * dt per tick. It brakes
+ *   on a conservative jerk-limited stopping distance.
+ *
+ * Moves end exactly on the target position. When braking would otherwise
+ * stall short of it, the profile creeps at max(v_end, a_max * dt), and
+ * snaps to the target in the tick that reaches it. A move too short to
+ * reach v_end ends at the speed it got to.
+ *
+ * T is float or a Fixed type. Use SI units (m, m/s, rad, rad/s) so
+ * Q16_16 keeps about 15 um of resolution and v^2 stays well in range.
+ * Q16_16 moves are limited to about 16 m at a 1 ms tick. Divisions only
+ * happen when limits are set, on the float side.
+ *
+ * @code
+ * MM::MotionProfile<float> profile(0.001f, MM::ProfileShape::S_CURVE);
+ * profile.start(0.18f, {.v_max = 1.0f, .a_max = 5.0f, .j_max = 100.0f});
+ * while (!profile.done())
+ * {
+ *     profile.update();  // Every 1 ms
+ *     set_wheel_speed(profile.velocity());
+ * }
+ * @endcode
+ */
+
+#pragma once
+#include <cstdint>
+#include "fixed_point.h"
+
+namespace MM
+{
+
+enum class ProfileShape : uint8_t
+{
+    TRAPEZOID = 0,
+    S_CURVE  ///< Jerk-limited
+};
+
+template <typename T>
+struct ProfileLimits
+{
+    T v_max;
+    T a_max;
+    T j_max;  ///< Unused by TRAPEZOID
+};
+
+template <typename T>
+class MotionProfile
+{
+public:
+    /**
+     * @param dt_ Control tick in seconds
+     */
+    explicit MotionProfile(T dt_, ProfileShape shape_ = ProfileShape::TRAPEZOID)
+        : dt(dt_), half_dt(dt_ * from_float<T>(0.5f)), shape(shape_)
+    {
+        inv_dt = from_float<T>(1.0f / to_float(dt_));
+    }
+
+    /**
+     * @brief Begin a move of @p distance from the current position
+     * @details Starts from the current velocity and acceleration, so moves
+     * can be chained. Starting against the current direction of travel is
+     * not supported.
+     * @param v_end_ Speed to pass the target at (0 to stop there)
+     */
+    void start(T distance, const ProfileLimits<T>& limits_, T v_end_ = T{})
+    {
+        const bool reverse = distance < T{};
+        origin = pos;
+        sign = reverse ? -1 : 1;
+        target = reverse ? -distance : distance;
+        travelled = T{};
+        swept = T{};
+        speed = reverse ? -vel : vel;
+        accel = reverse ? -acc : acc;
+        set_limits(limits_);
+        v_end = v_end_;
+        stopping = false;
+        braking = false;
+        finished = false;
+        if (target == T{})
+            finish(speed);
+    }
+
+    /**
+     * @brief Change the limits mid-move; a lower v_max brakes down to it
+     */
+    void set_limits(const ProfileLimits<T>& limits_)
+    {
+        limits = limits_;
+        braking = false;
+        const float a = to_float(limits_.a_max);
+        const float j = to_float(limits_.j_max);
+        a_dt = limits_.a_max * dt;
+        j_dt = limits_.j_max * dt;
+        inv_2a = from_float<T>(0.5f / a);
+        inv_j = from_float<T>(j > 0.0f ? 1.0f / j : 0.0f);
+        inv_2j = from_float<T>(j > 0.0f ? 0.5f / j : 0.0f);
+    }
+
+    /**
+     * @brief Change the speed the target is passed at
+     */
+    void set_end_velocity(T v_end_)
+    {
+        v_end = v_end_;
+        braking = false;
+    }
+
+    /**
+     * @brief Brake to a standstill as fast as the limits allow
+     * @details The move then ends wherever the mouse stops.
+     */
+    void stop()
+    {
+        if (finished)
+            return;
+        stopping = true;
+        v_end = T{};
+    }
+
+    /**
+     * @brief Advance one control tick
+     */
+    void update()
+    {
+        if (finished)
+            return;
+
+        const T zero{};
+        const T v0 = speed;
+        const T a0 = accel;
+        const T remaining = target - travelled;
+        // Braking never speeds the profile up to the creep speed
+        const T floor = min(v0, stopping ? zero : max(v_end, a_dt));
+
+        // Brake now if even holding the current speed for this tick would
+        // be too late. Otherwise speed up only if braking could still start
+        // in time after one more accelerating tick. Once braking has
+        // started, the profile only brakes or holds, so it follows the
+        // braking curve without flipping between accelerating and braking.
+        const T a_ahead =
+            shape == ProfileShape::TRAPEZOID ? limits.a_max
+                                             : min(a0 + j_dt, limits.a_max);
+        const T v_ahead = shape == ProfileShape::TRAPEZOID
+                              ? v0 + a_dt
+                              : v0 + (a0 + a_ahead) * half_dt;
+        const bool brake =
+            stopping || must_brake(remaining - v0 * dt, v0, max(a0, zero));
+        braking = braking || brake;
+        const bool hold =
+            !brake &&
+            (braking || must_brake(remaining - (v0 + v_ahead) * half_dt,
+                                   v_ahead, a_ahead));
+
+        if (shape == ProfileShape::TRAPEZOID)
+        {
+            if (brake)
+                speed = max(v0 - a_dt, floor);
+            else if (v0 > limits.v_max)
+                speed = max(v0 - a_dt, limits.v_max);
+            else if (hold)
+                speed = v0;
+            else
+                speed = min(v0 + a_dt, limits.v_max);
+            accel = (speed - v0) * inv_dt;
+        }
+        else
+        {
+            // Push the acceleration towards the limit only if, after this
+            // tick, the jerk limit could still ramp it back to zero before
+            // the speed passes the level it is heading for
+            T a_target = zero;
+            if (brake || v0 > limits.v_max)
+            {
+                const T level = brake ? floor : limits.v_max;
+                const T a1 = max(a0 - j_dt, -limits.a_max);
+                const T v1 = v0 + (a0 + a1) * half_dt;
+                if (v1 - level > a1 * a1 * inv_2j)
+                    a_target = -limits.a_max;
+            }
+            else if (!hold)
+            {
+                const T a1 = min(a0 + j_dt, limits.a_max);
+                const T v1 = v0 + (a0 + a1) * half_dt;
+                if (limits.v_max - v1 > a1 * a1 * inv_2j)
+                    a_target = limits.a_max;
+            }
+
+            accel = a_target > a0 ? min(a0 + j_dt, a_target)
+                                  : max(a0 - j_dt, a_target);
+            speed = v0 + (a0 + accel) * half_dt;
+            // Rounding can still dip below the floor; hold it there while
+            // the acceleration finishes its ramp
+            if (accel < zero && speed < floor)
+            {
+                speed = floor;
+                accel = min(a0 + j_dt, zero);
+            }
+        }
+
+        // Summing speeds is exact in fixed point, so the only rounding is
+        // the one product; adding up products would drift, and slow speeds
+        // would round to no travel at all
+        swept += v0 + speed;
+        travelled = swept * half_dt;
+        // The S-curve only approaches zero speed, so it settles once a
+        // single tick of jerk would stop it
+        if (stopping && speed <= j_dt * dt)
+        {
+            target = travelled;
+            finish(v0);
+            return;
+        }
+        // Snap when the target is less than half a tick away
+        if (target - travelled <= speed * half_dt)
+        {
+            finish(v0);
+            return;
+        }
+        publish();
+    }
+
+    T position() const
+    {
+        return pos;
+    }
+
+    T velocity() const
+    {
+        return vel;
+    }
+
+    T acceleration() const
+    {
+        return acc;
+    }
+
+    bool done() const
+    {
+        return finished;
+    }
+
+    /**
+     * @brief Stand still at @p position
+     */
+    void reset(T position = T{})
+    {
+        pos = position;
+        vel = T{};
+        acc = T{};
+        finished = true;
+        stopping = false;
+    }
+
+private:
+    static constexpr T min(T a, T b)
+    {
+        return b < a ? b : a;
+    }
+
+    static constexpr T max(T a, T b)
+    {
+        return a < b ? b : a;
+    }
+
+    /**
+     * @brief Whether braking from speed @p v with acceleration @p a must
+     *        start within @p margin to pass the target at v_end
+     */
+    bool must_brake(T margin, T v, T a) const
+    {
+        if (margin <= T{})
+            return true;
+        // Both shapes keep one tick of travel in hand, since braking only
+        // starts on a tick boundary
+        if (shape == ProfileShape::TRAPEZOID)
+            return v > v_end &&
+                   margin <= (v * v - v_end * v_end) * inv_2a + v * dt;
+
+        // Jerk-limited stopping distance from (v, 0) to (v_end, 0) is at
+        // most (v^2 - ve^2) / 2A + (v + ve) A / 2j (exact with a
+        // constant-deceleration phase, an upper bound without one). A
+        // positive acceleration first has to ramp down, which costs about
+        // a / j more seconds at the speed it ramps up to.
+        const T peak = v + a * a * inv_2j;
+        if (peak <= v_end)
+            return false;
+        const T stopping_distance = (peak * peak - v_end * v_end) * inv_2a +
+                                    (peak + v_end) * limits.a_max * inv_2j +
+                                    peak * (a * inv_j + dt);
+        return margin <= stopping_distance;
+    }
+
+    /**
+     * @param from Speed published before this tick
+     */
+    void finish(T from)
+    {
+        // Settle on v_end unless the move was too short to reach it
+        travelled = target;
+        const T miss = from - v_end;
+        if (miss <= a_dt + a_dt && -miss <= a_dt + a_dt)
+            speed = v_end;
+        accel = T{};
+        finished = true;
+        publish();
+    }
+
+    void publish()
+    {
+        if (sign > 0)
+        {
+            pos = origin + travelled;
+            vel = speed;
+            acc = accel;
+        }
+        else
+        {
+            pos = origin - travelled;
+            vel = -speed;
+            acc = -accel;
+        }
+    }
+
+    const T dt;
+    const T half_dt;
+    T inv_dt{};
+    const ProfileShape shape;
+
+    ProfileLimits<T> limits{};
+    T a_dt{};
+    T j_dt{};
+    T inv_2a{};
+    T inv_j{};
+    T inv_2j{};
+
+    // Current move, in the direction of travel
+    T origin{};
+    int8_t sign = 1;
+    T target{};
+    T travelled{};
+    T swept{};  ///< Sum of v0 + v1 over the move's ticks
+    T speed{};
+    T accel{};
+    T v_end{};
+    bool stopping = false;
+    bool braking = false;  ///< Braking towards the target has begun
+    bool finished = true;
+
+    // Published setpoint
+    T pos{};
+    T vel{};
+    T acc{};
+};
+
+/**
+ * @struct BodySetpoint
+ * @brief Forward and angular velocity for the wheel-speed loops
+ */
+template <typename T>
+struct BodySetpoint
+{
+    T v;  ///< m/s
+    T w;  ///< rad/s
+};
+
+/**
+ * @class BodyProfile
+ * @brief Straight moves and in-place or smooth turns on two profiles
+ * @details A smooth turn holds the forward speed and profiles only the
+ * heading. Its peak yaw rate is speed / radius, so the arc radius holds
+ * wherever the turn cruises. Turns in place start from a standstill.
+ */
+template <typename T>
+class BodyProfile
+{
+public:
+    explicit BodyProfile(T dt, ProfileShape shape = ProfileShape::TRAPEZOID)
+        : linear(dt, shape), angular(dt, shape)
+    {
+    }
+
+    void straight(T distance, const ProfileLimits<T>& limits, T v_end = T{})
+    {
+        linear.start(distance, limits, v_end);
+    }
+
+    void turn_in_place(T angle, const ProfileLimits<T>& limits)
+    {
+        angular.start(angle, limits);
+    }
+
+    /**
+     * @param speed Forward speed held through the turn
+     * @param radius Arc radius at the peak yaw rate
+     */
+    void smooth_turn(T angle, T speed, T radius,
+                     const ProfileLimits<T>& angular_limits)
+    {
+        ProfileLimits<T> limits = angular_limits;
+        limits.v_max = from_float<T>(to_float(speed) / to_float(radius));
+        angular.start(angle, limits);
+        hold_speed = speed;
+        turning = true;
+    }
+
+    void stop()
+    {
+        linear.stop();
+        angular.stop();
+        turning = false;
+    }
+
+    BodySetpoint<T> update()
+    {
+        linear.update();
+        angular.update();
+        const T v = turning ? hold_speed : linear.velocity();
+        if (angular.done())
+            turning = false;
+        return BodySetpoint<T>{v, angular.velocity()};
+    }
+
+    bool done() const
+    {
+        return linear.done() && angular.done();
+    }
+
+    MotionProfile<T> linear;
+    MotionProfile<T> angular;
+
+private:
+    T hold_speed{};
+    bool turning = false;
+};
+
+}  // namespace MM
@@ -0,0 +1,221 @@
+/**
+ * @file pid.h
+ * @brief PID/PIDF controller with anti-windup, in float or fixed point
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details One update() per control tick:
+ * @code
+ * u = kp e + I + kd D + kf r + ff,  clamped to [out_min, out_max]
+ * @endcode
+ * where e = r - y.
+ * - The derivative acts on the measurement, not the error, so setpoint
+ *   steps do not kick the output. It is low-pass filtered. A loop with a
+ *   rate sensor (e.g. a gyro) can pass the measured rate to
+ *   update_with_rate() instead of differencing.
+ * - I is stored already scaled by ki, so changing gains does not bump
+ *   the output.
+ * - Anti-windup is either CLAMP (the integrator holds while the output is
+ *   saturated and the error would push it further) or BACK_CALCULATION
+ *   (the integrator bleeds off kb * (u_sat - u) every tick).
+ *
+ * T is float or a Fixed type. Per-tick constants are computed on the
+ * float side in configure(), so update() never divides.
+ */
+
+#pragma once
+#include <cstdint>
+#include "fixed_point.h"
+
+namespace MM
+{
+
+enum class AntiWindup : uint8_t
+{
+    NONE = 0,
+    CLAMP,            ///< Conditional integration
+    BACK_CALCULATION  ///< Integrator tracks the saturated output
+};
+
+/**
+ * @struct PidConfig
+ * @brief Gains and limits, in float; converted to T once
+ */
+struct PidConfig
+{
+    float kp = 0.0f;
+    float ki = 0.0f;  ///< Per second
+    float kd = 0.0f;  ///< Seconds
+    float kf = 0.0f;  ///< Setpoint feedforward
+    float out_min = -1.0f;
+    float out_max = 1.0f;
+    AntiWindup anti_windup = AntiWindup::BACK_CALCULATION;
+    float kb = 0.0f;           ///< Back-calculation gain, 1/s (0: ki / kp)
+    float d_cutoff_hz = 0.0f;  ///< Derivative low-pass (0: unfiltered)
+};
+
+template <typename T>
+class Pid
+{
+public:
+    /**
+     * @param dt_ Control tick in seconds
+     */
+    explicit Pid(float dt_, const PidConfig& config_ = {}) : dt(dt_)
+    {
+        configure(config_);
+    }
+
+    /**
+     * @brief Change gains and limits; the integrator is kept but clamped
+     */
+    void configure(const PidConfig& config_)
+    {
+        config = config_;
+        kp = from_float<T>(config_.kp);
+        kd_dt = from_float<T>(config_.kd / dt);
+        kf = from_float<T>(config_.kf);
+        ki_dt = from_float<T>(config_.ki * dt);
+        const float kb = config_.kb > 0.0f || config_.kp == 0.0f
+                             ? config_.kb
+                             : config_.ki / config_.kp;
+        kb_dt = from_float<T>(kb * dt);
+        kd_rate = from_float<T>(config_.kd);
+        out_min = from_float<T>(config_.out_min);
+        out_max = from_float<T>(config_.out_max);
+
+        // First-order low-pass: alpha = dt / (dt + 1 / (2 pi fc))
+        float alpha = 1.0f;
+        if (config_.d_cutoff_hz > 0.0f)
+        {
+            const float tau = 1.0f / (6.2831853f * config_.d_cutoff_hz);
+            alpha = dt / (dt + tau);
+        }
+        d_alpha = from_float<T>(alpha);
+        i_term = clamp(i_term);
+    }
+
+    /**
+     * @brief One control tick, differentiating the measurement
+     * @param feedforward Added to the output, e.g. a model term
+     */
+    T update(T setpoint, T measurement, T feedforward = T{})
+    {
+        // Scaled by kd / dt already; the first tick has no history
+        const T slope = primed ? (last_measurement - measurement) * kd_dt
+                               : T{};
+        last_measurement = measurement;
+        primed = true;
+        return step(setpoint - measurement, slope, setpoint, feedforward);
+    }
+
+    /**
+     * @brief One control tick with a measured rate of the measurement
+     * @param rate d(measurement)/dt from a sensor, e.g. gyro yaw rate
+     */
+    T update_with_rate(T setpoint, T measurement, T rate,
+                       T feedforward = T{})
+    {
+        last_measurement = measurement;
+        primed = true;
+        return step(setpoint - measurement, -(rate * kd_rate), setpoint,
+                    feedforward);
+    }
+
+    /**
+     * @brief Clear the integrator and derivative state
+     * @param integral Initial I term, e.g. the current output for a
+     *        bumpless start
+     */
+    void reset(T integral = T{})
+    {
+        i_term = clamp(integral);
+        d_term = T{};
+        output_value = T{};
+        primed = false;
+    }
+
+    T output() const
+    {
+        return output_value;
+    }
+
+    T integral() const
+    {
+        return i_term;
+    }
+
+    bool saturated() const
+    {
+        return output_value <= out_min || output_value >= out_max;
+    }
+
+    const PidConfig& settings() const
+    {
+        return config;
+    }
+
+private:
+    static constexpr T min(T a, T b)
+    {
+        return b < a ? b : a;
+    }
+
+    static constexpr T max(T a, T b)
+    {
+        return a < b ? b : a;
+    }
+
+    T clamp(T v) const
+    {
+        return min(max(v, out_min), out_max);
+    }
+
+    T step(T error, T slope, T setpoint, T feedforward)
+    {
+        d_term += (slope - d_term) * d_alpha;
+        const T unsaturated =
+            kp * error + i_term + d_term + kf * setpoint + feedforward;
+        const T out = clamp(unsaturated);
+
+        const T i_step = ki_dt * error;
+        switch (config.anti_windup)
+        {
+            case AntiWindup::NONE:
+                i_term += i_step;
+                break;
+            case AntiWindup::CLAMP:
+                // Hold while saturated and the error pushes further out
+                if (!((unsaturated > out_max && error > T{}) ||
+                      (unsaturated < out_min && error < T{})))
+                    i_term += i_step;
+                break;
+            case AntiWindup::BACK_CALCULATION:
+                i_term += i_step + (out - unsaturated) * kb_dt;
+                break;
+        }
+
+        output_value = out;
+        return out;
+    }
+
+    const float dt;
+    PidConfig config;
+
+    T kp{};
+    T ki_dt{};
+    T kd_dt{};    ///< kd / dt, for differencing
+    T kd_rate{};  ///< kd, for a measured rate
+    T kf{};
+    T kb_dt{};
+    T d_alpha{};
+    T out_min{};
+    T out_max{};
+
+    T i_term{};
+    T d_term{};  ///< Filtered kd * d(-y)/dt
+    T last_measurement{};
+    T output_value{};
+    bool primed = false;
+};
+
+}  // namespace MM
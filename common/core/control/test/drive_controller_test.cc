@@ -0,0 +1,196 @@
+/**
+ * @file drive_controller_test.cc
+ * @brief Cascaded heading and wheel loops on a simulated drive
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Each wheel is a first-order motor, v' = (gain * duty - v) /
+ * tau. The run is straight with a 10 % weaker left motor, a slipping left
+ * encoder and a biased gyro, then a constant-rate arc. The heading loop
+ * has to hold the true heading, where the wheel loops alone drift.
+ * app/pid_bench times a DriveController tick.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include "drive_controller.h"
+#include "fixed_point.h"
+#include "imu_math.h"
+#include "velocity_estimator.h"
+
+namespace MM
+{
+namespace
+{
+
+constexpr float kDt = 0.001f;
+constexpr float kDeg = 180.0f / 3.14159265f;
+
+// Wheel: v' = (gain * duty - v) / tau
+constexpr float kMotorGain = 2.0f;  // m/s at full duty
+constexpr float kMotorTau = 0.05f;  // s
+
+constexpr PidConfig kWheelPid{.kp = 1.5f,
+                              .ki = 20.0f,
+                              .kf = 1.0f / kMotorGain,
+                              .anti_windup = AntiWindup::BACK_CALCULATION};
+
+constexpr PidConfig kHeadingPid{.kp = 20.0f,
+                                .ki = 40.0f,
+                                .kd = 0.5f,
+                                .out_min = -20.0f,
+                                .out_max = 20.0f,
+                                .d_cutoff_hz = 100.0f};
+
+struct Motor
+{
+    float v = 0.0f;
+    float gain = kMotorGain;
+
+    void step(float duty)
+    {
+        if (duty > 1.0f)
+            duty = 1.0f;
+        if (duty < -1.0f)
+            duty = -1.0f;
+        v += (gain * duty - v) * (kDt / kMotorTau);
+    }
+};
+
+template <typename T>
+class DriveControllerTest : public ::testing::Test
+{
+protected:
+    /**
+     * @brief Straight run with a weak left motor and gyro bias, then an arc
+     * @return Largest heading error over the run against the true heading
+     */
+    static float cascade_error(bool heading_loop, float& final_speed)
+    {
+        DriveConfig config{.heading = kHeadingPid, .wheel = kWheelPid};
+        if (!heading_loop)
+            config.heading = PidConfig{.out_min = -20.0f, .out_max = 20.0f};
+        DriveController<T> drive(config);
+        Motor left{.gain = 0.9f * kMotorGain};
+        Motor right;
+        const float gyro_bias = 0.005f;  // rad/s
+
+        // The left encoder over-reads by 1 % (slip), the gyro is biased
+        float heading = 0.0f;
+        float target = 0.0f;
+        float worst = 0.0f;
+        for (int tick = 0; tick < 2000; tick++)
+        {
+            const float v = tick < 100 ? tick * 0.01f : 1.0f;
+            const float w = tick >= 1200 && tick < 1700 ? 3.0f : 0.0f;
+            target += w * kDt;
+
+            const float true_rate = (right.v - left.v) / config.tread;
+            const DriveFeedback<T> fb{from_float<T>(left.v * 1.01f),
+                                      from_float<T>(right.v),
+                                      from_float<T>(true_rate + gyro_bias)};
+            const MotorCommand<T> duty =
+                drive.update(from_float<T>(v), from_float<T>(w), fb);
+            left.step(to_float(duty.left));
+            right.step(to_float(duty.right));
+            heading += (right.v - left.v) / config.tread * kDt;
+
+            // Ignore the first response of the turn entry and exit
+            const bool settled = tick < 1200 || tick >= 1250;
+            if (settled && tick < 1700)
+                worst = std::fmax(worst, std::fabs(heading - target));
+        }
+        final_speed = 0.5f * (left.v + right.v);
+        return worst;
+    }
+};
+
+using DriveTypes = ::testing::Types<float, Q16_16>;
+TYPED_TEST_SUITE(DriveControllerTest, DriveTypes);
+
+TYPED_TEST(DriveControllerTest, HeadingLoopHoldsTrueHeading)
+{
+    float speed_open = 0.0f;
+    float speed_closed = 0.0f;
+    const float open = this->cascade_error(false, speed_open);
+    const float closed = this->cascade_error(true, speed_closed);
+    EXPECT_LT(closed * kDeg, 2.0f);
+    EXPECT_LT(closed, 0.2f * open);
+    EXPECT_NEAR(speed_closed, 1.0f, 0.02f);
+}
+
+TYPED_TEST(DriveControllerTest, ResetZeroesHeading)
+{
+    DriveController<TypeParam> drive(
+        DriveConfig{.heading = kHeadingPid, .wheel = kWheelPid});
+    const DriveFeedback<TypeParam> fb{TypeParam{}, TypeParam{},
+                                      from_float<TypeParam>(1.0f)};
+    for (int i = 0; i < 100; i++)
+        drive.update(TypeParam{}, TypeParam{}, fb);
+    EXPECT_NEAR(to_float(drive.heading()), 0.098f, 2e-3f);
+
+    drive.reset();
+    EXPECT_EQ(drive.heading(), TypeParam{});
+    EXPECT_EQ(drive.heading_error(), TypeParam{});
+    EXPECT_EQ(drive.heading_pid.integral(), TypeParam{});
+}
+
+TYPED_TEST(DriveControllerTest, FeedbackTakesBno055Units)
+{
+    // 0.2 m of wheel travel per 1000 counts, both wheels at 0.5 m/s
+    VelocityEstimator left{{.units_per_count = 0.2e-3f}};
+    VelocityEstimator right{{.units_per_count = 0.2e-3f}};
+    uint32_t now_us = 0;
+    for (int32_t count = 0; count <= 2500; count += 25)
+    {
+        left.update(count, now_us);
+        right.update(count, now_us);
+        now_us += 10'000;
+    }
+
+    // The BNO055 reports the gyro in deg/s, 1/16 dps per LSB
+    const Vec3 gyro{.x = 0.0f, .y = 0.0f, .z = 90.0f};
+    const DriveFeedback<TypeParam> fb =
+        drive_feedback<TypeParam>(left, right, gyro);
+    EXPECT_NEAR(to_float(fb.left_v), 0.5f, 1e-3f);
+    EXPECT_NEAR(to_float(fb.right_v), 0.5f, 1e-3f);
+    EXPECT_NEAR(to_float(fb.gyro_z), 0.5f * Math::kPi, 1e-3f);
+
+    // Both wheels agree, so the loop's yaw rate is the gyro's share
+    DriveConfig config{.heading = kHeadingPid, .wheel = kWheelPid};
+    DriveController<TypeParam> drive(config);
+    drive.update(TypeParam{}, TypeParam{}, fb);
+    EXPECT_NEAR(to_float(drive.yaw_rate()),
+                config.gyro_weight * 0.5f * Math::kPi, 1e-3f);
+}
+
+/**
+ * @brief Records the last duty written to one H-bridge input
+ */
+struct FakePwm
+{
+    void set_duty(Q16_16 d)
+    {
+        duty = d;
+    }
+
+    Q16_16 duty = Q16_16::from_float(0.5f);
+};
+
+TEST(MotorPwmTest, SignSelectsTheBridgeInput)
+{
+    FakePwm forward;
+    FakePwm reverse;
+    MotorPwm<FakePwm> motor(forward, reverse);
+
+    motor.set(0.25f);
+    EXPECT_EQ(forward.duty, Q16_16::from_float(0.25f));
+    EXPECT_EQ(reverse.duty, Q16_16{});
+
+    motor.set(Q16_16::from_float(-0.75f));
+    EXPECT_EQ(forward.duty, Q16_16{});
+    EXPECT_EQ(reverse.duty, Q16_16::from_float(0.75f));
+}
+
+}  // namespace
+}  // namespace MM
@@ -0,0 +1,165 @@
+/**
+ * @file duty_ramp_test.cc
+ * @brief DMA duty table builder: endpoints, shape, lanes and timing
+ * @author Bex Saw
+ * @date 2026-10-18
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include "duty_ramp.h"
+
+namespace MM
+{
+namespace
+{
+
+// Tables are meant to be built at compile time into flash
+constexpr auto kAccel = [] {
+    DutyTable<500, 2> table;
+    fill_ramp(table.lane(0), 0, 4000, RampShape::SMOOTHSTEP);
+    fill_ramp(table.lane(1), 0, 4000, RampShape::SMOOTHSTEP);
+    return table;
+}();
+static_assert(kAccel.at(499, 0) == 4000 && kAccel.at(499, 1) == 4000);
+
+/**
+ * @brief Check exact endpoints and monotonic frames of one lane
+ */
+template <size_t Frames, size_t Channels>
+void expect_ramp(const DutyTable<Frames, Channels>& table, size_t channel,
+                 uint32_t from, uint32_t to)
+{
+    EXPECT_EQ(table.at(0, channel), from);
+    EXPECT_EQ(table.at(Frames - 1, channel), to);
+    for (size_t i = 1; i < Frames; i++)
+    {
+        if (to >= from)
+            EXPECT_GE(table.at(i, channel), table.at(i - 1, channel)) << i;
+        else
+            EXPECT_LE(table.at(i, channel), table.at(i - 1, channel)) << i;
+    }
+}
+
+TEST(DutyRampTest, EndpointsAndMonotonic)
+{
+    for (RampShape shape : {RampShape::LINEAR, RampShape::SMOOTHSTEP})
+    {
+        SCOPED_TRACE(static_cast<int>(shape));
+        DutyTable<257, 2> rising;
+        fill_ramp(rising.lane(1), 0, 4999, shape);
+        expect_ramp(rising, 1, 0, 4999);
+
+        DutyTable<100, 1> falling;
+        fill_ramp(falling.lane(0), 4000, 100, shape);
+        expect_ramp(falling, 0, 4000, 100);
+
+        // 32-bit timer full scale does not overflow the span
+        DutyTable<33, 1> wide;
+        fill_ramp(wide.lane(0), 0, 100'000'000, shape);
+        expect_ramp(wide, 0, 0, 100'000'000);
+    }
+}
+
+TEST(DutyRampTest, LinearIsWithinHalfACount)
+{
+    // Rounding to a CCR count, plus the Q16 position truncated within
+    // the ramp: at most span / 65536 counts
+    DutyTable<97, 1> table;
+    fill_ramp(table.lane(0), 17, 4999);
+    const double tolerance = 0.5 + (4999.0 - 17.0) / 65536.0;
+    for (size_t i = 0; i < 97; i++)
+    {
+        const double ideal = 17.0 + (4999.0 - 17.0) * i / 96.0;
+        EXPECT_NEAR(static_cast<double>(table.at(i, 0)), ideal, tolerance)
+            << i;
+    }
+}
+
+TEST(DutyRampTest, SmoothstepShape)
+{
+    // Midpoint exactly half way, and symmetric about it. t is truncated
+    // to Q16 and the curve's slope peaks at 1.5, so allow 2 LSB.
+    EXPECT_EQ(ramp_fraction_q16(50, 101, RampShape::SMOOTHSTEP), 0x8000u);
+    for (size_t i = 0; i <= 100; i++)
+    {
+        const uint32_t a = ramp_fraction_q16(i, 101, RampShape::SMOOTHSTEP);
+        const uint32_t b =
+            ramp_fraction_q16(100 - i, 101, RampShape::SMOOTHSTEP);
+        EXPECT_NEAR(static_cast<double>(a + b), 65536.0, 2.0) << i;
+
+        const double t = i / 100.0;
+        EXPECT_NEAR(a / 65536.0, 3 * t * t - 2 * t * t * t, 2.0 / 65536.0);
+    }
+
+    // Zero slope at both ends: the first step is far below the linear one
+    DutyTable<101, 2> table;
+    fill_ramp(table.lane(0), 0, 5000, RampShape::LINEAR);
+    fill_ramp(table.lane(1), 0, 5000, RampShape::SMOOTHSTEP);
+    EXPECT_EQ(table.at(1, 0), 50u);
+    EXPECT_LT(table.at(1, 1), 5u);
+    EXPECT_GT(table.at(99, 1), 4995u);
+    // and steepest in the middle, 1.5x the linear slope
+    EXPECT_NEAR(static_cast<double>(table.at(51, 1) - table.at(50, 1)), 75.0,
+                1.0);
+}
+
+TEST(DutyRampTest, LanesAreInterleavedAndIsolated)
+{
+    DutyTable<10, 4> table;
+    fill_hold(table.lane(0), 7);
+    fill_ramp(table.lane(2), 0, 9);
+    fill_hold(table.lane(3), 1234);
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        // Burst order: ch0, ch1, ch2, ch3 of frame i, then frame i + 1
+        EXPECT_EQ(table.data[i * 4 + 0], 7u);
+        EXPECT_EQ(table.data[i * 4 + 1], 0u);
+        EXPECT_EQ(table.data[i * 4 + 2], i);
+        EXPECT_EQ(table.data[i * 4 + 3], 1234u);
+    }
+}
+
+TEST(DutyRampTest, SubRangeSegments)
+{
+    // Accelerate, cruise, brake in one table
+    DutyTable<30, 2> table;
+    for (size_t ch = 0; ch < 2; ch++)
+    {
+        DutyLane lane = table.lane(ch);
+        fill_ramp(lane.sub(0, 10), 0, 3000, RampShape::SMOOTHSTEP);
+        fill_hold(lane.sub(10, 10), 3000);
+        fill_ramp(lane.sub(20, 10), 3000, 0, RampShape::SMOOTHSTEP);
+    }
+    for (size_t ch = 0; ch < 2; ch++)
+    {
+        EXPECT_EQ(table.at(0, ch), 0u);
+        EXPECT_EQ(table.at(9, ch), 3000u);
+        EXPECT_EQ(table.at(15, ch), 3000u);
+        EXPECT_EQ(table.at(20, ch), 3000u);
+        EXPECT_EQ(table.at(29, ch), 0u);
+    }
+    EXPECT_EQ(table.lane(1).sub(10, 10).size(), 10u);
+}
+
+TEST(DutyRampTest, SingleFrameJumpsToTarget)
+{
+    DutyTable<1, 1> table;
+    fill_ramp(table.lane(0), 100, 900);
+    EXPECT_EQ(table.at(0, 0), 900u);
+}
+
+TEST(DutyRampTest, Duration)
+{
+    EXPECT_EQ(table_duration_us(500, 20'000), 25'000u);
+    // TIM1 with RCR = 3: four update events per frame
+    EXPECT_EQ(table_duration_us(500, 20'000, 4), 100'000u);
+    EXPECT_EQ(table_duration_us(kAccel.kFrames, 1'000), 500'000u);
+    // Frames x 1e6 is done in 64 bits
+    EXPECT_EQ(table_duration_us(100'000, 1'000), 100'000'000u);
+}
+
+}  // namespace
+}  // namespace MM
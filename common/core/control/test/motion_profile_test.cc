@@ -0,0 +1,205 @@
+/**
+ * @file motion_profile_test.cc
+ * @brief Continuity and end-point checks of the motion profiles
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Sweeps straight moves for float and Q16_16 and for both profile
+ * shapes. Moves start from rest, then see mid-move limit and end-velocity
+ * changes and early stops. Every run must:
+ * - land exactly on the target, or stop at rest after stop()
+ * - never move backwards
+ * - keep velocity steps within a_max * dt (TRAPEZOID)
+ * - keep acceleration steps within j_max * dt (S_CURVE)
+ * The final tick may snap the velocity by up to one more step, and the
+ * S-curve acceleration to zero. app/motion_bench times the same moves.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include "fixed_point.h"
+#include "motion_profile.h"
+
+namespace MM
+{
+namespace
+{
+
+constexpr float kDt = 0.001f;
+constexpr float kVMax = 1.5f;
+constexpr float kAMax = 6.0f;
+constexpr float kJMax = 150.0f;
+constexpr uint32_t kMaxTicks = 20000;
+
+enum class Event : uint8_t
+{
+    NONE = 0,
+    SLOW_DOWN,  ///< Halve v_max at 30 % of the move
+    END_SPEED,  ///< Raise v_end at 30 % of the move
+    STOP        ///< stop() at 30 % of the move
+};
+
+/**
+ * @brief Run one move and check it tick by tick
+ */
+template <typename T>
+void check_move(ProfileShape shape, float distance, float v_end, Event event)
+{
+    SCOPED_TRACE(testing::Message() << "event " << static_cast<int>(event)
+                                    << " d=" << distance
+                                    << " v_end=" << v_end);
+    MotionProfile<T> profile(from_float<T>(kDt), shape);
+    ProfileLimits<T> limits{from_float<T>(kVMax), from_float<T>(kAMax),
+                            from_float<T>(kJMax)};
+    profile.reset();
+    profile.start(from_float<T>(distance), limits, from_float<T>(v_end));
+
+    // Steps are measured against the tick as T holds it (Q16_16 rounds
+    // 1 ms up by 0.7 %), with a little slack for rounded products
+    const float dt = to_float(from_float<T>(kDt));
+    const float dv_limit = kAMax * dt;
+    const float da_limit = kJMax * dt;
+    const float slack = 1e-2f;
+
+    // Checks run in the direction of travel
+    const float sign = distance < 0.0f ? -1.0f : 1.0f;
+    float last_pos = 0.0f;
+    float last_v = 0.0f;
+    float last_a = 0.0f;
+    bool changed = false;
+    for (uint32_t tick = 0; tick < kMaxTicks && !profile.done(); tick++)
+    {
+        if (!changed &&
+            sign * to_float(profile.position()) > 0.3f * sign * distance)
+        {
+            changed = true;
+            if (event == Event::SLOW_DOWN)
+            {
+                limits.v_max = from_float<T>(kVMax / 2);
+                profile.set_limits(limits);
+            }
+            else if (event == Event::END_SPEED)
+            {
+                v_end = v_end + 0.4f;
+                profile.set_end_velocity(from_float<T>(v_end));
+            }
+            else if (event == Event::STOP)
+            {
+                profile.stop();
+            }
+        }
+
+        profile.update();
+        const float pos = sign * to_float(profile.position());
+        const float v = sign * to_float(profile.velocity());
+        const float a = sign * to_float(profile.acceleration());
+        const float dv = std::fabs(v - last_v) / dv_limit;
+        const float da = std::fabs(a - last_a) / da_limit;
+        // The snapping tick may take one more velocity step and ends the
+        // acceleration, wherever it was
+        const bool snap = profile.done();
+        const float allowed = snap ? 2.0f : 1.0f;
+
+        ASSERT_GE(pos, last_pos) << "tick " << tick;
+        ASSERT_LE(dv, allowed + slack) << "tick " << tick;
+        if (shape == ProfileShape::S_CURVE && !snap)
+            ASSERT_LE(da, 1.0f + slack) << "tick " << tick;
+        last_pos = pos;
+        last_v = v;
+        if (!profile.done())
+            last_a = a;
+    }
+
+    ASSERT_TRUE(profile.done());
+    const bool on_target = profile.position() == from_float<T>(distance);
+    if (event == Event::STOP && changed)
+    {
+        // A stop too late to take effect ends the move on the target
+        EXPECT_TRUE(on_target || profile.velocity() == T{});
+        return;
+    }
+    EXPECT_TRUE(on_target) << to_float(profile.position());
+    // A move too short to reach v_end ends below it, still speeding up
+    const float v = sign * to_float(profile.velocity());
+    EXPECT_LE(v, v_end + 1e-4f);
+    if (v < v_end - 1e-4f)
+        EXPECT_GT(last_a, 0.0f);
+}
+
+template <typename T>
+void sweep(ProfileShape shape)
+{
+    for (int e = 0; e < 4; e++)
+    {
+        for (float d = 0.01f; d < 2.5f; d += 0.037f)
+        {
+            for (float v_end : {0.0f, 0.3f})
+            {
+                check_move<T>(shape, d, v_end, static_cast<Event>(e));
+                check_move<T>(shape, -d, v_end, static_cast<Event>(e));
+                if (::testing::Test::HasFatalFailure())
+                    return;
+            }
+        }
+    }
+}
+
+template <typename T>
+class MotionProfileTest : public ::testing::Test
+{
+};
+
+using ProfileTypes = ::testing::Types<float, Q16_16>;
+TYPED_TEST_SUITE(MotionProfileTest, ProfileTypes);
+
+TYPED_TEST(MotionProfileTest, TrapezoidSweep)
+{
+    sweep<TypeParam>(ProfileShape::TRAPEZOID);
+}
+
+TYPED_TEST(MotionProfileTest, SCurveSweep)
+{
+    sweep<TypeParam>(ProfileShape::S_CURVE);
+}
+
+TYPED_TEST(MotionProfileTest, LongMoveCruisesAtVMax)
+{
+    MotionProfile<TypeParam> profile(from_float<TypeParam>(kDt));
+    profile.start(from_float<TypeParam>(2.0f),
+                  {from_float<TypeParam>(kVMax), from_float<TypeParam>(kAMax),
+                   from_float<TypeParam>(kJMax)});
+    float peak = 0.0f;
+    while (!profile.done())
+    {
+        profile.update();
+        peak = std::fmax(peak, to_float(profile.velocity()));
+    }
+    EXPECT_NEAR(peak, kVMax, 1e-3f);
+    EXPECT_EQ(profile.velocity(), TypeParam{});
+}
+
+TEST(BodyProfileTest, SmoothTurnHoldsSpeedAndRadius)
+{
+    constexpr float kSpeed = 0.5f;
+    constexpr float kRadius = 0.09f;
+    constexpr float kAngle = 1.5707963f;
+    BodyProfile<float> body(kDt);
+    body.smooth_turn(kAngle, kSpeed, kRadius, {10.0f, 60.0f, 2000.0f});
+
+    float heading = 0.0f;
+    float peak_w = 0.0f;
+    while (!body.done())
+    {
+        const BodySetpoint<float> s = body.update();
+        if (!body.done())
+            EXPECT_EQ(s.v, kSpeed);
+        heading += s.w * kDt;
+        peak_w = std::fmax(peak_w, s.w);
+    }
+    EXPECT_NEAR(peak_w, kSpeed / kRadius, 1e-3f);
+    EXPECT_NEAR(heading, kAngle, 0.01f);
+    EXPECT_EQ(to_float(body.angular.position()), kAngle);
+}
+
+}  // namespace
+}  // namespace MM
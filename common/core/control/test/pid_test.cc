@@ -0,0 +1,160 @@
+/**
+ * @file pid_test.cc
+ * @brief PID terms, limits and anti-windup, in float and Q16_16
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details The windup case runs the loop against a first-order wheel
+ * model, v' = (gain * duty - v) / tau. app/pid_bench times update().
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "fixed_point.h"
+#include "pid.h"
+
+namespace MM
+{
+namespace
+{
+
+constexpr float kDt = 0.001f;
+
+// Wheel: v' = (gain * duty - v) / tau
+constexpr float kMotorGain = 2.0f;  // m/s at full duty
+constexpr float kMotorTau = 0.05f;  // s
+
+constexpr PidConfig kWheelPid{.kp = 1.5f,
+                              .ki = 20.0f,
+                              .kf = 1.0f / kMotorGain,
+                              .anti_windup = AntiWindup::BACK_CALCULATION};
+
+struct Motor
+{
+    float v = 0.0f;
+
+    void step(float duty)
+    {
+        if (duty > 1.0f)
+            duty = 1.0f;
+        if (duty < -1.0f)
+            duty = -1.0f;
+        v += (kMotorGain * duty - v) * (kDt / kMotorTau);
+    }
+};
+
+template <typename T>
+class PidTest : public ::testing::Test
+{
+protected:
+    static T q(float v)
+    {
+        return from_float<T>(v);
+    }
+
+    /**
+     * @brief Wheel asked for 3 m/s (it tops out at 2), then for 1 m/s
+     * @return Time after the step down until it stays within 2 % of
+     *         1 m/s, s
+     */
+    static float windup_recovery(AntiWindup mode, float& final_error)
+    {
+        PidConfig config = kWheelPid;
+        config.anti_windup = mode;
+        Pid<T> pid(kDt, config);
+        Motor motor;
+        int last_outside = 500;
+        for (int tick = 0; tick < 1500; tick++)
+        {
+            const float setpoint = tick < 500 ? 3.0f : 1.0f;
+            const T duty = pid.update(q(setpoint), q(motor.v));
+            motor.step(to_float(duty));
+            if (std::fabs(motor.v - setpoint) > 0.02f)
+                last_outside = tick;
+        }
+        final_error = std::fabs(motor.v - 1.0f);
+        return static_cast<float>(last_outside + 1 - 500) * kDt;
+    }
+};
+
+using PidTypes = ::testing::Types<float, Q16_16>;
+TYPED_TEST_SUITE(PidTest, PidTypes);
+
+TYPED_TEST(PidTest, ProportionalAndFeedforward)
+{
+    Pid<TypeParam> pid(kDt, {.kp = 2.0f, .kf = 0.5f});
+    // 2 * (0.3 - 0.1) + 0.5 * 0.3 + 0.05
+    const float u = to_float(
+        pid.update(this->q(0.3f), this->q(0.1f), this->q(0.05f)));
+    EXPECT_NEAR(u, 0.6f, 1e-3f);
+    EXPECT_FALSE(pid.saturated());
+}
+
+TYPED_TEST(PidTest, IntegratorAccumulatesKiDt)
+{
+    Pid<TypeParam> pid(kDt, {.ki = 10.0f});
+    for (int i = 0; i < 100; i++)
+        pid.update(this->q(0.2f), TypeParam{});
+    // 100 ticks * 10 / s * 1 ms * 0.2
+    EXPECT_NEAR(to_float(pid.integral()), 0.2f, 2e-3f);
+}
+
+TYPED_TEST(PidTest, OutputIsClamped)
+{
+    Pid<TypeParam> pid(kDt, {.kp = 10.0f, .out_min = -0.5f, .out_max = 0.5f});
+    EXPECT_EQ(to_float(pid.update(this->q(1.0f), TypeParam{})), 0.5f);
+    EXPECT_TRUE(pid.saturated());
+    EXPECT_EQ(to_float(pid.update(this->q(-1.0f), TypeParam{})), -0.5f);
+}
+
+TYPED_TEST(PidTest, DerivativeActsOnMeasurementOnly)
+{
+    Pid<TypeParam> pid(kDt, {.kd = 0.01f, .out_min = -100.0f,
+                             .out_max = 100.0f});
+    pid.update(TypeParam{}, TypeParam{});
+    // A setpoint step does not kick the output
+    EXPECT_NEAR(to_float(pid.update(this->q(1.0f), TypeParam{})), 0.0f,
+                1e-4f);
+    // Measurement rising at 1 / ms: D = -kd * 1000
+    EXPECT_NEAR(to_float(pid.update(this->q(1.0f), this->q(0.001f))),
+                -0.01f, 1e-3f);
+}
+
+TYPED_TEST(PidTest, MeasuredRateFeedsTheDerivative)
+{
+    Pid<TypeParam> pid(kDt, {.kd = 0.5f, .out_min = -10.0f,
+                             .out_max = 10.0f});
+    EXPECT_NEAR(to_float(pid.update_with_rate(TypeParam{}, TypeParam{},
+                                              this->q(2.0f))),
+                -1.0f, 1e-3f);
+}
+
+TYPED_TEST(PidTest, ResetLoadsTheIntegrator)
+{
+    Pid<TypeParam> pid(kDt, {.ki = 10.0f});
+    pid.update(this->q(0.5f), TypeParam{});
+    pid.reset(this->q(0.25f));
+    EXPECT_NEAR(to_float(pid.integral()), 0.25f, 1e-4f);
+    // Clamped to the output range
+    pid.reset(this->q(3.0f));
+    EXPECT_EQ(to_float(pid.integral()), 1.0f);
+}
+
+TYPED_TEST(PidTest, AntiWindupRecoversFaster)
+{
+    constexpr const char* kModeNames[] = {"none", "clamp", "back-calc"};
+    float recovery[3];
+    for (int mode = 0; mode < 3; mode++)
+    {
+        SCOPED_TRACE(kModeNames[mode]);
+        float final_error = 0.0f;
+        recovery[mode] = this->windup_recovery(static_cast<AntiWindup>(mode),
+                                               final_error);
+        EXPECT_LT(final_error, 0.01f);
+    }
+    // Clamping and back-calculation settle at least twice as fast
+    EXPECT_LT(recovery[1], 0.5f * recovery[0]);
+    EXPECT_LT(recovery[2], 0.5f * recovery[0]);
+}
+
+}  // namespace
+}  // namespace MM
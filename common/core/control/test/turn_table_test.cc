@@ -0,0 +1,218 @@
+/**
+ * @file turn_table_test.cc
+ * @brief Compile-time turn tables against the analytic turn model
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Builds search, fast and half-size table sets at compile time.
+ * Each turn is checked against the same clothoid-arc-clothoid shape
+ * integrated in double precision with <cmath>:
+ * - length, speed and exit point of the generated table
+ * - the interpolated yaw rate and heading on a grid finer than the table
+ * - the pose after driving the table at a 1 ms tick: heading error, and
+ *   distance from the exit line the turn has to end on
+ * app/turn_bench prints the tables and times at().
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include "turn_table.h"
+
+namespace MM
+{
+namespace
+{
+
+using TurnMath::kPi;
+
+constexpr size_t kSamples = 64;
+constexpr double kTick = 0.001;
+
+constexpr TurnParams kSearchParams{.cell = 0.18f, .lateral_accel = 4.0f};
+constexpr TurnParams kFastParams{.cell = 0.18f, .lateral_accel = 9.0f};
+constexpr TurnParams kHalfParams{.cell = 0.09f, .lateral_accel = 9.0f};
+
+constexpr auto kSearchTurns = make_turn_tables<kSamples>(kSearchParams);
+constexpr auto kFastTurns = make_turn_tables<kSamples>(kFastParams);
+constexpr auto kHalfTurns = make_turn_tables<kSamples>(kHalfParams);
+
+static_assert(kSearchTurns[TurnType::SEARCH_90].speed > 0.0f);
+
+// Tolerances against the analytic model
+constexpr double kMaxRelError = 1e-4;     // Length, speed, exit point
+constexpr double kMaxExitError = 0.5e-3;  // m, driven at 1 ms
+constexpr double kMaxHeadingError = 0.2 * kPi / 180.0;
+
+constexpr const char* kTurnNames[kNumTurnTypes] = {
+    "search90", "fast90", "fast180", "diag45", "diag135", "diag90"};
+
+struct Model
+{
+    double length;
+    double speed;
+    double duration;
+    double peak_w;
+    double dx;
+    double dy;
+};
+
+/**
+ * @brief Same turn from the reference geometry with <cmath> throughout
+ */
+Model model(const TurnParams& params, size_t type)
+{
+    const double ramp = params.ramp;
+    const double mean = 1.0 - ramp;
+    const double angle = TurnMath::kGeometry[type].angle_deg * kPi / 180.0;
+    const double radius = TurnMath::kGeometry[type].radius_cells * params.cell;
+
+    // Midpoint rule, far finer than the compile-time Simpson's rule
+    constexpr int kSteps = 200000;
+    double x = 0.0;
+    double y = 0.0;
+    for (int k = 0; k < kSteps; k++)
+    {
+        const double u = (k + 0.5) / kSteps;
+        const double h = angle * TurnMath::rate_integral(u, ramp) / mean;
+        x += std::cos(h);
+        y += std::sin(h);
+    }
+    x /= kSteps;
+    y /= kSteps;
+
+    Model m{};
+    m.length = angle < kPi - 1e-6
+                   ? radius * std::tan(angle / 2.0) /
+                         (x - y / std::tan(angle))
+                   : 2.0 * radius / y;
+    m.speed = std::min<double>(
+        std::sqrt(params.lateral_accel * m.length * mean / angle),
+        params.v_max);
+    m.duration = m.length / m.speed;
+    m.peak_w = angle / (m.duration * mean);
+    m.dx = m.length * x;
+    m.dy = m.length * y;
+    return m;
+}
+
+void expect_table_matches_model(const TurnParams& params,
+                                const TurnTableSet<kSamples>& set)
+{
+    for (size_t type = 0; type < kNumTurnTypes; type++)
+    {
+        SCOPED_TRACE(kTurnNames[type]);
+        const TurnProfile<kSamples>& turn = set.turns[type];
+        const Model m = model(params, type);
+
+        // Exit point errors are relative to the path length
+        EXPECT_NEAR(turn.length, m.length, kMaxRelError * m.length);
+        EXPECT_NEAR(turn.speed, m.speed, kMaxRelError * m.speed);
+        EXPECT_NEAR(turn.dx, m.dx, kMaxRelError * m.length);
+        EXPECT_NEAR(turn.dy, m.dy, kMaxRelError * m.length);
+        EXPECT_NEAR(turn.peak_w, m.peak_w, kMaxRelError * m.peak_w);
+        // Centripetal acceleration stays within the limit
+        EXPECT_LE(turn.speed * turn.peak_w, params.lateral_accel * 1.0001f);
+    }
+}
+
+void expect_driven_pose(const TurnTableSet<kSamples>& set,
+                        const TurnParams& params)
+{
+    for (size_t type = 0; type < kNumTurnTypes; type++)
+    {
+        SCOPED_TRACE(kTurnNames[type]);
+        const TurnProfile<kSamples>& turn = set.turns[type];
+        const Model m = model(params, type);
+
+        // Drive the table at the control tick and integrate the pose
+        double x = 0.0;
+        double y = 0.0;
+        double heading = 0.0;
+        double t = 0.0;
+        for (; t + kTick <= m.duration; t += kTick)
+        {
+            const TurnSetpoint s0 = turn.at(static_cast<float>(t));
+            const TurnSetpoint s1 = turn.at(static_cast<float>(t + kTick));
+            const double mid = 0.5 * (s0.heading + s1.heading);
+            x += s0.v * kTick * std::cos(mid);
+            y += s0.v * kTick * std::sin(mid);
+            heading = s1.heading;
+        }
+        // The partial last tick
+        const double rest = m.duration - t;
+        const TurnSetpoint s_end = turn.at(static_cast<float>(m.duration));
+        const double mid = 0.5 * (heading + s_end.heading);
+        x += turn.speed * rest * std::cos(mid);
+        y += turn.speed * rest * std::sin(mid);
+        heading = s_end.heading;
+
+        // Distance from the exit line through the model's exit point
+        const double exit_error =
+            std::fabs(-(x - m.dx) * std::sin(turn.angle) +
+                      (y - m.dy) * std::cos(turn.angle));
+        EXPECT_LT(exit_error, kMaxExitError);
+        EXPECT_NEAR(heading, turn.angle, kMaxHeadingError);
+    }
+}
+
+TEST(TurnTableTest, SearchTablesMatchModel)
+{
+    expect_table_matches_model(kSearchParams, kSearchTurns);
+    expect_driven_pose(kSearchTurns, kSearchParams);
+}
+
+TEST(TurnTableTest, FastTablesMatchModel)
+{
+    expect_table_matches_model(kFastParams, kFastTurns);
+    expect_driven_pose(kFastTurns, kFastParams);
+}
+
+TEST(TurnTableTest, HalfSizeTablesMatchModel)
+{
+    expect_table_matches_model(kHalfParams, kHalfTurns);
+    expect_driven_pose(kHalfTurns, kHalfParams);
+}
+
+TEST(TurnTableTest, InterpolationFollowsTheRateShape)
+{
+    const TurnParams& params = kFastParams;
+    const double ramp = params.ramp;
+    const double mean = 1.0 - ramp;
+    for (size_t type = 0; type < kNumTurnTypes; type++)
+    {
+        SCOPED_TRACE(kTurnNames[type]);
+        const TurnProfile<kSamples>& turn = kFastTurns.turns[type];
+        // On a grid much finer than the table; the ramp corners fall
+        // between samples, which is where the yaw rate error peaks
+        for (int k = 0; k <= 10000; k++)
+        {
+            const double u = k / 10000.0;
+            const TurnSetpoint s =
+                turn.at(static_cast<float>(u * turn.duration));
+            EXPECT_NEAR(s.w, turn.peak_w * TurnMath::rate(u, ramp),
+                        0.01 * turn.peak_w);
+            EXPECT_NEAR(s.heading,
+                        turn.angle * TurnMath::rate_integral(u, ramp) / mean,
+                        0.05 * kPi / 180.0);
+        }
+    }
+}
+
+TEST(TurnTableTest, AtClampsToTheTurn)
+{
+    const TurnProfile<kSamples>& turn = kSearchTurns[TurnType::SEARCH_90];
+    const TurnSetpoint before = turn.at(-1.0f);
+    EXPECT_EQ(before.w, 0.0f);
+    EXPECT_EQ(before.heading, 0.0f);
+    EXPECT_EQ(before.v, turn.speed);
+
+    const TurnSetpoint after = turn.at(turn.duration + 1.0f);
+    EXPECT_NEAR(after.w, 0.0f, 1e-6f);
+    EXPECT_NEAR(after.heading, turn.angle, 1e-6f);
+    EXPECT_FALSE(turn.done(0.5f * turn.duration));
+    EXPECT_TRUE(turn.done(turn.duration));
+}
+
+}  // namespace
+}  // namespace MM
@@ -0,0 +1,140 @@
+/**
+ * @file velocity_estimator_test.cc
+ * @brief VelocityEstimator fed from a 16-bit SimEncoder
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details The F411 encoder timers other than TIM2/TIM5 are 16 bits wide,
+ * so the counts here wrap the emulated CNT register several times.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "sim_encoder.h"
+#include "velocity_estimator.h"
+
+namespace MM
+{
+namespace
+{
+
+constexpr uint32_t kTickUs = 1000;
+
+class VelocityEstimatorTest : public ::testing::Test
+{
+protected:
+    /**
+     * @brief Move @p counts_per_tick each tick for @p ticks, reading the
+     * encoder once per tick like the control loop does
+     */
+    void run(int32_t counts_per_tick, uint32_t ticks)
+    {
+        for (uint32_t i = 0; i < ticks; i++)
+        {
+            encoder.step(counts_per_tick);
+            now_us += kTickUs;
+            estimator.update(encoder.count(), now_us);
+        }
+    }
+
+    void SetUp() override
+    {
+        estimator.update(encoder.count(), now_us);
+    }
+
+    SimEncoder encoder{16};
+    VelocityEstimator estimator{{.units_per_count = 0.5f}};
+    uint32_t now_us = 0;
+};
+
+TEST_F(VelocityEstimatorTest, ConstantSpeedAcross16BitWrap)
+{
+    // 40 counts per ms: 200000 counts wraps the register three times
+    run(40, 5000);
+    EXPECT_EQ(estimator.position_counts(), 200000);
+    EXPECT_LT(encoder.raw(), 65536u);
+    EXPECT_EQ(encoder.raw(), 200000u % 65536u);
+    EXPECT_FLOAT_EQ(estimator.distance(), 100000.0f);
+    EXPECT_NEAR(estimator.velocity(), 20000.0f, 1.0f);
+}
+
+TEST_F(VelocityEstimatorTest, DirectionReversalThroughZero)
+{
+    run(25, 400);
+    ASSERT_EQ(estimator.position_counts(), 10000);
+    EXPECT_NEAR(estimator.velocity(), 12500.0f, 1.0f);
+
+    // Back past the start, so CNT wraps downwards from 0 to 0xFFFF
+    run(-25, 800);
+    EXPECT_EQ(estimator.position_counts(), -10000);
+    EXPECT_EQ(encoder.raw(), 65536u - 10000u);
+    EXPECT_NEAR(estimator.velocity(), -12500.0f, 1.0f);
+
+    // And forward again across the same wrap
+    run(60, 500);
+    EXPECT_EQ(estimator.position_counts(), 20000);
+    EXPECT_NEAR(estimator.velocity(), 30000.0f, 1.0f);
+}
+
+TEST_F(VelocityEstimatorTest, ReversalIsTrackedByTheFilter)
+{
+    run(20, 100);
+    // The first sample after the reversal already has the new sign
+    encoder.step(-20);
+    now_us += kTickUs;
+    ASSERT_TRUE(estimator.update(encoder.count(), now_us));
+    EXPECT_LT(estimator.velocity(), 0.5f * 10000.0f);
+
+    run(-20, 20);
+    EXPECT_LT(estimator.velocity(), 0.0f);
+    EXPECT_NEAR(estimator.velocity(), -10000.0f, 1.0f);
+}
+
+TEST_F(VelocityEstimatorTest, LargestStepBetweenReadsStillUnwraps)
+{
+    // Just under half the 16-bit range per read, both ways
+    run(32767, 10);
+    EXPECT_EQ(estimator.position_counts(), 327670);
+    run(-32767, 20);
+    EXPECT_EQ(estimator.position_counts(), -327670);
+}
+
+TEST_F(VelocityEstimatorTest, SlowSpeedUsesElapsedTime)
+{
+    // One count every 5 ms is 0 or 1 per tick; the window waits for
+    // min_counts and divides by the real 20 ms
+    for (uint32_t i = 0; i < 400; i++)
+    {
+        if (i % 5 == 4)
+            encoder.step(1);
+        now_us += kTickUs;
+        estimator.update(encoder.count(), now_us);
+    }
+    EXPECT_NEAR(estimator.velocity(), 100.0f, 0.5f);
+}
+
+TEST_F(VelocityEstimatorTest, StoppedDecaysToZero)
+{
+    run(-40, 100);
+    ASSERT_LT(estimator.velocity(), 0.0f);
+
+    // Nothing moves: after max_window_us each window reports zero
+    run(0, 2000);
+    EXPECT_NEAR(estimator.velocity(), 0.0f, 1e-3f);
+    EXPECT_EQ(estimator.position_counts(), -4000);
+}
+
+TEST_F(VelocityEstimatorTest, ResetRestartsFromCurrentCount)
+{
+    run(40, 2000);
+    estimator.reset();
+    EXPECT_EQ(estimator.position_counts(), 0);
+    EXPECT_EQ(estimator.velocity(), 0.0f);
+
+    // The register keeps its wrapped value; the estimator re-primes on it
+    estimator.update(encoder.count(), now_us);
+    run(40, 10);
+    EXPECT_EQ(estimator.position_counts(), 400);
+}
+
+}  // namespace
+}  // namespace MM
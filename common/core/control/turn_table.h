@@ -0,0 +1,313 @@
+/**
+ * @file turn_table.h
+ * @brief Compile-time velocity and angular-rate tables for smooth turns
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Each smooth turn runs at a constant forward speed. Its yaw rate
+ * ramps up linearly, holds, then ramps down again, so the path is a
+ * clothoid, an arc and a clothoid. Sizing that shape to fit the maze
+ * needs trig integrals, which are too slow for the control tick.
+ * make_turn_tables() therefore does all of that at compile time:
+ * - It scales each turn so that it joins the same entry and exit lines as
+ *   a circular arc of the turn type's reference radius.
+ * - It picks the highest speed whose peak centripetal acceleration stays
+ *   within TurnParams::lateral_accel.
+ * - It samples the yaw rate and heading over the turn into a table.
+ *
+ * At run time at() only interpolates between two samples. Tables are for
+ * left turns; negate w and heading for right turns.
+ *
+ * Define table sets as constexpr at namespace scope. They then land in
+ * .rodata, which the linker scripts place in flash:
+ * @code
+ * inline constexpr auto kSearchTurns =
+ *     MM::make_turn_tables<64>({.cell = 0.18f, .lateral_accel = 4.0f});
+ *
+ * const auto& turn = kSearchTurns[MM::TurnType::SEARCH_90];
+ * const MM::TurnSetpoint s = turn.at(elapsed_s);  // Every 1 ms
+ * @endcode
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace MM
+{
+
+enum class TurnType : uint8_t
+{
+    SEARCH_90 = 0,  ///< Cell edge to cell edge around one cell centre
+    FAST_90,        ///< 90 degrees on a one-cell radius
+    FAST_180,       ///< U-turn into the neighbouring column
+    DIAG_45,        ///< Straight to diagonal (or back)
+    DIAG_135,       ///< Straight to diagonal, the sharp way
+    DIAG_90         ///< Diagonal to diagonal
+};
+
+inline constexpr size_t kNumTurnTypes = 6;
+
+/**
+ * @struct TurnParams
+ * @brief Robot and maze parameters the tables are generated from
+ */
+struct TurnParams
+{
+    float cell = 0.18f;          ///< Cell pitch in m (0.09 for half size)
+    float lateral_accel = 6.0f;  ///< Peak centripetal acceleration, m/s^2
+    float v_max = 3.0f;          ///< Speed cap, m/s
+    float ramp = 0.35f;          ///< Share of the turn in each yaw ramp
+};
+
+/**
+ * @struct TurnSetpoint
+ * @brief Forward speed, yaw rate and heading at one instant of a turn
+ */
+struct TurnSetpoint
+{
+    float v;        ///< m/s
+    float w;        ///< rad/s
+    float heading;  ///< rad from the entry heading
+};
+
+struct TurnSample
+{
+    float w;
+    float heading;
+};
+
+/**
+ * @struct TurnProfile
+ * @brief One turn type: scalars plus N samples evenly spaced in time
+ */
+template <size_t N>
+struct TurnProfile
+{
+    static_assert(N >= 2, "A turn table needs at least two samples");
+
+    float angle;     ///< rad
+    float speed;     ///< Forward speed through the turn, m/s
+    float duration;  ///< s
+    float length;    ///< Path length, m
+    float dx;        ///< Exit point along the entry heading, m
+    float dy;        ///< Exit point to the left of the entry heading, m
+    float peak_w;    ///< rad/s
+    float step_inv;  ///< Samples per second
+    std::array<TurnSample, N> samples;
+
+    /**
+     * @brief Setpoint @p t seconds into the turn (clamped to the turn)
+     */
+    constexpr TurnSetpoint at(float t) const
+    {
+        float u = t * step_inv;
+        if (!(u > 0.0f))
+            u = 0.0f;
+        if (u > static_cast<float>(N - 1))
+            u = static_cast<float>(N - 1);
+        size_t i = static_cast<size_t>(u);
+        if (i == N - 1)
+            i = N - 2;
+        const float f = u - static_cast<float>(i);
+        const TurnSample& a = samples[i];
+        const TurnSample& b = samples[i + 1];
+        return TurnSetpoint{speed, a.w + (b.w - a.w) * f,
+                            a.heading + (b.heading - a.heading) * f};
+    }
+
+    constexpr bool done(float t) const
+    {
+        return t >= duration;
+    }
+};
+
+/**
+ * @struct TurnTableSet
+ * @brief One TurnProfile per TurnType, generated from one TurnParams
+ */
+template <size_t N>
+struct TurnTableSet
+{
+    std::array<TurnProfile<N>, kNumTurnTypes> turns;
+
+    constexpr const TurnProfile<N>& operator[](TurnType type) const
+    {
+        return turns[static_cast<size_t>(type)];
+    }
+};
+
+namespace TurnMath
+{
+
+/**
+ * @struct TurnGeometry
+ * @brief Angle and reference radius of a turn type, in cells
+ * @details The turn joins the same entry and exit lines as a circular
+ * arc of this radius: below 180 degrees it keeps the arc's tangent
+ * points, and a U-turn keeps its lateral offset of two radii.
+ */
+struct TurnGeometry
+{
+    double angle_deg;
+    double radius_cells;
+};
+
+inline constexpr TurnGeometry kGeometry[kNumTurnTypes] = {
+    {90.0, 0.5},                  // SEARCH_90
+    {90.0, 1.0},                  // FAST_90
+    {180.0, 0.5},                 // FAST_180
+    {45.0, 1.0},                  // DIAG_45
+    {135.0, 0.5},                 // DIAG_135
+    {90.0, 0.70710678118654752},  // DIAG_90: half a diagonal cell
+};
+
+inline constexpr double kPi = 3.14159265358979323846;
+
+// Compile-time only, so double precision costs nothing on the M4
+
+constexpr double sin(double x)
+{
+    // Reduce to [-pi/2, pi/2] using sin(pi - x) = sin(x)
+    while (x > kPi)
+        x -= 2.0 * kPi;
+    while (x < -kPi)
+        x += 2.0 * kPi;
+    if (x > kPi / 2.0)
+        x = kPi - x;
+    else if (x < -kPi / 2.0)
+        x = -kPi - x;
+    const double x2 = x * x;
+    double term = x;
+    double sum = x;
+    for (int k = 1; k < 12; k++)
+    {
+        term *= -x2 / ((2.0 * k) * (2.0 * k + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cos(double x)
+{
+    return sin(x + kPi / 2.0);
+}
+
+constexpr double sqrt(double x)
+{
+    if (x <= 0.0)
+        return 0.0;
+    double y = x > 1.0 ? x : 1.0;
+    for (int i = 0; i < 64; i++)
+        y = 0.5 * (y + x / y);
+    return y;
+}
+
+/**
+ * @brief Yaw-rate shape over normalised time u in [0, 1], peak 1
+ */
+constexpr double rate(double u, double ramp)
+{
+    if (u < ramp)
+        return u / ramp;
+    if (u > 1.0 - ramp)
+        return (1.0 - u) / ramp;
+    return 1.0;
+}
+
+/**
+ * @brief Integral of rate() from 0 to u
+ */
+constexpr double rate_integral(double u, double ramp)
+{
+    if (u < ramp)
+        return u * u / (2.0 * ramp);
+    if (u > 1.0 - ramp)
+    {
+        const double left = 1.0 - u;
+        return 1.0 - ramp - left * left / (2.0 * ramp);
+    }
+    return u - ramp / 2.0;
+}
+
+}  // namespace TurnMath
+
+/**
+ * @brief Generate the turn tables for one set of robot parameters
+ * @details Invalid parameters are a compile error.
+ */
+template <size_t N>
+consteval TurnTableSet<N> make_turn_tables(const TurnParams& params)
+{
+    using namespace TurnMath;
+    if (!(params.cell > 0.0f) || !(params.lateral_accel > 0.0f) ||
+        !(params.v_max > 0.0f))
+        throw "Turn parameters must be positive";
+    if (!(params.ramp > 0.0f) || params.ramp > 0.5f)
+        throw "Turn ramp share must be in (0, 0.5]";
+
+    const double ramp = params.ramp;
+    const double mean = 1.0 - ramp;  // Mean of rate() over the turn
+    TurnTableSet<N> set{};
+    for (size_t type = 0; type < kNumTurnTypes; type++)
+    {
+        const double angle = kGeometry[type].angle_deg * (kPi / 180.0);
+        const double radius = kGeometry[type].radius_cells * params.cell;
+
+        // Exit point of the unit-length path, by Simpson's rule
+        constexpr int kSteps = 512;
+        double x = 0.0;
+        double y = 0.0;
+        for (int k = 0; k <= kSteps; k++)
+        {
+            const double u = static_cast<double>(k) / kSteps;
+            const double heading = angle * rate_integral(u, ramp) / mean;
+            const double weight =
+                (k == 0 || k == kSteps) ? 1.0 : (k % 2 != 0 ? 4.0 : 2.0);
+            x += weight * cos(heading);
+            y += weight * sin(heading);
+        }
+        x /= 3.0 * kSteps;
+        y /= 3.0 * kSteps;
+
+        // Scale to the reference arc's tangent length or U-turn offset
+        double length = 0.0;
+        if (angle < kPi - 1e-6)
+        {
+            const double tangent =
+                radius * sin(angle / 2.0) / cos(angle / 2.0);
+            length = tangent / (x - y * cos(angle) / sin(angle));
+        }
+        else
+        {
+            length = 2.0 * radius / y;
+        }
+
+        // Peak centripetal acceleration is v * peak_w = v^2 angle / (S m)
+        double speed = sqrt(params.lateral_accel * length * mean / angle);
+        if (speed > params.v_max)
+            speed = params.v_max;
+        const double duration = length / speed;
+        const double peak_w = angle / (duration * mean);
+
+        TurnProfile<N>& turn = set.turns[type];
+        turn.angle = static_cast<float>(angle);
+        turn.speed = static_cast<float>(speed);
+        turn.duration = static_cast<float>(duration);
+        turn.length = static_cast<float>(length);
+        turn.dx = static_cast<float>(length * x);
+        turn.dy = static_cast<float>(length * y);
+        turn.peak_w = static_cast<float>(peak_w);
+        turn.step_inv = static_cast<float>((N - 1) / duration);
+        for (size_t i = 0; i < N; i++)
+        {
+            const double u = static_cast<double>(i) / (N - 1);
+            turn.samples[i] = TurnSample{
+                static_cast<float>(peak_w * rate(u, ramp)),
+                static_cast<float>(angle * rate_integral(u, ramp) / mean)};
+        }
+    }
+    return set;
+}
+
+}  // namespace MM
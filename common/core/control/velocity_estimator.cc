@@ -0,0 +1,57 @@
+#include "velocity_estimator.h"
+#include "timebase.h"
+
+namespace MM
+{
+
+VelocityEstimator::VelocityEstimator(const VelocityEstimatorConfig& config_)
+    : config(config_)
+{
+}
+
+void VelocityEstimator::reset()
+{
+    primed = false;
+    position = 0;
+    window_position = 0;
+    filtered = 0.0f;
+}
+
+bool VelocityEstimator::update(int32_t count, uint32_t now_us)
+{
+    if (!primed)
+    {
+        last_count = count;
+        window_start_us = now_us;
+        window_position = position;
+        primed = true;
+        return false;
+    }
+
+    // int32 difference is wrap-safe; widen before accumulating
+    position += static_cast<int32_t>(static_cast<uint32_t>(count) -
+                                     static_cast<uint32_t>(last_count));
+    last_count = count;
+
+    const int64_t moved = position - window_position;
+    const uint64_t moved_abs = moved < 0 ? -moved : moved;
+    const uint32_t dt_us = Utils::elapsed(window_start_us, now_us);
+
+    const bool enough_counts =
+        moved_abs >= config.min_counts && dt_us > 0;
+    const bool enough_time =
+        dt_us >= config.min_window_us &&
+        (moved_abs > 0 || dt_us >= config.max_window_us);
+    if (!enough_counts && !enough_time)
+        return false;
+
+    const float sample = static_cast<float>(moved) * config.units_per_count *
+                         1e6f / static_cast<float>(dt_us);
+    filtered += config.alpha * (sample - filtered);
+
+    window_position = position;
+    window_start_us = now_us;
+    return true;
+}
+
+}  // namespace MM
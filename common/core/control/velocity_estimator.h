@@ -0,0 +1,76 @@
+/**
+ * @file velocity_estimator.h
+ * @brief Encoder velocity from count deltas and timestamps
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details At low speed a fixed-period count difference is dominated by
+ * quantisation (0 or 1 count per tick). The estimator therefore only
+ * recomputes once either enough counts or enough time have accumulated,
+ * dividing by the real elapsed time, then low-pass filters the result.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace MM
+{
+
+struct VelocityEstimatorConfig
+{
+    float units_per_count = 1.0f;    ///< e.g. mm of travel per x4 count
+    uint32_t min_counts = 4;         ///< Recompute once this many moved
+    uint32_t min_window_us = 1000;   ///< ... or once this much time passed
+    uint32_t max_window_us = 50000;  ///< Report zero after this long unmoved
+    float alpha = 0.5f;              ///< Weight of a new sample, (0, 1]
+};
+
+class VelocityEstimator
+{
+public:
+    explicit VelocityEstimator(const VelocityEstimatorConfig& config_ = {});
+
+    /**
+     * @brief Feed one encoder reading
+     * @param count Encoder::count(), wrap-safe
+     * @param now_us Timestamp of the reading (Utils::now_us())
+     * @return true if a new velocity sample was taken
+     */
+    bool update(int32_t count, uint32_t now_us);
+
+    /**
+     * @brief Filtered velocity in units per second
+     */
+    float velocity() const
+    {
+        return filtered;
+    }
+
+    /**
+     * @brief Travel since the first update, in units
+     */
+    float distance() const
+    {
+        return static_cast<float>(position) * config.units_per_count;
+    }
+
+    /**
+     * @brief Overflow-free accumulated count since the first update
+     */
+    int64_t position_counts() const
+    {
+        return position;
+    }
+
+    void reset();
+
+private:
+    VelocityEstimatorConfig config;
+    bool primed = false;
+    int32_t last_count = 0;       ///< Count at the previous update()
+    int64_t position = 0;         ///< Sum of deltas, never wraps in practice
+    int64_t window_position = 0;  ///< position at the start of the window
+    uint32_t window_start_us = 0;
+    float filtered = 0.0f;
+};
+
+}  // namespace MM
@@ -0,0 +1,497 @@
+/**
+ * @file fixed_point.h
+ * @brief Saturating Q-format fixed-point types and DSP kernels
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Fixed<Storage, FracBits> is a signed Q(m).(FracBits) number held
+ * in Storage. All arithmetic saturates instead of wrapping. On the M4 the
+ * hot helpers map to the DSP extension (QADD, QSUB, SSAT, SMLAD, SMLALD)
+ * through cmsis_gcc.h; everywhere else, and in constant expressions, a
+ * portable C++ fallback gives bit-identical results.
+ */
+
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "imu_math.h"
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "cmsis_compiler.h"
+#define MM_FIXED_USE_DSP 1
+#else
+#define MM_FIXED_USE_DSP 0
+#endif
+
+namespace MM
+{
+namespace Dsp
+{
+
+/**
+ * @brief Saturate a 32-bit value to a signed Bits-bit range (SSAT)
+ */
+template <int Bits>
+constexpr int32_t ssat(int32_t x)
+{
+    static_assert(Bits > 0 && Bits <= 32, "ssat width out of range");
+    if constexpr (Bits == 32)
+    {
+        return x;
+    }
+    else
+    {
+#if MM_FIXED_USE_DSP
+        if (!std::is_constant_evaluated())
+        {
+            return __SSAT(x, Bits);
+        }
+#endif
+        constexpr int32_t kMax = (int32_t{1} << (Bits - 1)) - 1;
+        constexpr int32_t kMin = -kMax - 1;
+        return x > kMax ? kMax : (x < kMin ? kMin : x);
+    }
+}
+
+/**
+ * @brief Saturate a 64-bit intermediate to int32_t
+ */
+constexpr int32_t sat32(int64_t x)
+{
+    constexpr int64_t kMax = std::numeric_limits<int32_t>::max();
+    constexpr int64_t kMin = std::numeric_limits<int32_t>::min();
+    return static_cast<int32_t>(x > kMax ? kMax : (x < kMin ? kMin : x));
+}
+
+/**
+ * @brief Saturating 32-bit add (QADD)
+ */
+constexpr int32_t qadd(int32_t a, int32_t b)
+{
+#if MM_FIXED_USE_DSP
+    if (!std::is_constant_evaluated())
+    {
+        return __QADD(a, b);
+    }
+#endif
+    return sat32(static_cast<int64_t>(a) + b);
+}
+
+/**
+ * @brief Saturating 32-bit subtract (QSUB)
+ */
+constexpr int32_t qsub(int32_t a, int32_t b)
+{
+#if MM_FIXED_USE_DSP
+    if (!std::is_constant_evaluated())
+    {
+        return __QSUB(a, b);
+    }
+#endif
+    return sat32(static_cast<int64_t>(a) - b);
+}
+
+/**
+ * @brief Pack two 16-bit lanes into one word for the dual-MAC kernels
+ */
+constexpr uint32_t pack16x2(int16_t lo, int16_t hi)
+{
+    return (static_cast<uint32_t>(static_cast<uint16_t>(hi)) << 16) |
+           static_cast<uint16_t>(lo);
+}
+
+/**
+ * @brief Dual 16x16 multiply-accumulate: acc + x.lo*y.lo + x.hi*y.hi (SMLAD)
+ * @note Like the instruction, the final accumulate wraps (sets Q on HW).
+ */
+constexpr int32_t smlad(uint32_t x, uint32_t y, int32_t acc)
+{
+#if MM_FIXED_USE_DSP
+    if (!std::is_constant_evaluated())
+    {
+        return static_cast<int32_t>(__SMLAD(x, y, static_cast<uint32_t>(acc)));
+    }
+#endif
+    const int32_t lo = static_cast<int32_t>(static_cast<int16_t>(x)) *
+                       static_cast<int16_t>(y);
+    const int32_t hi = static_cast<int32_t>(static_cast<int16_t>(x >> 16)) *
+                       static_cast<int16_t>(y >> 16);
+    return static_cast<int32_t>(static_cast<uint32_t>(acc) +
+                                static_cast<uint32_t>(lo) +
+                                static_cast<uint32_t>(hi));
+}
+
+/**
+ * @brief Dual 16x16 multiply-accumulate into 64 bits (SMLALD)
+ * @details Same as smlad() but the accumulator cannot overflow, so it is
+ * used by the vector/quaternion kernels below.
+ */
+constexpr int64_t smlald(uint32_t x, uint32_t y, int64_t acc)
+{
+#if MM_FIXED_USE_DSP
+    if (!std::is_constant_evaluated())
+    {
+        return static_cast<int64_t>(
+            __SMLALD(x, y, static_cast<uint64_t>(acc)));
+    }
+#endif
+    const int32_t lo = static_cast<int32_t>(static_cast<int16_t>(x)) *
+                       static_cast<int16_t>(y);
+    const int32_t hi = static_cast<int32_t>(static_cast<int16_t>(x >> 16)) *
+                       static_cast<int16_t>(y >> 16);
+    return acc + lo + hi;
+}
+
+}  // namespace Dsp
+
+/**
+ * @class Fixed
+ * @brief Saturating signed fixed-point number
+ * @tparam Storage int16_t or int32_t
+ * @tparam FracBits Number of fractional bits
+ */
+template <typename Storage, int FracBits>
+class Fixed
+{
+    static_assert(std::is_same_v<Storage, int16_t> ||
+                      std::is_same_v<Storage, int32_t>,
+                  "Fixed supports int16_t and int32_t storage");
+    static_assert(FracBits >= 0 &&
+                      FracBits < static_cast<int>(sizeof(Storage) * 8),
+                  "FracBits must leave room for the sign bit");
+
+public:
+    using storage_type = Storage;
+    static constexpr int kFracBits = FracBits;
+    static constexpr int kBits = static_cast<int>(sizeof(Storage) * 8);
+
+    constexpr Fixed() = default;
+
+    static constexpr Fixed from_raw(Storage raw)
+    {
+        Fixed f;
+        f.raw_ = raw;
+        return f;
+    }
+
+    /**
+     * @brief Convert from float with rounding and saturation
+     */
+    static constexpr Fixed from_float(float value)
+    {
+        const float scaled = value * kScale;
+        constexpr float kMax = static_cast<float>(kRawMax);
+        constexpr float kMin = static_cast<float>(kRawMin);
+        if (scaled >= kMax)
+            return from_raw(kRawMax);
+        if (scaled <= kMin)
+            return from_raw(kRawMin);
+        const float rounded = scaled + (scaled >= 0.0f ? 0.5f : -0.5f);
+        return from_raw(static_cast<Storage>(static_cast<int32_t>(rounded)));
+    }
+
+    /**
+     * @brief Convert from an integer (saturating)
+     */
+    static constexpr Fixed from_int(int32_t value)
+    {
+        return from_raw(narrow(static_cast<int64_t>(value) << FracBits));
+    }
+
+    /**
+     * @brief Re-scale from another Q format (rounding, saturating)
+     */
+    template <typename S, int F>
+    static constexpr Fixed from(Fixed<S, F> other)
+    {
+        int64_t v = other.raw();
+        if constexpr (F > FracBits)
+        {
+            v = (v + (int64_t{1} << (F - FracBits - 1))) >> (F - FracBits);
+        }
+        else if constexpr (F < FracBits)
+        {
+            v = v * (int64_t{1} << (FracBits - F));
+        }
+        return from_raw(narrow(v));
+    }
+
+    static constexpr Fixed max()
+    {
+        return from_raw(kRawMax);
+    }
+
+    static constexpr Fixed min()
+    {
+        return from_raw(kRawMin);
+    }
+
+    constexpr Storage raw() const
+    {
+        return raw_;
+    }
+
+    constexpr float to_float() const
+    {
+        return static_cast<float>(raw_) * (1.0f / kScale);
+    }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b)
+    {
+        if constexpr (kBits == 32)
+            return from_raw(Dsp::qadd(a.raw_, b.raw_));
+        else
+            return from_raw(static_cast<Storage>(
+                Dsp::ssat<kBits>(int32_t{a.raw_} + b.raw_)));
+    }
+
+    friend constexpr Fixed operator-(Fixed a, Fixed b)
+    {
+        if constexpr (kBits == 32)
+            return from_raw(Dsp::qsub(a.raw_, b.raw_));
+        else
+            return from_raw(static_cast<Storage>(
+                Dsp::ssat<kBits>(int32_t{a.raw_} - b.raw_)));
+    }
+
+    friend constexpr Fixed operator-(Fixed a)
+    {
+        return Fixed{} - a;
+    }
+
+    /**
+     * @brief Saturating multiply with round-to-nearest
+     */
+    friend constexpr Fixed operator*(Fixed a, Fixed b)
+    {
+        if constexpr (kBits == 16)
+        {
+            // 16x16 -> 32 fits a single SMULBB; no 64-bit math needed
+            int32_t p = int32_t{a.raw_} * b.raw_;
+            if constexpr (FracBits > 0)
+                p = (p + (int32_t{1} << (FracBits - 1))) >> FracBits;
+            return from_raw(static_cast<Storage>(Dsp::ssat<16>(p)));
+        }
+        else
+        {
+            int64_t p = static_cast<int64_t>(a.raw_) * b.raw_;
+            if constexpr (FracBits > 0)
+                p = (p + (int64_t{1} << (FracBits - 1))) >> FracBits;
+            return from_raw(Dsp::sat32(p));
+        }
+    }
+
+    /**
+     * @brief Scale by an integer (saturating)
+     */
+    friend constexpr Fixed operator*(Fixed a, int32_t k)
+    {
+        return from_raw(narrow(static_cast<int64_t>(a.raw_) * k));
+    }
+
+    constexpr Fixed& operator+=(Fixed b)
+    {
+        return *this = *this + b;
+    }
+
+    constexpr Fixed& operator-=(Fixed b)
+    {
+        return *this = *this - b;
+    }
+
+    constexpr Fixed& operator*=(Fixed b)
+    {
+        return *this = *this * b;
+    }
+
+    friend constexpr auto operator<=>(Fixed, Fixed) = default;
+    friend constexpr bool operator==(Fixed, Fixed) = default;
+
+private:
+    static constexpr Storage kRawMax = std::numeric_limits<Storage>::max();
+    static constexpr Storage kRawMin = std::numeric_limits<Storage>::min();
+    static constexpr float kScale =
+        static_cast<float>(int64_t{1} << FracBits);
+
+    static constexpr Storage narrow(int64_t v)
+    {
+        return static_cast<Storage>(v > kRawMax ? kRawMax
+                                                : (v < kRawMin ? kRawMin : v));
+    }
+
+    Storage raw_ = 0;
+};
+
+using Q15 = Fixed<int16_t, 15>;     ///< [-1, 1), audio/DSP style
+using Q31 = Fixed<int32_t, 31>;     ///< [-1, 1), high precision
+using Q14 = Fixed<int16_t, 14>;     ///< BNO055 quaternion (1/2^14)
+using Q4 = Fixed<int16_t, 4>;       ///< BNO055 gyro in dps (1/16)
+using Q16_16 = Fixed<int32_t, 16>;  ///< General purpose control values
+
+template <typename T>
+concept FixedPoint = requires(T t) {
+    typename T::storage_type;
+    { T::kFracBits } -> std::convertible_to<int>;
+    { t.raw() } -> std::same_as<typename T::storage_type>;
+};
+
+/**
+ * @brief Float constant as T, for code templated on float or a Fixed type
+ */
+template <typename T>
+constexpr T from_float(float value)
+{
+    if constexpr (FixedPoint<T>)
+        return T::from_float(value);
+    else
+        return static_cast<T>(value);
+}
+
+template <typename T>
+constexpr float to_float(T value)
+{
+    if constexpr (FixedPoint<T>)
+        return value.to_float();
+    else
+        return static_cast<float>(value);
+}
+
+/**
+ * @struct QVec3
+ * @brief Fixed-point 3-vector
+ */
+template <FixedPoint Q>
+struct QVec3
+{
+    Q x, y, z;
+
+    constexpr Vec3 to_float() const
+    {
+        return {x.to_float(), y.to_float(), z.to_float()};
+    }
+
+    static constexpr QVec3 from_float(const Vec3& v)
+    {
+        return {Q::from_float(v.x), Q::from_float(v.y), Q::from_float(v.z)};
+    }
+};
+
+template <FixedPoint Q>
+constexpr QVec3<Q> operator+(const QVec3<Q>& a, const QVec3<Q>& b)
+{
+    return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+template <FixedPoint Q>
+constexpr QVec3<Q> operator-(const QVec3<Q>& a, const QVec3<Q>& b)
+{
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+template <FixedPoint Q>
+constexpr QVec3<Q> operator*(const QVec3<Q>& a, Q s)
+{
+    return {a.x * s, a.y * s, a.z * s};
+}
+
+namespace Dsp
+{
+
+/**
+ * @brief acc + a0*b0 + a1*b1 on raw values; one SMLALD for 16-bit formats
+ */
+template <FixedPoint Q>
+constexpr int64_t mac2(Q a0, Q b0, Q a1, Q b1, int64_t acc)
+{
+    if constexpr (sizeof(typename Q::storage_type) == 2)
+    {
+        return smlald(pack16x2(a0.raw(), a1.raw()),
+                      pack16x2(b0.raw(), b1.raw()), acc);
+    }
+    else
+    {
+        return acc + static_cast<int64_t>(a0.raw()) * b0.raw() +
+               static_cast<int64_t>(a1.raw()) * b1.raw();
+    }
+}
+
+/**
+ * @brief Round a Q(2F) accumulator back to Q(F) and saturate
+ */
+template <FixedPoint Q>
+constexpr Q round_acc(int64_t acc)
+{
+    using S = typename Q::storage_type;
+    constexpr int F = Q::kFracBits;
+    if constexpr (F > 0)
+        acc = (acc + (int64_t{1} << (F - 1))) >> F;
+    constexpr int64_t kMax = std::numeric_limits<S>::max();
+    constexpr int64_t kMin = std::numeric_limits<S>::min();
+    return Q::from_raw(
+        static_cast<S>(acc > kMax ? kMax : (acc < kMin ? kMin : acc)));
+}
+
+}  // namespace Dsp
+
+/**
+ * @brief Dot product with a full-precision accumulator
+ * @details The sum stays in Q(2F) until a single final rounding step.
+ */
+template <FixedPoint Q>
+constexpr Q dot(const QVec3<Q>& a, const QVec3<Q>& b)
+{
+    const int64_t acc = Dsp::mac2(a.x, b.x, a.y, b.y, 0);
+    return Dsp::round_acc<Q>(Dsp::mac2(a.z, b.z, Q{}, Q{}, acc));
+}
+
+/**
+ * @struct QQuaternion
+ * @brief Fixed-point quaternion (w first)
+ */
+template <FixedPoint Q>
+struct QQuaternion
+{
+    Q w, x, y, z;
+
+    constexpr Quaternion to_float() const
+    {
+        return {w.to_float(), x.to_float(), y.to_float(), z.to_float()};
+    }
+
+    static constexpr QQuaternion from_float(const Quaternion& q)
+    {
+        return {Q::from_float(q.w), Q::from_float(q.x), Q::from_float(q.y),
+                Q::from_float(q.z)};
+    }
+};
+
+template <FixedPoint Q>
+constexpr QQuaternion<Q> conjugate(const QQuaternion<Q>& q)
+{
+    return {q.w, -q.x, -q.y, -q.z};
+}
+
+/**
+ * @brief Hamilton product in fixed point
+ * @details Each output lane is a 4-term MAC: two SMLALD instructions for
+ * 16-bit formats and a single rounding per lane.
+ */
+template <FixedPoint Q>
+constexpr QQuaternion<Q> operator*(const QQuaternion<Q>& a,
+                                   const QQuaternion<Q>& b)
+{
+    using Dsp::mac2;
+    using Dsp::round_acc;
+
+    // Negated terms are folded into the operands so every lane is a pure MAC
+    const Q nx = -a.x, ny = -a.y, nz = -a.z;
+    return {round_acc<Q>(mac2(a.w, b.w, nx, b.x, mac2(ny, b.y, nz, b.z, 0))),
+            round_acc<Q>(mac2(a.w, b.x, a.x, b.w, mac2(a.y, b.z, nz, b.y, 0))),
+            round_acc<Q>(mac2(a.w, b.y, nx, b.z, mac2(a.y, b.w, a.z, b.x, 0))),
+            round_acc<Q>(mac2(a.w, b.z, a.x, b.y, mac2(ny, b.x, a.z, b.w, 0)))};
+}
+
+}  // namespace MM
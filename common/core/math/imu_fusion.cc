@@ -0,0 +1,138 @@
+#include "imu_fusion.h"
+
+namespace MM
+{
+
+// Keeps the inverse square roots finite when a vector is exactly zero.
+static constexpr float kNormEps = 1e-12f;
+
+MadgwickFilter::MadgwickFilter(float sample_rate_hz, float beta)
+    : dt_{1.0f / sample_rate_hz}, beta_{beta}, q_{1.0f, 0.0f, 0.0f, 0.0f}
+{
+}
+
+void MadgwickFilter::update(const Vec3& gyro, const Vec3& accel)
+{
+    const float q0 = q_.w, q1 = q_.x, q2 = q_.y, q3 = q_.z;
+
+    // Rate of change of quaternion from gyroscope
+    float qd0 = 0.5f * (-q1 * gyro.x - q2 * gyro.y - q3 * gyro.z);
+    float qd1 = 0.5f * (q0 * gyro.x + q2 * gyro.z - q3 * gyro.y);
+    float qd2 = 0.5f * (q0 * gyro.y - q1 * gyro.z + q3 * gyro.x);
+    float qd3 = 0.5f * (q0 * gyro.z + q1 * gyro.y - q2 * gyro.x);
+
+    // Normalise accel; gate is 0.0f for a zero vector so the correction
+    // below vanishes without branching.
+    const float a_norm2 =
+        accel.x * accel.x + accel.y * accel.y + accel.z * accel.z;
+    const float gate = static_cast<float>(a_norm2 > kNormEps);
+    const float a_inv = Math::inv_sqrt(a_norm2 + kNormEps);
+    const float ax = accel.x * a_inv;
+    const float ay = accel.y * a_inv;
+    const float az = accel.z * a_inv;
+
+    // Gradient descent corrective step (objective: gravity direction)
+    const float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1;
+    const float _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+    const float _4q0 = 4.0f * q0, _4q1 = 4.0f * q1, _4q2 = 4.0f * q2;
+    const float _8q1 = 8.0f * q1, _8q2 = 8.0f * q2;
+    const float q0q0 = q0 * q0, q1q1 = q1 * q1;
+    const float q2q2 = q2 * q2, q3q3 = q3 * q3;
+
+    float s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+    float s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1 +
+               _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+    float s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 +
+               _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+    float s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+
+    const float s_norm2 = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+    const float step = gate * beta_ * Math::inv_sqrt(s_norm2 + kNormEps);
+    qd0 -= step * s0;
+    qd1 -= step * s1;
+    qd2 -= step * s2;
+    qd3 -= step * s3;
+
+    // Integrate and renormalise
+    float w = q0 + qd0 * dt_;
+    float x = q1 + qd1 * dt_;
+    float y = q2 + qd2 * dt_;
+    float z = q3 + qd3 * dt_;
+    const float q_inv = Math::inv_sqrt(w * w + x * x + y * y + z * z);
+    q_ = {w * q_inv, x * q_inv, y * q_inv, z * q_inv};
+}
+
+void MadgwickFilter::reset(const Quaternion& q)
+{
+    q_ = q;
+}
+
+const Quaternion& MadgwickFilter::orientation() const
+{
+    return q_;
+}
+
+MahonyFilter::MahonyFilter(float sample_rate_hz, float kp, float ki)
+    : dt_{1.0f / sample_rate_hz},
+      two_kp_{2.0f * kp},
+      two_ki_{2.0f * ki},
+      q_{1.0f, 0.0f, 0.0f, 0.0f},
+      integral_{0.0f, 0.0f, 0.0f}
+{
+}
+
+void MahonyFilter::update(const Vec3& gyro, const Vec3& accel)
+{
+    const float q0 = q_.w, q1 = q_.x, q2 = q_.y, q3 = q_.z;
+
+    const float a_norm2 =
+        accel.x * accel.x + accel.y * accel.y + accel.z * accel.z;
+    const float gate = static_cast<float>(a_norm2 > kNormEps);
+    const float a_inv = Math::inv_sqrt(a_norm2 + kNormEps);
+    const float ax = accel.x * a_inv;
+    const float ay = accel.y * a_inv;
+    const float az = accel.z * a_inv;
+
+    // Estimated direction of gravity (half magnitude)
+    const float hvx = q1 * q3 - q0 * q2;
+    const float hvy = q0 * q1 + q2 * q3;
+    const float hvz = q0 * q0 - 0.5f + q3 * q3;
+
+    // Error is the cross product between measured and estimated gravity
+    const float hex = gate * (ay * hvz - az * hvy);
+    const float hey = gate * (az * hvx - ax * hvz);
+    const float hez = gate * (ax * hvy - ay * hvx);
+
+    integral_.x += two_ki_ * hex * dt_;
+    integral_.y += two_ki_ * hey * dt_;
+    integral_.z += two_ki_ * hez * dt_;
+
+    const float gx = (gyro.x + two_kp_ * hex + integral_.x) * (0.5f * dt_);
+    const float gy = (gyro.y + two_kp_ * hey + integral_.y) * (0.5f * dt_);
+    const float gz = (gyro.z + two_kp_ * hez + integral_.z) * (0.5f * dt_);
+
+    float w = q0 + (-q1 * gx - q2 * gy - q3 * gz);
+    float x = q1 + (q0 * gx + q2 * gz - q3 * gy);
+    float y = q2 + (q0 * gy - q1 * gz + q3 * gx);
+    float z = q3 + (q0 * gz + q1 * gy - q2 * gx);
+    const float q_inv = Math::inv_sqrt(w * w + x * x + y * y + z * z);
+    q_ = {w * q_inv, x * q_inv, y * q_inv, z * q_inv};
+}
+
+void MahonyFilter::reset(const Quaternion& q)
+{
+    q_ = q;
+    integral_ = {0.0f, 0.0f, 0.0f};
+}
+
+const Quaternion& MahonyFilter::orientation() const
+{
+    return q_;
+}
+
+Vec3 MahonyFilter::gyro_bias() const
+{
+    return {-integral_.x, -integral_.y, -integral_.z};
+}
+
+}  // namespace MM
@@ -0,0 +1,110 @@
+/**
+ * @file imu_fusion.h
+ * @brief Host-side orientation filters on raw gyro + accel data
+ * @author Bex Saw
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "imu_math.h"
+
+namespace MM
+{
+
+/**
+ * @class MadgwickFilter
+ * @brief Madgwick gradient-descent orientation filter (IMU variant)
+ * @details Fixed-step update: the sample period is baked in at
+ * construction so update() is pure single-precision arithmetic with no
+ * data-dependent branches. A zero accel vector disables the correction
+ * through a multiplicative gate instead of an early return.
+ *
+ * Gyro input is in rad/s (Bno055 reports dps, multiply by pi/180).
+ * Accel input may be in any unit; only its direction is used.
+ */
+class MadgwickFilter
+{
+public:
+    /**
+     * @brief Construct a new MadgwickFilter object
+     * @param sample_rate_hz Rate update() is called at (e.g. 500.0f)
+     * @param beta Gradient step gain; ~0.033 for low noise, ~0.1 for fast
+     *        convergence
+     */
+    MadgwickFilter(float sample_rate_hz, float beta);
+
+    /**
+     * @brief Advance the filter by one sample period
+     * @param gyro Angular velocity (rad/s)
+     * @param accel Acceleration (any unit)
+     */
+    void update(const Vec3& gyro, const Vec3& accel);
+
+    /**
+     * @brief Reset the orientation estimate
+     * @param q Initial orientation (unit quaternion)
+     */
+    void reset(const Quaternion& q = {1.0f, 0.0f, 0.0f, 0.0f});
+
+    /**
+     * @brief Current orientation estimate (unit quaternion)
+     */
+    const Quaternion& orientation() const;
+
+private:
+    float dt_;
+    float beta_;
+    Quaternion q_;
+};
+
+/**
+ * @class MahonyFilter
+ * @brief Mahony complementary filter with PI gyro bias correction
+ * @details Cheaper than Madgwick and estimates gyro bias through the
+ * integral term. Same fixed-step, branch-free structure and input units
+ * as MadgwickFilter.
+ */
+class MahonyFilter
+{
+public:
+    /**
+     * @brief Construct a new MahonyFilter object
+     * @param sample_rate_hz Rate update() is called at (e.g. 500.0f)
+     * @param kp Proportional gain (typ. 0.5 - 2.0)
+     * @param ki Integral gain for bias estimation (typ. 0.0 - 0.1)
+     */
+    MahonyFilter(float sample_rate_hz, float kp, float ki);
+
+    /**
+     * @brief Advance the filter by one sample period
+     * @param gyro Angular velocity (rad/s)
+     * @param accel Acceleration (any unit)
+     */
+    void update(const Vec3& gyro, const Vec3& accel);
+
+    /**
+     * @brief Reset the orientation estimate and bias integral
+     * @param q Initial orientation (unit quaternion)
+     */
+    void reset(const Quaternion& q = {1.0f, 0.0f, 0.0f, 0.0f});
+
+    /**
+     * @brief Current orientation estimate (unit quaternion)
+     */
+    const Quaternion& orientation() const;
+
+    /**
+     * @brief Current gyro bias estimate (rad/s), removed from every update
+     */
+    Vec3 gyro_bias() const;
+
+private:
+    float dt_;
+    float two_kp_;
+    float two_ki_;
+    Quaternion q_;
+    Vec3 integral_;
+};
+
+}  // namespace MM
@@ -1,12 +1,19 @@
 /**
  * @file imu_math.h
- * @brief Common math types for IMU and sensor data
+ * @brief Common math types and operations for IMU and sensor data
  * @author Bex Saw
  * @date 2025-12-09
+ * @details Header-only, single precision throughout. Arithmetic is
+ * constexpr; square roots and trig go through the float GCC builtins
+ * (sqrtf, atan2f, ...) so nothing is promoted to double and <cmath> is
+ * not needed. On the Cortex-M4 FPU sqrt maps to VSQRT.F32.
  */
 
 #pragma once
 
+#include <bit>
+#include <cstdint>
+
 namespace MM
 {
 
@@ -20,4 +27,280 @@ struct Quaternion
     float w, x, y, z;
 };
 
+/**
+ * @struct EulerAngles
+ * @brief Aerospace (Z-Y-X) yaw/pitch/roll in radians
+ */
+struct EulerAngles
+{
+    float yaw, pitch, roll;
+};
+
+namespace Math
+{
+
+inline constexpr float kPi = 3.14159265358979f;
+inline constexpr float kDegToRad = kPi / 180.0f;
+inline constexpr float kRadToDeg = 180.0f / kPi;
+
+/**
+ * @brief Fast approximate 1/sqrt(x) (bit trick + Newton iterations)
+ * @details One iteration gives ~0.2% error, two ~5e-6. Usable in constant
+ * expressions. For exact results use inv_sqrt().
+ */
+template <int Iterations = 1>
+constexpr float fast_inv_sqrt(float x)
+{
+    const float half = 0.5f * x;
+    const uint32_t bits = std::bit_cast<uint32_t>(x);
+    float y = std::bit_cast<float>(0x5F375A86u - (bits >> 1));
+    for (int i = 0; i < Iterations; i++)
+    {
+        y = y * (1.5f - half * y * y);
+    }
+    return y;
+}
+
+inline float sqrt(float x)
+{
+    return __builtin_sqrtf(x);
+}
+
+inline float inv_sqrt(float x)
+{
+    return 1.0f / __builtin_sqrtf(x);
+}
+
+/**
+ * @brief Wrap an angle to [-pi, pi)
+ */
+constexpr float wrap_angle(float rad)
+{
+    constexpr float kTwoPi = 2.0f * kPi;
+    const float q = (rad + kPi) / kTwoPi;
+    int32_t turns = static_cast<int32_t>(q);
+    turns -= static_cast<float>(turns) > q;  // floor for negative input
+    return rad - static_cast<float>(turns) * kTwoPi;
+}
+
+}  // namespace Math
+
+// ---------------------------------------------------------------------------
+// Vec3
+// ---------------------------------------------------------------------------
+
+constexpr Vec3 operator+(const Vec3& a, const Vec3& b)
+{
+    return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+constexpr Vec3 operator-(const Vec3& a, const Vec3& b)
+{
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+constexpr Vec3 operator-(const Vec3& a)
+{
+    return {-a.x, -a.y, -a.z};
+}
+
+constexpr Vec3 operator*(const Vec3& a, float s)
+{
+    return {a.x * s, a.y * s, a.z * s};
+}
+
+constexpr Vec3 operator*(float s, const Vec3& a)
+{
+    return a * s;
+}
+
+constexpr Vec3& operator+=(Vec3& a, const Vec3& b)
+{
+    a = a + b;
+    return a;
+}
+
+constexpr Vec3& operator-=(Vec3& a, const Vec3& b)
+{
+    a = a - b;
+    return a;
+}
+
+constexpr Vec3& operator*=(Vec3& a, float s)
+{
+    a = a * s;
+    return a;
+}
+
+constexpr float dot(const Vec3& a, const Vec3& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+constexpr Vec3 cross(const Vec3& a, const Vec3& b)
+{
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+            a.x * b.y - a.y * b.x};
+}
+
+constexpr float norm_squared(const Vec3& a)
+{
+    return dot(a, a);
+}
+
+inline float norm(const Vec3& a)
+{
+    return Math::sqrt(norm_squared(a));
+}
+
+/**
+ * @brief Normalize a vector (exact); zero input yields a zero vector
+ */
+inline Vec3 normalize(const Vec3& a)
+{
+    const float n2 = norm_squared(a);
+    return a * (n2 > 0.0f ? Math::inv_sqrt(n2) : 0.0f);
+}
+
+/**
+ * @brief Normalize a vector with fast_inv_sqrt(); input must be non-zero
+ */
+constexpr Vec3 normalize_fast(const Vec3& a)
+{
+    return a * Math::fast_inv_sqrt<1>(norm_squared(a));
+}
+
+// ---------------------------------------------------------------------------
+// Quaternion (Hamilton convention, w first)
+// ---------------------------------------------------------------------------
+
+inline constexpr Quaternion kIdentityQuat{1.0f, 0.0f, 0.0f, 0.0f};
+
+constexpr Quaternion operator+(const Quaternion& a, const Quaternion& b)
+{
+    return {a.w + b.w, a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+constexpr Quaternion operator*(const Quaternion& q, float s)
+{
+    return {q.w * s, q.x * s, q.y * s, q.z * s};
+}
+
+/**
+ * @brief Hamilton product a * b (apply b, then a)
+ */
+constexpr Quaternion operator*(const Quaternion& a, const Quaternion& b)
+{
+    return {a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+            a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+}
+
+constexpr float dot(const Quaternion& a, const Quaternion& b)
+{
+    return a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+constexpr Quaternion conjugate(const Quaternion& q)
+{
+    return {q.w, -q.x, -q.y, -q.z};
+}
+
+inline Quaternion normalize(const Quaternion& q)
+{
+    const float n2 = dot(q, q);
+    return q * (n2 > 0.0f ? Math::inv_sqrt(n2) : 0.0f);
+}
+
+constexpr Quaternion normalize_fast(const Quaternion& q)
+{
+    return q * Math::fast_inv_sqrt<1>(dot(q, q));
+}
+
+/**
+ * @brief Rotate a vector by a unit quaternion (q * v * q^-1)
+ * @details Uses v' = v + w*t + u x t with u = (x, y, z), t = 2 (u x v):
+ * 15 multiplies instead of the 28 of two full Hamilton products.
+ */
+constexpr Vec3 rotate(const Quaternion& q, const Vec3& v)
+{
+    const Vec3 u{q.x, q.y, q.z};
+    const Vec3 t = cross(u, v) * 2.0f;
+    return v + t * q.w + cross(u, t);
+}
+
+/**
+ * @brief Quaternion from Z-Y-X yaw/pitch/roll (radians)
+ */
+inline Quaternion from_euler(const EulerAngles& e)
+{
+    const float cy = __builtin_cosf(e.yaw * 0.5f);
+    const float sy = __builtin_sinf(e.yaw * 0.5f);
+    const float cp = __builtin_cosf(e.pitch * 0.5f);
+    const float sp = __builtin_sinf(e.pitch * 0.5f);
+    const float cr = __builtin_cosf(e.roll * 0.5f);
+    const float sr = __builtin_sinf(e.roll * 0.5f);
+
+    return {cr * cp * cy + sr * sp * sy, sr * cp * cy - cr * sp * sy,
+            cr * sp * cy + sr * cp * sy, cr * cp * sy - sr * sp * cy};
+}
+
+/**
+ * @brief Z-Y-X yaw/pitch/roll (radians) from a unit quaternion
+ * @details Pitch is clamped to +/-pi/2 at the gimbal-lock singularity.
+ */
+inline EulerAngles to_euler(const Quaternion& q)
+{
+    float sinp = 2.0f * (q.w * q.y - q.z * q.x);
+    sinp = sinp > 1.0f ? 1.0f : (sinp < -1.0f ? -1.0f : sinp);
+
+    return {__builtin_atan2f(2.0f * (q.w * q.z + q.x * q.y),
+                             1.0f - 2.0f * (q.y * q.y + q.z * q.z)),
+            __builtin_asinf(sinp),
+            __builtin_atan2f(2.0f * (q.w * q.x + q.y * q.z),
+                             1.0f - 2.0f * (q.x * q.x + q.y * q.y))};
+}
+
+/**
+ * @brief Heading (yaw) only, radians in [-pi, pi]
+ * @details Cheaper than to_euler() when only the heading is needed, which
+ * is the common case for a ground robot.
+ */
+inline float yaw(const Quaternion& q)
+{
+    return __builtin_atan2f(2.0f * (q.w * q.z + q.x * q.y),
+                            1.0f - 2.0f * (q.y * q.y + q.z * q.z));
+}
+
+/**
+ * @brief Spherical linear interpolation between unit quaternions
+ * @param a Start orientation (t = 0)
+ * @param b End orientation (t = 1)
+ * @param t Interpolation factor in [0, 1]
+ * @details Takes the shortest arc and falls back to normalized lerp when
+ * the inputs are nearly parallel.
+ */
+inline Quaternion slerp(const Quaternion& a, const Quaternion& b, float t)
+{
+    float cos_theta = dot(a, b);
+    Quaternion end = b;
+    if (cos_theta < 0.0f)
+    {
+        cos_theta = -cos_theta;
+        end = b * -1.0f;
+    }
+
+    if (cos_theta > 0.9995f)
+    {
+        return normalize(a * (1.0f - t) + end * t);
+    }
+
+    const float theta = __builtin_acosf(cos_theta);
+    const float inv_sin = 1.0f / __builtin_sinf(theta);
+    const float wa = __builtin_sinf((1.0f - t) * theta) * inv_sin;
+    const float wb = __builtin_sinf(t * theta) * inv_sin;
+    return a * wa + end * wb;
+}
+
 }  // namespace MM
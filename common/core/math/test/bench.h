@@ -0,0 +1,55 @@
+/**
+ * @file bench.h
+ * @brief Minimal host timing helpers for the math tests
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Host numbers only rank implementations against each other;
+ * cycle counts on the M4 come from the DWT counter on target.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace MM
+{
+namespace Bench
+{
+
+/**
+ * @brief Keep the optimizer from discarding or hoisting a result
+ */
+template <typename T>
+inline void keep(T& value)
+{
+    asm volatile("" : "+m"(value) : : "memory");
+}
+
+/**
+ * @brief Average wall time of @p fn over @p iterations calls
+ * @return Nanoseconds per call
+ */
+template <typename Fn>
+double ns_per_call(uint32_t iterations, Fn&& fn)
+{
+    // Warm caches and the branch predictor first
+    for (uint32_t i = 0; i < iterations / 10; i++)
+        fn(i);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++)
+        fn(i);
+    const auto stop = std::chrono::steady_clock::now();
+
+    const std::chrono::duration<double, std::nano> elapsed = stop - start;
+    return elapsed.count() / iterations;
+}
+
+inline void report(const char* name, double ns)
+{
+    std::printf("  %-28s %8.2f ns\n", name, ns);
+}
+
+}  // namespace Bench
+}  // namespace MM
@@ -0,0 +1,223 @@
+/**
+ * @file fixed_point_test.cc
+ * @brief Saturation, rounding and accuracy of the Q-format types, and a
+ * host comparison against the float path
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details On the host the portable fallbacks run, which the header
+ * guarantees to be bit-identical to the DSP instructions. A desktop FPU
+ * beats them, so the host numbers only track regressions; the M4 win
+ * comes from SMLAD/SMLALD doing two MACs per cycle.
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include "bench.h"
+#include "fixed_point.h"
+#include "imu_math.h"
+
+namespace MM
+{
+namespace
+{
+
+// Constant evaluation always takes the portable path
+static_assert(Dsp::ssat<16>(40000) == 32767);
+static_assert(Dsp::qadd(INT32_MAX, 1) == INT32_MAX);
+static_assert((Q15::from_float(0.5f) * Q15::from_float(0.5f)).raw() == 8192);
+
+TEST(FixedPointTest, SaturatingAddSub)
+{
+    EXPECT_EQ(Dsp::qadd(INT32_MAX, 5), INT32_MAX);
+    EXPECT_EQ(Dsp::qsub(INT32_MIN, 5), INT32_MIN);
+    EXPECT_EQ(Dsp::ssat<12>(-5000), -2048);
+    EXPECT_EQ(Dsp::ssat<12>(100), 100);
+
+    EXPECT_EQ(Q15::max() + Q15::from_float(0.25f), Q15::max());
+    EXPECT_EQ(Q15::min() - Q15::from_float(0.25f), Q15::min());
+    EXPECT_EQ(Q31::max() + Q31::max(), Q31::max());
+
+    // -(-1) does not fit in Q15; it saturates instead of wrapping
+    EXPECT_EQ(-Q15::min(), Q15::max());
+}
+
+TEST(FixedPointTest, MultiplyRoundsAndSaturates)
+{
+    // -1 * -1 is the only Q15 product out of range
+    EXPECT_EQ(Q15::min() * Q15::min(), Q15::max());
+    EXPECT_EQ(Q31::min() * Q31::min(), Q31::max());
+
+    // 1 LSB * 0.5 rounds to nearest: half an LSB rounds up
+    const Q15 lsb = Q15::from_raw(1);
+    EXPECT_EQ((lsb * Q15::from_float(0.5f)).raw(), 1);
+    EXPECT_EQ((Q16_16::from_int(3) * Q16_16::from_float(1.5f)).to_float(),
+              4.5f);
+    EXPECT_EQ((Q16_16::from_int(30000) * 3).raw(), INT32_MAX);
+}
+
+TEST(FixedPointTest, FloatConversion)
+{
+    EXPECT_EQ(Q15::from_float(2.0f), Q15::max());
+    EXPECT_EQ(Q15::from_float(-2.0f), Q15::min());
+    EXPECT_EQ(Q14::from_float(1.0f).raw(), 16384);
+    EXPECT_EQ(Q4::from_raw(-40).to_float(), -2.5f);
+
+    // Round trip is good to half an LSB
+    for (float f = -0.99f; f < 0.99f; f += 0.0137f)
+    {
+        EXPECT_NEAR(Q15::from_float(f).to_float(), f, 0.5f / 32768.0f);
+        EXPECT_NEAR(Q31::from_float(f).to_float(), f, 1e-7f);
+    }
+}
+
+TEST(FixedPointTest, RescaleBetweenFormats)
+{
+    // BNO055 quaternion unit (Q14) to Q15 and back
+    const Q14 half = Q14::from_float(0.5f);
+    EXPECT_EQ(Q15::from(half).raw(), 16384);
+    EXPECT_EQ(Q14::from(Q15::from(half)), half);
+
+    // Q4 gyro in dps to Q16.16
+    EXPECT_EQ(Q16_16::from(Q4::from_raw(-24)).to_float(), -1.5f);
+
+    // Narrowing rounds to nearest and saturates
+    EXPECT_EQ(Q4::from(Q16_16::from_float(0.03125f)).raw(), 1);
+    EXPECT_EQ(Q15::from(Q16_16::from_int(3)), Q15::max());
+}
+
+TEST(FixedPointTest, Smlad)
+{
+    const uint32_t x = Dsp::pack16x2(1000, -2000);
+    const uint32_t y = Dsp::pack16x2(3, 4);
+    EXPECT_EQ(Dsp::smlad(x, y, 10), 10 + 3000 - 8000);
+    EXPECT_EQ(Dsp::smlald(x, y, int64_t{1} << 40),
+              (int64_t{1} << 40) + 3000 - 8000);
+}
+
+/**
+ * @brief Deterministic inputs in (-0.5, 0.5), so products stay in range
+ */
+struct Inputs
+{
+    static constexpr size_t kCount = 256;
+
+    Inputs()
+    {
+        uint32_t seed = 7;
+        auto next = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<float>(seed >> 8) / 16777216.0f - 0.5f;
+        };
+        for (size_t i = 0; i < kCount; i++)
+        {
+            fvec[i] = {next(), next(), next()};
+            fquat[i] = normalize(Quaternion{next(), next(), next(), next()});
+            qvec[i] = QVec3<Q15>::from_float(fvec[i]);
+            q14quat[i] = QQuaternion<Q14>::from_float(fquat[i]);
+            q15quat[i] = QQuaternion<Q15>::from_float(fquat[i] * 0.999f);
+        }
+    }
+
+    std::array<Vec3, kCount> fvec{};
+    std::array<Quaternion, kCount> fquat{};
+    std::array<QVec3<Q15>, kCount> qvec{};
+    std::array<QQuaternion<Q14>, kCount> q14quat{};
+    std::array<QQuaternion<Q15>, kCount> q15quat{};
+};
+
+TEST(FixedPointTest, DotMatchesFloat)
+{
+    const Inputs in;
+    for (size_t i = 0; i + 1 < Inputs::kCount; i++)
+    {
+        const float expected = dot(in.qvec[i].to_float(),
+                                   in.qvec[i + 1].to_float());
+        // One rounding step for the whole sum
+        EXPECT_NEAR(dot(in.qvec[i], in.qvec[i + 1]).to_float(), expected,
+                    0.5f / 32768.0f + 1e-7f);
+    }
+}
+
+TEST(FixedPointTest, QuaternionProductMatchesFloat)
+{
+    const Inputs in;
+    for (size_t i = 0; i + 1 < Inputs::kCount; i++)
+    {
+        const Quaternion a = in.q14quat[i].to_float();
+        const Quaternion b = in.q14quat[i + 1].to_float();
+        const Quaternion f = a * b;
+        const Quaternion q = (in.q14quat[i] * in.q14quat[i + 1]).to_float();
+        constexpr float kLsb = 1.0f / 16384.0f;
+        EXPECT_NEAR(q.w, f.w, kLsb);
+        EXPECT_NEAR(q.x, f.x, kLsb);
+        EXPECT_NEAR(q.y, f.y, kLsb);
+        EXPECT_NEAR(q.z, f.z, kLsb);
+    }
+
+    // The conjugate product of a unit quaternion is the identity
+    const auto p = in.q14quat[3] * conjugate(in.q14quat[3]);
+    EXPECT_NEAR(p.w.to_float(), 1.0f, 3.0f / 16384.0f);
+    EXPECT_NEAR(p.z.to_float(), 0.0f, 1.0f / 16384.0f);
+}
+
+TEST(FixedPointBench, FixedVsFloat)
+{
+    const Inputs in;
+    constexpr uint32_t kIterations = 2000000;
+    constexpr size_t kMask = Inputs::kCount - 1;
+
+    std::printf("fixed point vs float, host:\n");
+    auto run = [&](const char* name, auto&& fn) {
+        const double ns = Bench::ns_per_call(kIterations, fn);
+        Bench::report(name, ns);
+        RecordProperty(name, static_cast<int>(ns * 1000.0));
+    };
+
+    run("dot float", [&](uint32_t i) {
+        float r = dot(in.fvec[i & kMask], in.fvec[(i + 1) & kMask]);
+        Bench::keep(r);
+    });
+    run("dot Q15", [&](uint32_t i) {
+        Q15 r = dot(in.qvec[i & kMask], in.qvec[(i + 1) & kMask]);
+        Bench::keep(r);
+    });
+    run("quat * quat float", [&](uint32_t i) {
+        Quaternion r = in.fquat[i & kMask] * in.fquat[(i + 1) & kMask];
+        Bench::keep(r);
+    });
+    run("quat * quat Q15", [&](uint32_t i) {
+        QQuaternion<Q15> r =
+            in.q15quat[i & kMask] * in.q15quat[(i + 1) & kMask];
+        Bench::keep(r);
+    });
+    run("quat * quat Q14", [&](uint32_t i) {
+        QQuaternion<Q14> r =
+            in.q14quat[i & kMask] * in.q14quat[(i + 1) & kMask];
+        Bench::keep(r);
+    });
+
+    // 16-tap FIR: the SMLAD loop the fixed path exists for
+    constexpr size_t kTaps = 16;
+    run("16-tap FIR float", [&](uint32_t i) {
+        float acc = 0.0f;
+        for (size_t k = 0; k < kTaps; k++)
+            acc += in.fvec[(i + k) & kMask].x * in.fvec[k].y;
+        Bench::keep(acc);
+    });
+    run("16-tap FIR Q15 smlad", [&](uint32_t i) {
+        int32_t acc = 0;
+        for (size_t k = 0; k < kTaps; k += 2)
+        {
+            acc = Dsp::smlad(
+                Dsp::pack16x2(in.qvec[(i + k) & kMask].x.raw(),
+                              in.qvec[(i + k + 1) & kMask].x.raw()),
+                Dsp::pack16x2(in.qvec[k].y.raw(), in.qvec[k + 1].y.raw()),
+                acc);
+        }
+        Bench::keep(acc);
+    });
+}
+
+}  // namespace
+}  // namespace MM
@@ -0,0 +1,247 @@
+/**
+ * @file imu_math_test.cc
+ * @brief Correctness and host micro-benchmarks for imu_math.h
+ * @author Bex Saw
+ * @date 2026-10-18
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include "bench.h"
+#include "imu_math.h"
+
+namespace MM
+{
+namespace
+{
+
+constexpr float kEps = 1e-5f;
+
+// The library is meant to be usable in constant expressions
+static_assert(dot(cross(Vec3{1, 0, 0}, Vec3{0, 1, 0}), Vec3{0, 0, 1}) == 1);
+static_assert((kIdentityQuat * kIdentityQuat).w == 1.0f);
+static_assert(Math::wrap_angle(3.0f * Math::kPi) < Math::kPi);
+
+void expect_near(const Vec3& a, const Vec3& b, float eps = kEps)
+{
+    EXPECT_NEAR(a.x, b.x, eps);
+    EXPECT_NEAR(a.y, b.y, eps);
+    EXPECT_NEAR(a.z, b.z, eps);
+}
+
+/**
+ * @brief q and -q are the same rotation
+ */
+void expect_same_rotation(const Quaternion& a, const Quaternion& b,
+                          float eps = kEps)
+{
+    EXPECT_NEAR(__builtin_fabsf(dot(a, b)), 1.0f, eps);
+}
+
+/**
+ * @brief Fixed set of unit quaternions and vectors for the benchmarks
+ */
+struct Inputs
+{
+    static constexpr size_t kCount = 256;
+
+    Inputs()
+    {
+        uint32_t seed = 1;
+        auto next = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+        };
+        for (size_t i = 0; i < kCount; i++)
+        {
+            vecs[i] = {next(), next(), next()};
+            quats[i] = normalize(Quaternion{next(), next(), next(), next()});
+        }
+    }
+
+    std::array<Vec3, kCount> vecs{};
+    std::array<Quaternion, kCount> quats{};
+};
+
+TEST(ImuMathTest, VectorOps)
+{
+    const Vec3 a{1.0f, 2.0f, 3.0f};
+    const Vec3 b{-4.0f, 0.5f, 2.0f};
+    expect_near(a + b, {-3.0f, 2.5f, 5.0f});
+    expect_near(a - b, {5.0f, 1.5f, 1.0f});
+    expect_near(2.0f * a, {2.0f, 4.0f, 6.0f});
+    EXPECT_NEAR(dot(a, b), 3.0f, kEps);
+
+    // a x b is orthogonal to both
+    const Vec3 c = cross(a, b);
+    EXPECT_NEAR(dot(c, a), 0.0f, kEps);
+    EXPECT_NEAR(dot(c, b), 0.0f, kEps);
+    EXPECT_NEAR(norm(Vec3{3.0f, 4.0f, 0.0f}), 5.0f, kEps);
+}
+
+TEST(ImuMathTest, NormalizeExactAndFast)
+{
+    const Vec3 v{3.0f, -4.0f, 12.0f};
+    EXPECT_NEAR(norm(normalize(v)), 1.0f, 1e-6f);
+    // One Newton step is good to about 0.2%
+    EXPECT_NEAR(norm(normalize_fast(v)), 1.0f, 2e-3f);
+
+    const Vec3 zero = normalize(Vec3{0.0f, 0.0f, 0.0f});
+    EXPECT_EQ(zero.x, 0.0f);
+    EXPECT_EQ(zero.y, 0.0f);
+    EXPECT_EQ(zero.z, 0.0f);
+}
+
+TEST(ImuMathTest, FastInvSqrtError)
+{
+    float worst1 = 0.0f;
+    float worst2 = 0.0f;
+    for (float x = 1e-3f; x < 1e3f; x *= 1.01f)
+    {
+        const float exact = Math::inv_sqrt(x);
+        const float e1 = __builtin_fabsf(Math::fast_inv_sqrt<1>(x) / exact - 1);
+        const float e2 = __builtin_fabsf(Math::fast_inv_sqrt<2>(x) / exact - 1);
+        worst1 = e1 > worst1 ? e1 : worst1;
+        worst2 = e2 > worst2 ? e2 : worst2;
+    }
+    EXPECT_LT(worst1, 2e-3f);
+    EXPECT_LT(worst2, 1e-5f);
+}
+
+TEST(ImuMathTest, RotateMatchesHamiltonSandwich)
+{
+    const Inputs in;
+    for (size_t i = 0; i < Inputs::kCount; i++)
+    {
+        const Quaternion& q = in.quats[i];
+        const Vec3& v = in.vecs[i];
+        const Quaternion p = q * Quaternion{0.0f, v.x, v.y, v.z} *
+                             conjugate(q);
+        expect_near(rotate(q, v), {p.x, p.y, p.z});
+        EXPECT_NEAR(norm(rotate(q, v)), norm(v), kEps);
+    }
+}
+
+TEST(ImuMathTest, YawQuarterTurn)
+{
+    const Quaternion q = from_euler({0.5f * Math::kPi, 0.0f, 0.0f});
+    expect_near(rotate(q, {1.0f, 0.0f, 0.0f}), {0.0f, 1.0f, 0.0f});
+    EXPECT_NEAR(yaw(q), 0.5f * Math::kPi, kEps);
+}
+
+TEST(ImuMathTest, EulerRoundTrip)
+{
+    for (float yaw_deg = -170.0f; yaw_deg <= 170.0f; yaw_deg += 34.0f)
+    {
+        for (float pitch_deg = -80.0f; pitch_deg <= 80.0f; pitch_deg += 20.0f)
+        {
+            const EulerAngles e{yaw_deg * Math::kDegToRad,
+                                pitch_deg * Math::kDegToRad,
+                                0.3f * yaw_deg * Math::kDegToRad};
+            const EulerAngles back = to_euler(from_euler(e));
+            EXPECT_NEAR(back.yaw, e.yaw, 1e-4f);
+            EXPECT_NEAR(back.pitch, e.pitch, 1e-4f);
+            EXPECT_NEAR(back.roll, e.roll, 1e-4f);
+            EXPECT_NEAR(yaw(from_euler(e)), e.yaw, 1e-4f);
+        }
+    }
+}
+
+TEST(ImuMathTest, GimbalLockPitchIsClamped)
+{
+    const Quaternion q = from_euler({0.0f, 0.5f * Math::kPi, 0.0f});
+    // Rounding may push sin(pitch) just past 1; asin must not go NaN
+    const EulerAngles e = to_euler(q * 1.0001f);
+    EXPECT_NEAR(e.pitch, 0.5f * Math::kPi, 1e-3f);
+}
+
+TEST(ImuMathTest, SlerpEndpointsAndMidpoint)
+{
+    const Quaternion a = from_euler({0.0f, 0.0f, 0.0f});
+    const Quaternion b = from_euler({1.0f, 0.0f, 0.0f});
+    expect_same_rotation(slerp(a, b, 0.0f), a);
+    expect_same_rotation(slerp(a, b, 1.0f), b);
+    EXPECT_NEAR(yaw(slerp(a, b, 0.25f)), 0.25f, kEps);
+
+    // Shortest arc: -b is the same rotation as b
+    EXPECT_NEAR(yaw(slerp(a, b * -1.0f, 0.5f)), 0.5f, kEps);
+
+    // Nearly parallel inputs take the nlerp path
+    const Quaternion c = from_euler({1e-3f, 0.0f, 0.0f});
+    EXPECT_NEAR(yaw(slerp(a, c, 0.5f)), 0.5e-3f, 1e-6f);
+}
+
+TEST(ImuMathTest, WrapAngle)
+{
+    EXPECT_NEAR(Math::wrap_angle(0.0f), 0.0f, kEps);
+    EXPECT_NEAR(Math::wrap_angle(1.5f * Math::kPi), -0.5f * Math::kPi, kEps);
+    EXPECT_NEAR(Math::wrap_angle(-1.5f * Math::kPi), 0.5f * Math::kPi, kEps);
+    EXPECT_NEAR(Math::wrap_angle(7.0f * Math::kPi), -Math::kPi, kEps);
+    EXPECT_NEAR(Math::wrap_angle(-0.25f), -0.25f, kEps);
+}
+
+TEST(ImuMathBench, MicroBenchmarks)
+{
+    const Inputs in;
+    constexpr uint32_t kIterations = 2000000;
+    constexpr size_t kMask = Inputs::kCount - 1;
+    static_assert((Inputs::kCount & kMask) == 0);
+
+    std::printf("imu_math, host:\n");
+    auto run = [&](const char* name, auto&& fn) {
+        const double ns = Bench::ns_per_call(kIterations, fn);
+        Bench::report(name, ns);
+        RecordProperty(name, static_cast<int>(ns * 1000.0));
+    };
+
+    run("inv_sqrt", [&](uint32_t i) {
+        float r = Math::inv_sqrt(in.vecs[i & kMask].x + 2.0f);
+        Bench::keep(r);
+    });
+    run("fast_inv_sqrt<1>", [&](uint32_t i) {
+        float r = Math::fast_inv_sqrt<1>(in.vecs[i & kMask].x + 2.0f);
+        Bench::keep(r);
+    });
+    run("normalize(Vec3)", [&](uint32_t i) {
+        Vec3 r = normalize(in.vecs[i & kMask]);
+        Bench::keep(r);
+    });
+    run("normalize_fast(Vec3)", [&](uint32_t i) {
+        Vec3 r = normalize_fast(in.vecs[i & kMask]);
+        Bench::keep(r);
+    });
+    run("cross", [&](uint32_t i) {
+        Vec3 r = cross(in.vecs[i & kMask], in.vecs[(i + 1) & kMask]);
+        Bench::keep(r);
+    });
+    run("Quaternion * Quaternion", [&](uint32_t i) {
+        Quaternion r = in.quats[i & kMask] * in.quats[(i + 1) & kMask];
+        Bench::keep(r);
+    });
+    run("rotate", [&](uint32_t i) {
+        Vec3 r = rotate(in.quats[i & kMask], in.vecs[i & kMask]);
+        Bench::keep(r);
+    });
+    run("from_euler", [&](uint32_t i) {
+        const Vec3& v = in.vecs[i & kMask];
+        Quaternion r = from_euler({v.x, v.y, v.z});
+        Bench::keep(r);
+    });
+    run("to_euler", [&](uint32_t i) {
+        EulerAngles r = to_euler(in.quats[i & kMask]);
+        Bench::keep(r);
+    });
+    run("yaw", [&](uint32_t i) {
+        float r = yaw(in.quats[i & kMask]);
+        Bench::keep(r);
+    });
+    run("slerp", [&](uint32_t i) {
+        Quaternion r =
+            slerp(in.quats[i & kMask], in.quats[(i + 1) & kMask], 0.3f);
+        Bench::keep(r);
+    });
+}
+
+}  // namespace
+}  // namespace MM
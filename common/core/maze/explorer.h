@@ -0,0 +1,340 @@
+/**
+ * @file explorer.h
+ * @brief Search-run exploration policies over flood fill and the planner
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details The explorer decides where the mouse goes next during the
+ * search run. After each move the caller writes the sensed walls into the
+ * maze, reports them with wall_added() or refresh(), and calls next().
+ *
+ * Every policy first drives to the goal. What happens after that is where
+ * search time is won or lost:
+ * - GREEDY drives straight back to the start.
+ * - RETURN_VIA_UNKNOWN drives back to the start, but detours through
+ *   unexplored cells of the candidate speed-run path when the detour costs
+ *   at most max_detour extra cells.
+ * - FULL_COVERAGE visits every unexplored cell of the candidate path until
+ *   the optimal path is proven, then drives back.
+ *
+ * The candidate path is the speed-run plan with unknown walls treated as
+ * open. That plan is a lower bound on the real best run. The path is
+ * proven optimal once every cell on it is fully known, because the
+ * known-only plan then costs the same. Only cells on the candidate path
+ * are worth a visit; the rest of the maze cannot improve the speed run.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "flood_fill.h"
+#include "maze.h"
+#include "path_planner.h"
+#include "ring_queue.h"
+
+namespace MM
+{
+
+enum class ExplorePolicy : uint8_t
+{
+    GREEDY = 0,
+    RETURN_VIA_UNKNOWN,
+    FULL_COVERAGE
+};
+
+enum class ExplorePhase : uint8_t
+{
+    TO_GOAL = 0,
+    EXPLORE,  ///< FULL_COVERAGE only: proving the optimal path
+    RETURN,
+    DONE,     ///< Back at the start
+    STUCK     ///< No open route to the current target; see refresh()
+};
+
+struct ExploreConfig
+{
+    ExplorePolicy policy = ExplorePolicy::FULL_COVERAGE;
+    uint8_t max_detour = 4;  ///< RETURN_VIA_UNKNOWN: extra cells allowed
+    Cell home{0, 0};
+    Direction home_heading = Direction::NORTH;  ///< Speed-run start heading
+};
+
+template <uint8_t W, uint8_t H>
+class Explorer
+{
+public:
+    using MazeType = Maze<W, H>;
+    using Planner = PathPlanner<W, H>;
+
+    static constexpr size_t kCells = MazeType::kCells;
+    static constexpr uint16_t kUnreached = static_cast<uint16_t>(kCells);
+
+    /**
+     * @param planner_ Shared with the speed run; the explorer overwrites
+     *        its last plan
+     */
+    explicit Explorer(Planner& planner_) : planner(planner_)
+    {
+    }
+
+    /**
+     * @brief Start a search run from the home cell
+     * @param goals_ Must outlive the run
+     * @return false if the goal list is invalid
+     */
+    bool start(const MazeType& maze, std::span<const Cell> goals_,
+               const ExploreConfig& config_)
+    {
+        const Cell home[] = {config_.home};
+        if (!to_goal.set_goals(goals_) || !to_home.set_goals(home))
+            return false;
+        config = config_;
+        goals = goals_;
+        explore_phase = ExplorePhase::TO_GOAL;
+        refresh(maze);
+        return true;
+    }
+
+    /**
+     * @brief Report a wall that was just added to @p maze
+     */
+    void wall_added(const MazeType& maze, Cell c, Direction d)
+    {
+        to_goal.wall_added(maze, c, d);
+        to_home.wall_added(maze, c, d);
+        replan = true;
+    }
+
+    /**
+     * @brief Recompute after walls were removed (e.g. a misread undone)
+     * @details Also resumes a STUCK run, since removing walls may have
+     * reopened the way.
+     */
+    void refresh(const MazeType& maze)
+    {
+        to_goal.flood(maze);
+        to_home.flood(maze);
+        replan = true;
+        if (explore_phase == ExplorePhase::STUCK)
+            explore_phase = stuck_in;
+    }
+
+    /**
+     * @brief Direction to drive from @p at
+     * @return false when the run is over; see phase() for why
+     */
+    bool next(const MazeType& maze, Cell at, Direction heading,
+              Direction& out)
+    {
+        if (explore_phase == ExplorePhase::TO_GOAL)
+        {
+            if (!to_goal.is_goal(at))
+                return follow(to_goal, maze, at, heading, out);
+            explore_phase = config.policy == ExplorePolicy::FULL_COVERAGE
+                                ? ExplorePhase::EXPLORE
+                                : ExplorePhase::RETURN;
+        }
+
+        if (explore_phase == ExplorePhase::EXPLORE)
+        {
+            if (find_candidates(maze, at) > 0 &&
+                towards_candidates(maze, at, heading, out))
+                return true;
+            explore_phase = ExplorePhase::RETURN;
+        }
+
+        if (explore_phase == ExplorePhase::RETURN)
+        {
+            if (at == config.home)
+            {
+                explore_phase = ExplorePhase::DONE;
+                return false;
+            }
+            if (config.policy == ExplorePolicy::RETURN_VIA_UNKNOWN &&
+                find_candidates(maze, at) > 0 &&
+                keep_detours(maze, at) > 0 &&
+                towards_candidates(maze, at, heading, out))
+                return true;
+            return follow(to_home, maze, at, heading, out);
+        }
+        return false;
+    }
+
+    /**
+     * @brief Whether the known maze already holds the best speed run
+     * @details Plans twice, once with unknown walls open and once with
+     * known walls only. Each plan is a full search, so call this once per
+     * cell at most.
+     */
+    bool optimal_proven(const MazeType& maze)
+    {
+        if (!planner.plan(maze, config.home, config.home_heading, goals,
+                          false))
+            return false;
+        const uint32_t bound = planner.plan_time_us();
+        return planner.plan(maze, config.home, config.home_heading, goals,
+                            true) &&
+               planner.plan_time_us() == bound;
+    }
+
+    ExplorePhase phase() const
+    {
+        return explore_phase;
+    }
+
+    const FloodFill<W, H>& goal_flood() const
+    {
+        return to_goal;
+    }
+
+private:
+    bool follow(const FloodFill<W, H>& flood, const MazeType& maze, Cell at,
+                Direction heading, Direction& out)
+    {
+        if (flood.best_direction(maze, at, heading, out))
+            return true;
+        stuck_in = explore_phase;
+        explore_phase = ExplorePhase::STUCK;
+        return false;
+    }
+
+    /**
+     * @brief Mark unexplored cells on the optimistic speed-run path
+     * @details Sensing open sides never changes the optimistic plan, so it
+     * is only recomputed after a wall was added or the maze refreshed.
+     * @return Number of candidate cells, excluding @p at
+     */
+    size_t find_candidates(const MazeType& maze, Cell at)
+    {
+        if (replan)
+        {
+            path_length = 0;
+            if (planner.plan(maze, config.home, config.home_heading, goals,
+                             false))
+                path_length = planner.cells(path);
+            replan = false;
+        }
+
+        candidate.fill(false);
+        size_t count = 0;
+        for (size_t i = 0; i < path_length; i++)
+        {
+            const Cell c = path[i];
+            const size_t index = MazeType::index(c);
+            if (maze.known(c) != 0x0F && !(c == at) && !candidate[index])
+            {
+                candidate[index] = true;
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Drop candidates that lengthen the way home by too much
+     * @return Number of candidates left
+     */
+    size_t keep_detours(const MazeType& maze, Cell at)
+    {
+        reach.fill(kUnreached);
+        reach[MazeType::index(at)] = 0;
+        bfs(maze);
+
+        const uint32_t budget =
+            static_cast<uint32_t>(to_home.distance(at)) + config.max_detour;
+        size_t count = 0;
+        for (size_t i = 0; i < kCells; i++)
+        {
+            if (!candidate[i])
+                continue;
+            const Cell c = MazeType::cell(i);
+            candidate[i] = reach[i] != kUnreached &&
+                           static_cast<uint32_t>(reach[i]) +
+                                   to_home.distance(c) <=
+                               budget;
+            count += candidate[i];
+        }
+        return count;
+    }
+
+    /**
+     * @brief Step towards the nearest candidate cell
+     */
+    bool towards_candidates(const MazeType& maze, Cell at, Direction heading,
+                            Direction& out)
+    {
+        reach.fill(kUnreached);
+        for (size_t i = 0; i < kCells; i++)
+        {
+            if (candidate[i])
+                reach[i] = 0;
+        }
+        bfs(maze);
+
+        // Downhill on the candidate distance map, straight ahead on a tie
+        uint16_t best = reach[MazeType::index(at)];
+        bool found = false;
+        for (uint8_t k = 0; k < kNumDirections; k++)
+        {
+            const auto d =
+                static_cast<Direction>((Dir::index(heading) + k) & 3u);
+            Cell n;
+            if (!maze.is_open(at, d) || !MazeType::neighbour(at, d, n))
+                continue;
+            if (reach[MazeType::index(n)] < best)
+            {
+                best = reach[MazeType::index(n)];
+                out = d;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @brief Breadth-first search outward from every cell at distance 0
+     */
+    void bfs(const MazeType& maze)
+    {
+        queue.clear();
+        for (size_t i = 0; i < kCells; i++)
+        {
+            if (reach[i] == 0)
+                queue.push(MazeType::cell(i));
+        }
+        Cell c;
+        while (queue.pop(c))
+        {
+            const uint16_t next = reach[MazeType::index(c)] + 1;
+            for (Direction d : Dir::kAll)
+            {
+                Cell n;
+                if (!maze.is_open(c, d) || !MazeType::neighbour(c, d, n))
+                    continue;
+                uint16_t& nd = reach[MazeType::index(n)];
+                if (nd == kUnreached)
+                {
+                    nd = next;
+                    queue.push(n);
+                }
+            }
+        }
+    }
+
+    Planner& planner;
+    ExploreConfig config;
+    std::span<const Cell> goals;
+    ExplorePhase explore_phase = ExplorePhase::DONE;
+    ExplorePhase stuck_in = ExplorePhase::DONE;
+    FloodFill<W, H> to_goal;
+    FloodFill<W, H> to_home;
+    std::array<bool, kCells> candidate{};
+    std::array<uint16_t, kCells> reach{};
+    std::array<Cell, 2 * kCells> path{};
+    size_t path_length = 0;
+    bool replan = true;
+    Utils::RingQueue<Cell, kCells> queue;
+};
+
+}  // namespace MM
@@ -0,0 +1,262 @@
+/**
+ * @file flood_fill.h
+ * @brief BFS distance-to-goal solver with incremental wall updates
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details flood() runs a full breadth-first search outward from the goal
+ * cells. Unknown walls count as open, so distances are optimistic and
+ * guide exploration.
+ *
+ * Newly found walls can only lengthen paths. wall_added() therefore only
+ * re-checks the two cells beside the new wall. A cell whose distance no
+ * longer equals 1 + its best open neighbour is corrected, and its
+ * neighbours are queued in turn. The work grows with the region whose
+ * distances actually change, not with the maze size. Cells cut off from
+ * every goal climb to kUnreached. Once an update has processed as many
+ * cells as a full flood would, it falls back to one, which bounds the
+ * worst case at about twice a full flood. Removing a known wall can
+ * shorten paths and needs a full flood().
+ *
+ * Both paths use a static ring queue; there is no heap use.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "maze.h"
+#include "ring_queue.h"
+#include "timebase.h"
+
+namespace MM
+{
+
+template <uint8_t W, uint8_t H>
+class FloodFill
+{
+public:
+    using MazeType = Maze<W, H>;
+
+    static constexpr size_t kCells = MazeType::kCells;
+    static constexpr uint16_t kUnreached = static_cast<uint16_t>(kCells);
+    static constexpr size_t kMaxGoals = 8;
+
+    struct Stats
+    {
+        uint32_t last_cells;   ///< Cells processed by the latest update
+        uint32_t max_cells;
+        uint32_t last_cycles;  ///< Core cycles of the latest update
+        uint32_t max_cycles;
+    };
+
+    /**
+     * @return false if there are no goals or more than kMaxGoals
+     */
+    bool set_goals(std::span<const Cell> goals_)
+    {
+        if (goals_.empty() || goals_.size() > kMaxGoals)
+            return false;
+        num_goals = 0;
+        for (Cell g : goals_)
+            goals[num_goals++] = g;
+        return true;
+    }
+
+    /**
+     * @brief Recompute every distance from scratch
+     */
+    void flood(const MazeType& maze)
+    {
+        const uint32_t begin = Utils::now_cycles();
+        const uint32_t processed = bfs(maze);
+        record(processed, Utils::now_cycles() - begin);
+    }
+
+    /**
+     * @brief Repair distances after a wall was added at (c, d)
+     * @details Call after Maze::set_wall(c, d, true). Several new walls
+     * from one sensor reading can be seeded first with seed_wall() and
+     * resolved with a single propagate().
+     */
+    void wall_added(const MazeType& maze, Cell c, Direction d)
+    {
+        seed_wall(c, d);
+        propagate(maze);
+    }
+
+    /**
+     * @brief Queue both cells beside a new wall without propagating yet
+     */
+    void seed_wall(Cell c, Direction d)
+    {
+        seed(c);
+        Cell n;
+        if (MazeType::neighbour(c, d, n))
+            seed(n);
+    }
+
+    /**
+     * @brief Settle every cell queued by seed_wall()
+     */
+    void propagate(const MazeType& maze)
+    {
+        const uint32_t begin = Utils::now_cycles();
+        uint32_t processed = 0;
+        Cell c;
+        while (queue.pop(c))
+        {
+            // A change this large costs more than starting over
+            if (processed >= kCells)
+            {
+                processed += bfs(maze);
+                break;
+            }
+
+            const size_t i = MazeType::index(c);
+            queued[i / 8] &= static_cast<uint8_t>(~(1u << (i % 8)));
+            processed++;
+            if (is_goal(c))
+                continue;
+
+            uint16_t best = kUnreached;
+            for (Direction d : Dir::kAll)
+            {
+                Cell n;
+                if (maze.is_open(c, d) && MazeType::neighbour(c, d, n) &&
+                    dist[MazeType::index(n)] < best)
+                    best = dist[MazeType::index(n)];
+            }
+            uint16_t want = kUnreached;
+            if (best != kUnreached)
+                want = static_cast<uint16_t>(best + 1);
+            if (dist[i] == want)
+                continue;
+
+            dist[i] = want;
+            for (Direction d : Dir::kAll)
+            {
+                Cell n;
+                if (maze.is_open(c, d) && MazeType::neighbour(c, d, n))
+                    seed(n);
+            }
+        }
+        record(processed, Utils::now_cycles() - begin);
+    }
+
+    uint16_t distance(Cell c) const
+    {
+        return dist[MazeType::index(c)];
+    }
+
+    bool is_goal(Cell c) const
+    {
+        for (size_t i = 0; i < num_goals; i++)
+        {
+            if (goals[i] == c)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Open direction towards the lowest neighbouring distance
+     * @param preferred Taken on a tie (usually straight ahead)
+     * @return false if no neighbour is closer to a goal
+     */
+    bool best_direction(const MazeType& maze, Cell c, Direction preferred,
+                        Direction& out) const
+    {
+        uint16_t best = distance(c);
+        bool found = false;
+        // Check the preferred heading first so it wins ties
+        for (uint8_t k = 0; k < kNumDirections; k++)
+        {
+            const auto d = static_cast<Direction>((Dir::index(preferred) + k) &
+                                                  3u);
+            Cell n;
+            if (!maze.is_open(c, d) || !MazeType::neighbour(c, d, n))
+                continue;
+            if (distance(n) < best)
+            {
+                best = distance(n);
+                out = d;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    const Stats& stats() const
+    {
+        return update_stats;
+    }
+
+    void reset_stats()
+    {
+        update_stats = {};
+    }
+
+private:
+    uint32_t bfs(const MazeType& maze)
+    {
+        dist.fill(kUnreached);
+        queued.fill(0);
+        queue.clear();
+        for (size_t i = 0; i < num_goals; i++)
+        {
+            dist[MazeType::index(goals[i])] = 0;
+            queue.push(goals[i]);
+        }
+
+        uint32_t processed = 0;
+        Cell c;
+        while (queue.pop(c))
+        {
+            processed++;
+            const uint16_t next = dist[MazeType::index(c)] + 1;
+            for (Direction d : Dir::kAll)
+            {
+                Cell n;
+                if (!maze.is_open(c, d) || !MazeType::neighbour(c, d, n))
+                    continue;
+                uint16_t& nd = dist[MazeType::index(n)];
+                if (nd == kUnreached)
+                {
+                    nd = next;
+                    queue.push(n);
+                }
+            }
+        }
+        return processed;
+    }
+
+    void seed(Cell c)
+    {
+        const size_t i = MazeType::index(c);
+        const auto bit = static_cast<uint8_t>(1u << (i % 8));
+        if (queued[i / 8] & bit)
+            return;
+        queued[i / 8] |= bit;
+        queue.push(c);  // Each cell at most once, so this cannot overflow
+    }
+
+    void record(uint32_t cells, uint32_t cycles)
+    {
+        update_stats.last_cells = cells;
+        update_stats.last_cycles = cycles;
+        if (cells > update_stats.max_cells)
+            update_stats.max_cells = cells;
+        if (cycles > update_stats.max_cycles)
+            update_stats.max_cycles = cycles;
+    }
+
+    std::array<uint16_t, kCells> dist{};
+    std::array<uint8_t, (kCells + 7) / 8> queued{};
+    Utils::RingQueue<Cell, kCells> queue;
+    std::array<Cell, kMaxGoals> goals{};
+    size_t num_goals = 0;
+    Stats update_stats{};
+};
+
+}  // namespace MM
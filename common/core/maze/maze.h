@@ -0,0 +1,339 @@
+/**
+ * @file maze.h
+ * @brief Bit-packed micromouse maze with known/unknown wall tracking
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Walls between two cells are stored once. Horizontal walls are
+ * kept as H+1 row words (bit x = wall on the south side of cell (x, y)),
+ * vertical walls as W+1 column words (bit y = wall on the west side of cell
+ * (x, y)). A second set of words marks which walls have been seen. A whole
+ * row or column can then be scanned with a single load and bit operations.
+ *
+ * Coordinates: x is the column (0 = west), y the row (0 = south), and the
+ * start cell is (0, 0) facing north.
+ *
+ * Footprint: 16x16 = 136 bytes, 32x32 = 528 bytes.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace MM
+{
+
+enum class Direction : uint8_t
+{
+    NORTH = 0,
+    EAST,
+    SOUTH,
+    WEST
+};
+
+inline constexpr uint8_t kNumDirections = 4;
+
+namespace Dir
+{
+
+inline constexpr std::array<Direction, 4> kAll = {
+    Direction::NORTH, Direction::EAST, Direction::SOUTH, Direction::WEST};
+inline constexpr std::array<int8_t, 4> kDx = {0, 1, 0, -1};
+inline constexpr std::array<int8_t, 4> kDy = {1, 0, -1, 0};
+
+constexpr uint8_t index(Direction d)
+{
+    return static_cast<uint8_t>(d);
+}
+
+/// Bit of a direction in a 4-bit per-cell wall mask
+constexpr uint8_t bit(Direction d)
+{
+    return static_cast<uint8_t>(1u << index(d));
+}
+
+constexpr Direction opposite(Direction d)
+{
+    return static_cast<Direction>((index(d) + 2u) & 3u);
+}
+
+constexpr Direction right(Direction d)
+{
+    return static_cast<Direction>((index(d) + 1u) & 3u);
+}
+
+constexpr Direction left(Direction d)
+{
+    return static_cast<Direction>((index(d) + 3u) & 3u);
+}
+
+static_assert(opposite(Direction::WEST) == Direction::EAST);
+static_assert(right(Direction::WEST) == Direction::NORTH);
+static_assert(left(Direction::NORTH) == Direction::WEST);
+
+}  // namespace Dir
+
+struct Cell
+{
+    uint8_t x;
+    uint8_t y;
+
+    constexpr bool operator==(const Cell&) const = default;
+};
+
+/**
+ * @class Maze
+ * @tparam W Columns (at most 64)
+ * @tparam H Rows (at most 64)
+ */
+template <uint8_t W, uint8_t H>
+class Maze
+{
+    static_assert(W > 0 && H > 0 && W <= 64 && H <= 64,
+                  "Maze sides must be 1..64 cells");
+
+    template <uint8_t N>
+    using BitsFor = std::conditional_t<
+        (N <= 8), uint8_t,
+        std::conditional_t<(N <= 16), uint16_t,
+                           std::conditional_t<(N <= 32), uint32_t,
+                                              uint64_t>>>;
+
+public:
+    using RowBits = BitsFor<W>;     ///< One bit per column
+    using ColumnBits = BitsFor<H>;  ///< One bit per row
+
+    static constexpr uint8_t kWidth = W;
+    static constexpr uint8_t kHeight = H;
+    static constexpr size_t kCells = static_cast<size_t>(W) * H;
+    static constexpr RowBits kRowMask =
+        static_cast<RowBits>(W == 64 ? ~0ull : (1ull << W) - 1u);
+    static constexpr ColumnBits kColumnMask =
+        static_cast<ColumnBits>(H == 64 ? ~0ull : (1ull << H) - 1u);
+
+    /**
+     * @brief Empty maze with only the known outer boundary
+     */
+    constexpr Maze()
+    {
+        clear();
+    }
+
+    /**
+     * @brief Forget every interior wall, keep the outer boundary
+     */
+    constexpr void clear()
+    {
+        h_walls = {};
+        h_known = {};
+        v_walls = {};
+        v_known = {};
+        h_walls[0] = h_walls[H] = kRowMask;
+        h_known[0] = h_known[H] = kRowMask;
+        v_walls[0] = v_walls[W] = kColumnMask;
+        v_known[0] = v_known[W] = kColumnMask;
+    }
+
+    static constexpr bool in_bounds(int x, int y)
+    {
+        return x >= 0 && y >= 0 && x < W && y < H;
+    }
+
+    static constexpr size_t index(Cell c)
+    {
+        return static_cast<size_t>(c.y) * W + c.x;
+    }
+
+    static constexpr Cell cell(size_t index)
+    {
+        return Cell{static_cast<uint8_t>(index % W),
+                    static_cast<uint8_t>(index / W)};
+    }
+
+    /**
+     * @brief Neighbour of @p c in direction @p d
+     * @return false if that would leave the maze
+     */
+    static constexpr bool neighbour(Cell c, Direction d, Cell& out)
+    {
+        const int x = c.x + Dir::kDx[Dir::index(d)];
+        const int y = c.y + Dir::kDy[Dir::index(d)];
+        if (!in_bounds(x, y))
+            return false;
+        out = Cell{static_cast<uint8_t>(x), static_cast<uint8_t>(y)};
+        return true;
+    }
+
+    /**
+     * @brief Record a wall observation (marks the wall known)
+     * @details Shared walls are stored once, so the neighbour sees it too.
+     * Boundary walls cannot be removed.
+     */
+    constexpr void set_wall(Cell c, Direction d, bool present)
+    {
+        const Location l = where(c, d);
+        if (l.line == 0 || l.line == (l.horizontal ? H : W))
+            return;
+        if (l.horizontal)
+            update(h_walls[l.line], h_known[l.line], l.bit, present);
+        else
+            update(v_walls[l.line], v_known[l.line], l.bit, present);
+    }
+
+    constexpr bool has_wall(Cell c, Direction d) const
+    {
+        const Location l = where(c, d);
+        return l.horizontal ? test(h_walls[l.line], l.bit)
+                            : test(v_walls[l.line], l.bit);
+    }
+
+    constexpr bool is_known(Cell c, Direction d) const
+    {
+        const Location l = where(c, d);
+        return l.horizontal ? test(h_known[l.line], l.bit)
+                            : test(v_known[l.line], l.bit);
+    }
+
+    /**
+     * @brief Whether the mouse may pass; unknown walls count as open
+     * (optimistic, for exploration)
+     */
+    constexpr bool is_open(Cell c, Direction d) const
+    {
+        return !has_wall(c, d);
+    }
+
+    /**
+     * @brief Passable and seen, i.e. proven open (for speed runs)
+     */
+    constexpr bool is_open_known(Cell c, Direction d) const
+    {
+        return is_known(c, d) && !has_wall(c, d);
+    }
+
+    /**
+     * @brief 4-bit mask of the cell's walls (Dir::bit order)
+     */
+    constexpr uint8_t walls(Cell c) const
+    {
+        return mask_of(c, h_walls, v_walls);
+    }
+
+    /**
+     * @brief 4-bit mask of which of the cell's walls are known
+     */
+    constexpr uint8_t known(Cell c) const
+    {
+        return mask_of(c, h_known, v_known);
+    }
+
+    /**
+     * @brief Whether all four walls of the cell have been seen
+     */
+    constexpr bool visited(Cell c) const
+    {
+        return known(c) == 0x0F;
+    }
+
+    /**
+     * @brief Walls along row @p y on one side (bit x = cell (x, y))
+     * @param side NORTH or SOUTH
+     */
+    constexpr RowBits row_walls(uint8_t y, Direction side) const
+    {
+        return h_walls[side == Direction::NORTH ? y + 1 : y];
+    }
+
+    constexpr RowBits row_known(uint8_t y, Direction side) const
+    {
+        return h_known[side == Direction::NORTH ? y + 1 : y];
+    }
+
+    /**
+     * @brief Walls along column @p x on one side (bit y = cell (x, y))
+     * @param side EAST or WEST
+     */
+    constexpr ColumnBits column_walls(uint8_t x, Direction side) const
+    {
+        return v_walls[side == Direction::EAST ? x + 1 : x];
+    }
+
+    constexpr ColumnBits column_known(uint8_t x, Direction side) const
+    {
+        return v_known[side == Direction::EAST ? x + 1 : x];
+    }
+
+    /**
+     * @brief Number of known walls in the whole maze (incl. boundary)
+     */
+    constexpr size_t known_count() const
+    {
+        size_t n = 0;
+        for (RowBits r : h_known)
+            n += static_cast<size_t>(__builtin_popcountll(r));
+        for (ColumnBits c : v_known)
+            n += static_cast<size_t>(__builtin_popcountll(c));
+        return n;
+    }
+
+private:
+    struct Location
+    {
+        bool horizontal;
+        uint8_t line;  ///< Row word (horizontal) or column word index
+        uint8_t bit;
+    };
+
+    static constexpr Location where(Cell c, Direction d)
+    {
+        switch (d)
+        {
+            case Direction::NORTH:
+                return {true, static_cast<uint8_t>(c.y + 1), c.x};
+            case Direction::SOUTH:
+                return {true, c.y, c.x};
+            case Direction::EAST:
+                return {false, static_cast<uint8_t>(c.x + 1), c.y};
+            default:
+                return {false, c.x, c.y};
+        }
+    }
+
+    template <typename Word>
+    static constexpr bool test(Word word, uint8_t bit)
+    {
+        return ((word >> bit) & 1u) != 0;
+    }
+
+    template <typename Word>
+    static constexpr void update(Word& walls, Word& seen, uint8_t bit,
+                                 bool present)
+    {
+        const auto mask = static_cast<Word>(Word{1} << bit);
+        walls = present ? static_cast<Word>(walls | mask)
+                        : static_cast<Word>(walls & ~mask);
+        seen = static_cast<Word>(seen | mask);
+    }
+
+    template <typename Rows, typename Columns>
+    static constexpr uint8_t mask_of(Cell c, const Rows& rows,
+                                     const Columns& columns)
+    {
+        return static_cast<uint8_t>(
+            (test(rows[c.y + 1], c.x) << Dir::index(Direction::NORTH)) |
+            (test(columns[c.x + 1], c.y) << Dir::index(Direction::EAST)) |
+            (test(rows[c.y], c.x) << Dir::index(Direction::SOUTH)) |
+            (test(columns[c.x], c.y) << Dir::index(Direction::WEST)));
+    }
+
+    std::array<RowBits, H + 1> h_walls{};
+    std::array<RowBits, H + 1> h_known{};
+    std::array<ColumnBits, W + 1> v_walls{};
+    std::array<ColumnBits, W + 1> v_known{};
+};
+
+static_assert(sizeof(Maze<16, 16>) == 136);
+static_assert(sizeof(Maze<32, 32>) == 528);
+
+}  // namespace MM
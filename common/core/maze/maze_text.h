@@ -0,0 +1,134 @@
+/**
+ * @file maze_text.h
+ * @brief Reader for the common ASCII maze file format
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details This is the format used by the public micromouse maze
+ * collections. North is at the top, and each cell is 3 characters wide
+ * between 'o' posts:
+ * @code
+ * o---o---o---o
+ * | G     |   |
+ * o   o---o   o
+ * | S |       |
+ * o---o---o---o
+ * @endcode
+ * Any non-space character in the middle of a side counts as a wall. 'G'
+ * marks a goal cell. 'S' is accepted but ignored, because the start is
+ * always (0, 0). Every wall read from the text is marked known. Lines may
+ * end in "\r\n", and short lines are padded with spaces.
+ *
+ * Parsing works on a string_view and does not allocate; reading the file
+ * is left to the caller.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include "maze.h"
+
+namespace MM::MazeText
+{
+
+namespace Detail
+{
+
+/**
+ * @brief Line @p index of @p text without its terminator, or empty
+ */
+constexpr std::string_view line(std::string_view text, size_t index)
+{
+    size_t begin = 0;
+    for (size_t i = 0; i < index; i++)
+    {
+        const size_t end = text.find('\n', begin);
+        if (end == std::string_view::npos)
+            return {};
+        begin = end + 1;
+    }
+    std::string_view l = text.substr(begin, text.find('\n', begin) - begin);
+    if (!l.empty() && l.back() == '\r')
+        l.remove_suffix(1);
+    return l;
+}
+
+constexpr char at(std::string_view l, size_t column)
+{
+    return column < l.size() ? l[column] : ' ';
+}
+
+constexpr bool is_wall(char c)
+{
+    return c != ' ' && c != 'G' && c != 'S';
+}
+
+}  // namespace Detail
+
+/**
+ * @brief Maze dimensions described by @p text
+ * @return false if the text is not a maze grid
+ */
+constexpr bool size(std::string_view text, uint8_t& width, uint8_t& height)
+{
+    const std::string_view top = Detail::line(text, 0);
+    if (top.size() < 5 || (top.size() - 1) % 4 != 0 || top[0] != 'o')
+        return false;
+
+    size_t lines = 1;
+    while (!Detail::line(text, lines).empty())
+        lines++;
+    if (lines < 3 || lines % 2 == 0)
+        return false;
+
+    const size_t w = (top.size() - 1) / 4;
+    const size_t h = (lines - 1) / 2;
+    if (w > 64 || h > 64)
+        return false;
+    width = static_cast<uint8_t>(w);
+    height = static_cast<uint8_t>(h);
+    return true;
+}
+
+/**
+ * @brief Load @p text into @p maze
+ * @param[out] goals Goal cells marked 'G', up to goals.size()
+ * @param[out] num_goals Number of goal cells written
+ * @return false if the text does not describe a W x H maze
+ */
+template <uint8_t W, uint8_t H>
+constexpr bool parse(std::string_view text, Maze<W, H>& maze,
+                     std::span<Cell> goals, size_t& num_goals)
+{
+    uint8_t width = 0;
+    uint8_t height = 0;
+    if (!size(text, width, height) || width != W || height != H)
+        return false;
+
+    maze.clear();
+    num_goals = 0;
+    for (uint8_t row = 0; row < H; row++)
+    {
+        const uint8_t y = static_cast<uint8_t>(H - 1 - row);
+        const std::string_view above = Detail::line(text, 2u * row);
+        const std::string_view middle = Detail::line(text, 2u * row + 1u);
+        for (uint8_t x = 0; x < W; x++)
+        {
+            const Cell c{x, y};
+            const size_t centre = 4u * x + 2u;
+            // Boundary walls are fixed; only interior sides are read
+            if (row > 0)
+                maze.set_wall(c, Direction::NORTH,
+                              Detail::is_wall(Detail::at(above, centre)));
+            if (x > 0)
+                maze.set_wall(c, Direction::WEST,
+                              Detail::is_wall(Detail::at(middle, 4u * x)));
+            if (Detail::at(middle, centre) == 'G' && num_goals < goals.size())
+                goals[num_goals++] = c;
+        }
+    }
+    return true;
+}
+
+}  // namespace MM::MazeText
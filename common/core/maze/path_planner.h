@@ -0,0 +1,451 @@
+/**
+ * @file path_planner.h
+ * @brief Time-optimal speed-run planner with diagonal moves
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Flood fill counts cells and yields staircase paths. This
+ * planner instead searches the edge graph. A node is the midpoint of a
+ * cell side (an "edge") plus one of eight headings. Orthogonal moves go
+ * from one side of a cell to the opposite side. Diagonal moves cut across
+ * a cell corner to the adjacent side, so a staircase becomes a straight
+ * diagonal line.
+ *
+ * Each graph transition is one straight run of k steps followed by a
+ * heading change:
+ * - 45 degrees, entering or leaving a diagonal
+ * - 90 degrees between two diagonals (a "V90")
+ * Search 90 degree turns and 135 degree turns come out as chains of these
+ * with a short diagonal between them. Runs are costed with a trapezoidal
+ * speed profile from the cost model's acceleration and speed limits, so a
+ * long straight is worth more than the same number of short ones.
+ *
+ * Dijkstra's algorithm runs over a fixed-capacity indexed binary heap,
+ * with no heap allocation. For a 16x16 maze there are 3264 nodes and the
+ * working set is about 36 KB. A 32x32 half-size maze has 12672 nodes and
+ * needs about 143 KB, more than the 128 KB of SRAM on the F411, so
+ * PathPlanner<32, 32> is for host builds only.
+ */
+
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "indexed_heap.h"
+#include "maze.h"
+
+namespace MM
+{
+
+enum class Heading8 : uint8_t
+{
+    N = 0,
+    NE,
+    E,
+    SE,
+    S,
+    SW,
+    W,
+    NW
+};
+
+namespace Heading
+{
+
+constexpr uint8_t index(Heading8 h)
+{
+    return static_cast<uint8_t>(h);
+}
+
+constexpr bool is_diagonal(Heading8 h)
+{
+    return (index(h) & 1u) != 0;
+}
+
+/**
+ * @brief Rotate by @p steps x 45 degrees (positive = clockwise)
+ */
+constexpr Heading8 rotate(Heading8 h, int steps)
+{
+    return static_cast<Heading8>((index(h) + 8 + steps) & 7);
+}
+
+constexpr Heading8 from(Direction d)
+{
+    return static_cast<Heading8>(Dir::index(d) * 2u);
+}
+
+}  // namespace Heading
+
+/**
+ * @struct PlannerCostModel
+ * @brief Robot limits the plan is optimised for
+ */
+struct PlannerCostModel
+{
+    float cell_mm = 180.0f;
+    float accel_mm_s2 = 6000.0f;         ///< Both accelerating and braking
+    float turn_speed_mm_s = 700.0f;      ///< Speed through every turn
+    float max_speed_mm_s = 2500.0f;      ///< Orthogonal straights
+    float max_diag_speed_mm_s = 1800.0f; ///< Diagonal straights
+    float turn45_ms = 45.0f;             ///< Extra time of a 45 degree turn
+    float turn90_ms = 90.0f;             ///< Extra time of a diagonal V90
+};
+
+/**
+ * @struct PlanStep
+ * @brief One straight run of the plan and the turn that follows it
+ */
+struct PlanStep
+{
+    Heading8 heading;
+    uint8_t steps;      ///< Cells (orthogonal) or half-diagonals
+    int8_t turn;        ///< Next heading change in 45 degree units, 0 = end
+};
+
+template <uint8_t W, uint8_t H>
+class PathPlanner
+{
+public:
+    using MazeType = Maze<W, H>;
+
+    static constexpr size_t kHorizontalEdges = static_cast<size_t>(H + 1) * W;
+    static constexpr size_t kVerticalEdges = static_cast<size_t>(W + 1) * H;
+    static constexpr size_t kEdges = kHorizontalEdges + kVerticalEdges;
+    /// Six headings are possible on each edge (none run along it)
+    static constexpr size_t kNodes = kEdges * 6;
+    static constexpr uint8_t kMaxRun = 2 * (W > H ? W : H);
+    static constexpr size_t kMaxPlanSteps = 2 * MazeType::kCells;
+    static constexpr uint32_t kInfinity = 0xFFFFFFFFu;
+
+    static_assert(kNodes < 0xFFFF, "Maze too large for 16-bit node ids");
+
+    explicit PathPlanner(const PlannerCostModel& model = {}) : heap(dist.data())
+    {
+        set_cost_model(model);
+    }
+
+    /**
+     * @brief Precompute run and turn times for a new set of limits
+     */
+    void set_cost_model(const PlannerCostModel& model)
+    {
+        for (uint8_t k = 0; k <= kMaxRun; k++)
+        {
+            run_us[0][k] = run_time_us(model, k * model.cell_mm,
+                                       model.max_speed_mm_s);
+            run_us[1][k] = run_time_us(model, k * model.cell_mm * 0.70710678f,
+                                       model.max_diag_speed_mm_s);
+        }
+        turn_us[0] = 0;
+        turn_us[1] = static_cast<uint32_t>(model.turn45_ms * 1000.0f);
+        turn_us[2] = static_cast<uint32_t>(model.turn90_ms * 1000.0f);
+    }
+
+    /**
+     * @brief Plan from the start cell, entered heading @p start_heading
+     * @param known_only Use only walls proven open (speed run) instead of
+     *        treating unknown walls as open
+     * @return false if no goal is reachable
+     */
+    bool plan(const MazeType& maze, Cell start, Direction start_heading,
+              std::span<const Cell> goals, bool known_only = true)
+    {
+        dist.fill(kInfinity);
+        heap.clear();
+        best_us = kInfinity;
+        plan_length = 0;
+
+        // Start on the side of the start cell we enter it through
+        const Heading8 heading = Heading::from(start_heading);
+        const uint16_t start_edge =
+            edge_of(start, Dir::opposite(start_heading));
+        const uint16_t start_node = node(start_edge, heading);
+        plan_start = start_edge;
+        dist[start_node] = 0;
+        prev[start_node] = start_node;
+        heap.push_or_decrease(start_node);
+
+        // The start cell may open sideways only, so allow leaving it on a
+        // diagonal without first running straight
+        for (int turn : {-1, 1})
+        {
+            const uint16_t v =
+                node(start_edge, Heading::rotate(heading, turn));
+            dist[v] = turn_us[1];
+            prev[v] = start_node;
+            run_len[v] = 0;
+            heap.push_or_decrease(v);
+        }
+
+        uint16_t u;
+        while (heap.pop(u))
+        {
+            if (dist[u] >= best_us)
+                break;  // Nothing left can beat the best goal arrival
+            relax(maze, u, goals, known_only);
+        }
+        if (best_us == kInfinity)
+            return false;
+
+        build_plan();
+        return true;
+    }
+
+    /**
+     * @brief Estimated run time of the last plan
+     */
+    uint32_t plan_time_us() const
+    {
+        return best_us;
+    }
+
+    std::span<const PlanStep> steps() const
+    {
+        return std::span<const PlanStep>(plan_steps.data(), plan_length);
+    }
+
+    /**
+     * @brief Cells the last plan crosses, from the start cell to the goal
+     * @return Number written; stops early when @p out is full
+     */
+    size_t cells(std::span<Cell> out) const
+    {
+        size_t n = 0;
+        uint16_t edge = plan_start;
+        for (size_t i = 0; i < plan_length; i++)
+        {
+            for (uint8_t k = 0; k < plan_steps[i].steps; k++)
+            {
+                Cell c;
+                Direction exit_side;
+                if (n == out.size() ||
+                    !step(edge, plan_steps[i].heading, c, exit_side))
+                    return n;
+                out[n++] = c;
+                edge = edge_of(c, exit_side);
+            }
+        }
+        return n;
+    }
+
+private:
+    // Heading slot within an edge: horizontal edges take N, NE, SE, S, SW,
+    // NW; vertical edges take NE, E, SE, SW, W, NW
+    static constexpr int8_t kSlotH[8] = {0, 1, -1, 2, 3, 4, -1, 5};
+    static constexpr int8_t kSlotV[8] = {-1, 0, 1, 2, -1, 3, 4, 5};
+    static constexpr Heading8 kHeadingH[6] = {Heading8::N,  Heading8::NE,
+                                              Heading8::SE, Heading8::S,
+                                              Heading8::SW, Heading8::NW};
+    static constexpr Heading8 kHeadingV[6] = {Heading8::NE, Heading8::E,
+                                              Heading8::SE, Heading8::SW,
+                                              Heading8::W,  Heading8::NW};
+
+    static float run_time_us(const PlannerCostModel& m, float d, float v_max)
+    {
+        if (d <= 0.0f)
+            return 0.0f;
+        const float v0 = m.turn_speed_mm_s;
+        const float a = m.accel_mm_s2;
+        // Distance to reach v_max and brake back to v0
+        const float ramp = (v_max * v_max - v0 * v0) / a;
+        float t;
+        if (d >= ramp)
+            t = 2.0f * (v_max - v0) / a + (d - ramp) / v_max;
+        else
+            t = 2.0f * (std::sqrt(v0 * v0 + a * d) - v0) / a;
+        return t * 1e6f;
+    }
+
+    static constexpr bool is_horizontal(uint16_t edge)
+    {
+        return edge < kHorizontalEdges;
+    }
+
+    /// Edge on side @p d of cell @p c
+    static constexpr uint16_t edge_of(Cell c, Direction d)
+    {
+        switch (d)
+        {
+            case Direction::NORTH:
+                return static_cast<uint16_t>((c.y + 1) * W + c.x);
+            case Direction::SOUTH:
+                return static_cast<uint16_t>(c.y * W + c.x);
+            case Direction::EAST:
+                return static_cast<uint16_t>(kHorizontalEdges +
+                                             (c.x + 1) * H + c.y);
+            default:
+                return static_cast<uint16_t>(kHorizontalEdges + c.x * H + c.y);
+        }
+    }
+
+    static constexpr uint16_t node(uint16_t edge, Heading8 h)
+    {
+        const int8_t slot = is_horizontal(edge) ? kSlotH[Heading::index(h)]
+                                                : kSlotV[Heading::index(h)];
+        return static_cast<uint16_t>(edge * 6 + slot);
+    }
+
+    static constexpr bool valid(uint16_t edge, Heading8 h)
+    {
+        return (is_horizontal(edge) ? kSlotH : kSlotV)[Heading::index(h)] >= 0;
+    }
+
+    static constexpr Heading8 heading_of(uint16_t n)
+    {
+        const uint16_t edge = n / 6;
+        return is_horizontal(edge) ? kHeadingH[n % 6] : kHeadingV[n % 6];
+    }
+
+    /**
+     * @brief One step from @p edge along @p h
+     * @param[out] cell Cell crossed
+     * @param[out] exit_side Side of @p cell the step leaves through
+     * @return false if the step leaves the maze
+     */
+    static constexpr bool step(uint16_t edge, Heading8 h, Cell& cell,
+                               Direction& exit_side)
+    {
+        const uint8_t hi = Heading::index(h);
+        const int dx = (hi >= 1 && hi <= 3) ? 1 : (hi >= 5 ? -1 : 0);
+        const int dy = (hi == 7 || hi <= 1) ? 1 : (hi >= 3 && hi <= 5 ? -1 : 0);
+        int x;
+        int y;
+        if (is_horizontal(edge))
+        {
+            // Edge between (x, y-1) and (x, y); enter along dy
+            x = edge % W;
+            y = edge / W - (dy < 0 ? 1 : 0);
+            exit_side = dx > 0   ? Direction::EAST
+                        : dx < 0 ? Direction::WEST
+                        : dy > 0 ? Direction::NORTH
+                                 : Direction::SOUTH;
+        }
+        else
+        {
+            // Edge between (x-1, y) and (x, y); enter along dx
+            const uint16_t v = edge - kHorizontalEdges;
+            x = v / H - (dx < 0 ? 1 : 0);
+            y = v % H;
+            exit_side = dy > 0   ? Direction::NORTH
+                        : dy < 0 ? Direction::SOUTH
+                        : dx > 0 ? Direction::EAST
+                                 : Direction::WEST;
+        }
+        if (!MazeType::in_bounds(x, y))
+            return false;
+        cell = Cell{static_cast<uint8_t>(x), static_cast<uint8_t>(y)};
+        return true;
+    }
+
+    static bool passable(const MazeType& maze, Cell c, Direction d,
+                         bool known_only)
+    {
+        return known_only ? maze.is_open_known(c, d) : maze.is_open(c, d);
+    }
+
+    static bool contains(std::span<const Cell> goals, Cell c)
+    {
+        for (Cell g : goals)
+        {
+            if (g == c)
+                return true;
+        }
+        return false;
+    }
+
+    void relax(const MazeType& maze, uint16_t u, std::span<const Cell> goals,
+               bool known_only)
+    {
+        const Heading8 h = heading_of(u);
+        const uint8_t diag = Heading::is_diagonal(h) ? 1 : 0;
+        uint16_t edge = u / 6;
+
+        for (uint8_t k = 1; k <= kMaxRun; k++)
+        {
+            Cell cell;
+            Direction exit_side;
+            if (!step(edge, h, cell, exit_side))
+                return;
+
+            const uint32_t arrive = dist[u] + run_us[diag][k];
+            if (contains(goals, cell))
+            {
+                // Stop in the first goal cell reached
+                if (arrive < best_us)
+                {
+                    best_us = arrive;
+                    best_node = u;
+                    best_run = k;
+                }
+                return;
+            }
+            if (!passable(maze, cell, exit_side, known_only))
+                return;
+            edge = edge_of(cell, exit_side);
+
+            for (int turn : {-2, -1, 1, 2})
+            {
+                // Orthogonal -> orthogonal needs an edge along the heading,
+                // which does not exist; valid() filters it out
+                const Heading8 next = Heading::rotate(h, turn);
+                if (!valid(edge, next))
+                    continue;
+                const uint32_t cost =
+                    arrive + turn_us[turn < 0 ? -turn : turn];
+                const uint16_t v = node(edge, next);
+                if (cost < dist[v])
+                {
+                    dist[v] = cost;
+                    prev[v] = u;
+                    run_len[v] = k;
+                    heap.push_or_decrease(v);
+                }
+            }
+        }
+    }
+
+    void build_plan()
+    {
+        // Walk back from the goal, then reverse into plan_steps
+        std::array<PlanStep, kMaxPlanSteps>& out = plan_steps;
+        size_t n = 0;
+        out[n++] = PlanStep{heading_of(best_node), best_run, 0};
+        uint16_t v = best_node;
+        while (prev[v] != v && n < kMaxPlanSteps)
+        {
+            const uint16_t u = prev[v];
+            int turn = (Heading::index(heading_of(v)) -
+                        Heading::index(heading_of(u)) + 8) %
+                       8;
+            if (turn > 4)
+                turn -= 8;
+            out[n++] = PlanStep{heading_of(u), run_len[v],
+                                static_cast<int8_t>(turn)};
+            v = u;
+        }
+        for (size_t i = 0; i < n / 2; i++)
+        {
+            const PlanStep t = out[i];
+            out[i] = out[n - 1 - i];
+            out[n - 1 - i] = t;
+        }
+        plan_length = n;
+    }
+
+    std::array<uint32_t, kNodes> dist{};
+    std::array<uint16_t, kNodes> prev{};
+    std::array<uint8_t, kNodes> run_len{};
+    Utils::IndexedMinHeap<kNodes> heap;
+    std::array<std::array<uint32_t, kMaxRun + 1>, 2> run_us{};
+    std::array<uint32_t, 3> turn_us{};
+    std::array<PlanStep, kMaxPlanSteps> plan_steps{};
+    size_t plan_length = 0;
+    uint16_t plan_start = 0;
+    uint32_t best_us = kInfinity;
+    uint16_t best_node = 0;
+    uint8_t best_run = 0;
+};
+
+}  // namespace MM
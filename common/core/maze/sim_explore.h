@@ -0,0 +1,200 @@
+/**
+ * @file sim_explore.h
+ * @brief One simulated search run plus speed-run plan on a known maze
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Drives a Sim::Mouse through @p truth under an Explorer policy,
+ * writing each sensed wall into the mouse's map as the firmware would. A
+ * side the mouse drove through or bumped into is proven and never taken
+ * back. When misreads cut the target off, the map falls back to the
+ * proven sides and the run continues, up to kMaxRecoveries times.
+ *
+ * The speed run is then planned on the learned map and compared with the
+ * plan on the full maze. Host time spent in the solver is measured with
+ * std::chrono, so this header is for native builds only.
+ */
+
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "explorer.h"
+#include "maze.h"
+#include "path_planner.h"
+#include "sim_mouse.h"
+
+namespace MM::Sim
+{
+
+// Misread walls can seal off the goal; give up after this many restarts
+constexpr uint32_t kMaxRecoveries = 8;
+
+struct ExploreResult
+{
+    bool solved;         ///< Explored and got back to the start
+    bool planned;        ///< A speed run exists on the learned map
+    bool optimum_found;  ///< A speed run exists on the full maze
+    bool proven;         ///< Explorer::optimal_proven() after the run
+    uint32_t explored;   ///< Cells entered at least once
+    uint32_t recoveries;
+    uint32_t cost_us;     ///< Speed-run time on the learned map
+    uint32_t optimum_us;  ///< Speed-run time on the full maze
+    double solver_us;     ///< Host time in Explorer calls
+    double plan_us;       ///< Host time of the speed-run plan
+    MouseStats mouse;
+
+    /**
+     * @brief Speed-run cost over the optimum, or 0 if either is missing
+     */
+    double ratio() const
+    {
+        return planned && optimum_found && optimum_us > 0
+                   ? static_cast<double>(cost_us) / optimum_us
+                   : 0.0;
+    }
+
+    /**
+     * @param max_ratio 0 = do not check the path cost
+     */
+    bool ok(double max_ratio) const
+    {
+        // Beating the optimum means the plan drives through a misread wall
+        const double r = ratio();
+        return solved && planned && optimum_found && r >= 1.0 &&
+               (max_ratio <= 0.0 || r <= max_ratio);
+    }
+};
+
+/**
+ * @class Stopwatch
+ * @brief Accumulates the host time spent in solver calls
+ */
+class Stopwatch
+{
+public:
+    template <typename Fn>
+    void time(Fn&& fn)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        fn();
+        total += std::chrono::steady_clock::now() - begin;
+    }
+
+    double us() const
+    {
+        return std::chrono::duration<double, std::micro>(total).count();
+    }
+
+private:
+    std::chrono::steady_clock::duration total{};
+};
+
+template <uint8_t W, uint8_t H>
+ExploreResult explore(const Maze<W, H>& truth, std::span<const Cell> goals,
+                      ExplorePolicy policy, const MouseConfig& config)
+{
+    using M = Maze<W, H>;
+    static M known;
+    static M proven;  // Sides the mouse drove through or bumped into
+    static PathPlanner<W, H> planner;
+    static Explorer<W, H> explorer(planner);
+
+    const Cell start{0, 0};
+    Mouse<W, H> mouse(truth, config);
+    Stopwatch solver;
+    std::array<bool, M::kCells> entered{};
+    ExploreResult result{};
+    result.solved = true;
+
+    known.clear();
+    proven.clear();
+    solver.time([&] {
+        explorer.start(known, goals, ExploreConfig{.policy = policy});
+    });
+    entered[0] = true;
+
+    while (true)
+    {
+        const Cell c = mouse.cell();
+        WallReading readings[3];
+        mouse.sense(readings);
+        bool reflood = false;
+        for (const WallReading& r : readings)
+        {
+            Cell n;
+            if (!M::neighbour(c, r.side, n) || proven.is_known(c, r.side))
+                continue;  // The boundary and proven sides never change
+            const bool was_known = known.is_known(c, r.side);
+            if (was_known && known.has_wall(c, r.side) == r.wall)
+                continue;
+            known.set_wall(c, r.side, r.wall);
+            if (r.wall)
+                solver.time([&] { explorer.wall_added(known, c, r.side); });
+            else if (was_known)
+                reflood = true;  // A misread wall was taken back
+        }
+        if (reflood)
+            solver.time([&] { explorer.refresh(known); });
+
+        Direction d = mouse.heading();
+        bool move = false;
+        solver.time(
+            [&] { move = explorer.next(known, c, mouse.heading(), d); });
+        if (!move)
+        {
+            if (explorer.phase() == ExplorePhase::DONE)
+                break;
+            // Only misreads can cut the target off in a solvable maze, so
+            // fall back to what the mouse has proven by driving
+            if (++result.recoveries > kMaxRecoveries)
+            {
+                result.solved = false;
+                break;
+            }
+            known = proven;
+            solver.time([&] { explorer.refresh(known); });
+            continue;
+        }
+
+        if (mouse.move(d))
+        {
+            known.set_wall(c, d, false);
+            proven.set_wall(c, d, false);
+            entered[M::index(mouse.cell())] = true;
+        }
+        else
+        {
+            known.set_wall(c, d, true);
+            proven.set_wall(c, d, true);
+            solver.time([&] { explorer.wall_added(known, c, d); });
+        }
+
+        const MouseStats& s = mouse.stats();
+        if (s.moves + s.bumps > 16 * M::kCells)
+        {
+            result.solved = false;
+            break;
+        }
+    }
+
+    // Speed run on what was learned, against the optimum on the full maze
+    result.proven = explorer.optimal_proven(known);
+    Stopwatch plan_time;
+    plan_time.time([&] {
+        result.planned = planner.plan(known, start, Direction::NORTH, goals);
+    });
+    result.cost_us = result.planned ? planner.plan_time_us() : 0;
+    result.optimum_found = planner.plan(truth, start, Direction::NORTH, goals);
+    result.optimum_us = planner.plan_time_us();
+
+    for (bool e : entered)
+        result.explored += e;
+    result.solver_us = solver.us();
+    result.plan_us = plan_time.us();
+    result.mouse = mouse.stats();
+    return result;
+}
+
+}  // namespace MM::Sim
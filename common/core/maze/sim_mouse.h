@@ -0,0 +1,133 @@
+/**
+ * @file sim_mouse.h
+ * @brief Simulated mouse moving cell by cell through a ground-truth maze
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details The mouse sees the left, front and right walls of the cell it
+ * stands in. Each sensor sample is wrong with probability @c noise, and
+ * a reading is the majority of @c samples samples, as the firmware
+ * filters several sensor frames per cell. Moving into a real wall fails
+ * and counts as a bump. The random stream comes from a fixed seed, so a
+ * run can be reproduced.
+ */
+
+#pragma once
+#include <cstdint>
+#include "maze.h"
+
+namespace MM::Sim
+{
+
+struct MouseConfig
+{
+    float noise = 0.0f;   ///< Probability that one sample is wrong
+    uint8_t samples = 3;  ///< Samples voted per wall reading
+    uint32_t seed = 1;
+};
+
+struct MouseStats
+{
+    uint32_t moves;
+    uint32_t turns;       ///< 90 degree turns; a U-turn counts as two
+    uint32_t wall_reads;
+    uint32_t misreads;    ///< Readings wrong after the vote
+    uint32_t bumps;
+};
+
+/**
+ * @brief One side reading: which wall and whether the sensor saw it
+ */
+struct WallReading
+{
+    Direction side;
+    bool wall;
+};
+
+template <uint8_t W, uint8_t H>
+class Mouse
+{
+public:
+    using MazeType = Maze<W, H>;
+
+    Mouse(const MazeType& truth_, const MouseConfig& config_)
+        : truth(truth_), config(config_), rng(config_.seed | 1u)
+    {
+    }
+
+    /**
+     * @brief Read the left, front and right walls of the current cell
+     */
+    void sense(WallReading (&out)[3])
+    {
+        const Direction sides[3] = {Dir::left(facing), facing,
+                                    Dir::right(facing)};
+        for (int i = 0; i < 3; i++)
+        {
+            const bool actual = truth.has_wall(position, sides[i]);
+            uint8_t votes = 0;
+            for (uint8_t k = 0; k < config.samples; k++)
+                votes += (uniform() < config.noise) != actual;
+            const bool wall = 2u * votes > config.samples;
+            if (wall != actual)
+                mouse_stats.misreads++;
+            out[i] = WallReading{sides[i], wall};
+            mouse_stats.wall_reads++;
+        }
+    }
+
+    /**
+     * @brief Turn to @p d and drive one cell
+     * @return false if a wall was in the way; the mouse stays put
+     */
+    bool move(Direction d)
+    {
+        const uint8_t turn = (Dir::index(d) - Dir::index(facing)) & 3u;
+        mouse_stats.turns += turn == 2 ? 2 : (turn != 0 ? 1 : 0);
+        facing = d;
+
+        Cell next;
+        if (truth.has_wall(position, d) ||
+            !MazeType::neighbour(position, d, next))
+        {
+            mouse_stats.bumps++;
+            return false;
+        }
+        position = next;
+        mouse_stats.moves++;
+        return true;
+    }
+
+    Cell cell() const
+    {
+        return position;
+    }
+
+    Direction heading() const
+    {
+        return facing;
+    }
+
+    const MouseStats& stats() const
+    {
+        return mouse_stats;
+    }
+
+private:
+    float uniform()
+    {
+        // xorshift32
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return static_cast<float>(rng >> 8) / static_cast<float>(1u << 24);
+    }
+
+    const MazeType& truth;
+    const MouseConfig config;
+    uint32_t rng;
+    Cell position{0, 0};
+    Direction facing = Direction::NORTH;
+    MouseStats mouse_stats{};
+};
+
+}  // namespace MM::Sim
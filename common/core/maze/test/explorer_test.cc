@@ -0,0 +1,174 @@
+/**
+ * @file explorer_test.cc
+ * @brief Every exploration policy on the regression corpus
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Each maze is explored by a simulated mouse under every policy,
+ * once with perfect sensors and once with 2% sample noise. The run must
+ * get home, and the speed run on the learned map must be no faster than
+ * the optimum (faster means it drives through a misread wall) and at most
+ * kMaxRatio times slower. app/maze_sim prints the same runs in detail.
+ */
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "explorer.h"
+#include "maze.h"
+#include "maze_corpus.h"
+#include "maze_text.h"
+#include "path_planner.h"
+#include "sim_explore.h"
+
+namespace MM
+{
+namespace
+{
+
+constexpr double kMaxRatio = 1.25;
+
+constexpr ExplorePolicy kPolicies[] = {ExplorePolicy::GREEDY,
+                                       ExplorePolicy::RETURN_VIA_UNKNOWN,
+                                       ExplorePolicy::FULL_COVERAGE};
+
+constexpr Sim::MouseConfig kClean{};
+constexpr Sim::MouseConfig kNoisy{.noise = 0.02f, .seed = 7};
+
+template <uint8_t W, uint8_t H>
+void explore_all(std::string_view text, const Sim::MouseConfig& mouse)
+{
+    static Maze<W, H> truth;
+    Cell goals[FloodFill<W, H>::kMaxGoals];
+    size_t num_goals = 0;
+    ASSERT_TRUE(MazeText::parse(text, truth, std::span<Cell>(goals),
+                                num_goals));
+    ASSERT_GT(num_goals, 0u);
+
+    for (ExplorePolicy policy : kPolicies)
+    {
+        SCOPED_TRACE(static_cast<int>(policy));
+        const Sim::ExploreResult r = Sim::explore(
+            truth, std::span<const Cell>(goals, num_goals), policy, mouse);
+        EXPECT_TRUE(r.solved);
+        EXPECT_TRUE(r.planned);
+        EXPECT_TRUE(r.optimum_found);
+        EXPECT_GE(r.ratio(), 1.0);
+        EXPECT_LE(r.ratio(), kMaxRatio);
+
+        // With perfect sensors the mouse never drives into a wall, and
+        // full coverage always proves its path
+        if (mouse.noise == 0.0f)
+        {
+            EXPECT_EQ(r.mouse.bumps, 0u);
+            if (policy == ExplorePolicy::FULL_COVERAGE)
+                EXPECT_TRUE(r.proven);
+        }
+    }
+}
+
+void explore_corpus(const Sim::MouseConfig& mouse)
+{
+    const std::vector<Corpus::MazeFile> files = Corpus::load();
+    ASSERT_FALSE(files.empty()) << "no mazes in " << MAZE_CORPUS_DIR;
+    for (const Corpus::MazeFile& f : files)
+    {
+        SCOPED_TRACE(f.name);
+        uint8_t w = 0;
+        uint8_t h = 0;
+        ASSERT_TRUE(MazeText::size(f.text, w, h));
+        if (w == 16 && h == 16)
+            explore_all<16, 16>(f.text, mouse);
+        else if (w == 32 && h == 32)
+            explore_all<32, 32>(f.text, mouse);
+        else
+            ADD_FAILURE() << "unsupported size " << +w << "x" << +h;
+    }
+}
+
+TEST(ExplorerTest, CorpusWithPerfectSensors)
+{
+    explore_corpus(kClean);
+}
+
+TEST(ExplorerTest, CorpusWithNoisySensors)
+{
+    explore_corpus(kNoisy);
+}
+
+// 3 x 2 with the goal in the top-right corner, reached round the east end
+constexpr std::string_view kHook = "o---o---o---o\n"
+                                   "|       | G |\n"
+                                   "o   o---o   o\n"
+                                   "| S         |\n"
+                                   "o---o---o---o\n";
+
+class ExplorerPhaseTest : public ::testing::Test
+{
+protected:
+    using M = Maze<3, 2>;
+
+    void SetUp() override
+    {
+        size_t num_goals = 0;
+        ASSERT_TRUE(MazeText::parse(kHook, truth, std::span<Cell>(goal, 1),
+                                    num_goals));
+        ASSERT_EQ(num_goals, 1u);
+    }
+
+    M truth;
+    M known;
+    Cell goal[1];
+    PathPlanner<3, 2> planner;
+    Explorer<3, 2> explorer{planner};
+};
+
+TEST_F(ExplorerPhaseTest, GreedyGoesToGoalThenHome)
+{
+    // Full knowledge: the route is fixed, so every step can be checked
+    ASSERT_TRUE(explorer.start(truth, goal,
+                               ExploreConfig{.policy = ExplorePolicy::GREEDY}));
+    EXPECT_EQ(explorer.phase(), ExplorePhase::TO_GOAL);
+
+    Cell at{0, 0};
+    Direction heading = Direction::NORTH;
+    const Direction expected[] = {Direction::EAST, Direction::EAST,
+                                  Direction::NORTH, Direction::SOUTH,
+                                  Direction::WEST, Direction::WEST};
+    for (Direction e : expected)
+    {
+        Direction d = heading;
+        ASSERT_TRUE(explorer.next(truth, at, heading, d));
+        EXPECT_EQ(d, e);
+        ASSERT_TRUE(M::neighbour(at, d, at));
+        heading = d;
+    }
+    EXPECT_EQ(explorer.phase(), ExplorePhase::RETURN);
+    Direction d = heading;
+    EXPECT_FALSE(explorer.next(truth, at, heading, d));
+    EXPECT_EQ(explorer.phase(), ExplorePhase::DONE);
+}
+
+TEST_F(ExplorerPhaseTest, SealedGoalIsStuckUntilRefresh)
+{
+    ASSERT_TRUE(explorer.start(known, goal, ExploreConfig{}));
+    known.set_wall(Cell{2, 1}, Direction::SOUTH, true);
+    explorer.wall_added(known, Cell{2, 1}, Direction::SOUTH);
+    known.set_wall(Cell{2, 1}, Direction::WEST, true);
+    explorer.wall_added(known, Cell{2, 1}, Direction::WEST);
+
+    Direction d = Direction::NORTH;
+    EXPECT_FALSE(explorer.next(known, Cell{0, 0}, Direction::NORTH, d));
+    EXPECT_EQ(explorer.phase(), ExplorePhase::STUCK);
+
+    // The south wall was a misread: taking it back resumes the run
+    known.set_wall(Cell{2, 1}, Direction::SOUTH, false);
+    explorer.refresh(known);
+    EXPECT_EQ(explorer.phase(), ExplorePhase::TO_GOAL);
+    EXPECT_TRUE(explorer.next(known, Cell{0, 0}, Direction::NORTH, d));
+}
+
+}  // namespace
+}  // namespace MM
@@ -0,0 +1,133 @@
+/**
+ * @file indexed_heap_test.cc
+ * @brief Pop order and decrease-key of the planner's IndexedMinHeap
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details indexed_heap.h lives in common/core/utils, but the utils
+ * library does not build natively; the maze target already exports its
+ * include path.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "indexed_heap.h"
+
+namespace MM
+{
+namespace
+{
+
+constexpr size_t kIds = 500;
+
+class IndexedHeapTest : public ::testing::Test
+{
+protected:
+    std::vector<uint16_t> drain()
+    {
+        std::vector<uint16_t> out;
+        uint16_t id;
+        while (heap.pop(id))
+        {
+            EXPECT_FALSE(heap.contains(id));
+            out.push_back(id);
+        }
+        return out;
+    }
+
+    std::array<uint32_t, kIds> keys{};
+    Utils::IndexedMinHeap<kIds> heap{keys.data()};
+};
+
+TEST_F(IndexedHeapTest, PopsInKeyOrder)
+{
+    keys[3] = 30;
+    keys[1] = 10;
+    keys[4] = 40;
+    keys[2] = 20;
+    for (uint16_t id : {3, 1, 4, 2})
+        heap.push_or_decrease(id);
+    EXPECT_EQ(heap.size(), 4u);
+    EXPECT_TRUE(heap.contains(4));
+    EXPECT_FALSE(heap.contains(0));
+
+    EXPECT_EQ(drain(), (std::vector<uint16_t>{1, 2, 3, 4}));
+    EXPECT_TRUE(heap.empty());
+    uint16_t id = 0;
+    EXPECT_FALSE(heap.pop(id));
+}
+
+TEST_F(IndexedHeapTest, DecreaseKeyMovesAnIdForward)
+{
+    for (uint16_t id = 0; id < 10; id++)
+    {
+        keys[id] = 100 + id;
+        heap.push_or_decrease(id);
+    }
+    // Pushing an id that is already queued only reorders it
+    keys[7] = 5;
+    heap.push_or_decrease(7);
+    keys[9] = 50;
+    heap.push_or_decrease(9);
+    EXPECT_EQ(heap.size(), 10u);
+
+    EXPECT_EQ(drain(),
+              (std::vector<uint16_t>{7, 9, 0, 1, 2, 3, 4, 5, 6, 8}));
+}
+
+TEST_F(IndexedHeapTest, ClearForgetsEveryId)
+{
+    keys[5] = 1;
+    heap.push_or_decrease(5);
+    heap.clear();
+    EXPECT_TRUE(heap.empty());
+    EXPECT_FALSE(heap.contains(5));
+
+    keys[6] = 2;
+    heap.push_or_decrease(6);
+    EXPECT_EQ(drain(), (std::vector<uint16_t>{6}));
+}
+
+TEST_F(IndexedHeapTest, InterleavedDecreasesPopInOrder)
+{
+    uint32_t seed = 1;
+    auto next = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+
+    for (uint16_t id = 0; id < kIds; id++)
+    {
+        keys[id] = next() % 100000u;
+        heap.push_or_decrease(id);
+    }
+
+    // As in Dijkstra, a decreased key never drops below the last pop, so
+    // the popped keys must come out sorted
+    std::vector<uint32_t> popped;
+    uint32_t floor = 0;
+    uint16_t top;
+    while (!heap.empty())
+    {
+        for (int k = 0; k < 4; k++)
+        {
+            const uint16_t id = static_cast<uint16_t>(next() % kIds);
+            if (heap.contains(id) && keys[id] > floor)
+            {
+                keys[id] = floor + next() % (keys[id] - floor);
+                heap.push_or_decrease(id);
+            }
+        }
+        ASSERT_TRUE(heap.pop(top));
+        floor = keys[top];
+        popped.push_back(floor);
+    }
+
+    EXPECT_EQ(popped.size(), kIds);
+    EXPECT_TRUE(std::is_sorted(popped.begin(), popped.end()));
+}
+
+}  // namespace
+}  // namespace MM
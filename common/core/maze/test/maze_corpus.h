@@ -0,0 +1,47 @@
+/**
+ * @file maze_corpus.h
+ * @brief Loader for the regression mazes in test/mazes
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details MAZE_CORPUS_DIR is set by test/CMakeLists.txt. Files are
+ * returned sorted by name, so failures are reported in a stable order.
+ */
+
+#pragma once
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace MM::Corpus
+{
+
+struct MazeFile
+{
+    std::string name;
+    std::string text;
+};
+
+inline std::vector<MazeFile> load()
+{
+    std::vector<MazeFile> files;
+    for (const auto& entry :
+         std::filesystem::directory_iterator(MAZE_CORPUS_DIR))
+    {
+        if (entry.path().extension() != ".txt")
+            continue;
+        std::ifstream file(entry.path());
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        files.push_back({entry.path().stem().string(), buffer.str()});
+    }
+    std::sort(files.begin(), files.end(),
+              [](const MazeFile& a, const MazeFile& b) {
+                  return a.name < b.name;
+              });
+    return files;
+}
+
+}  // namespace MM::Corpus
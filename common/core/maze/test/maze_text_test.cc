@@ -0,0 +1,147 @@
+/**
+ * @file maze_text_test.cc
+ * @brief ASCII maze reader, and sanity checks of the regression corpus
+ * @author Kent Hong
+ * @date 2026-10-18
+ */
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "flood_fill.h"
+#include "maze.h"
+#include "maze_corpus.h"
+#include "maze_text.h"
+
+namespace MM
+{
+namespace
+{
+
+// 3 x 2, north at the top: (0, 0) is the bottom-left cell
+constexpr std::string_view kSmall = "o---o---o---o\n"
+                                    "| G     |   |\n"
+                                    "o   o---o   o\n"
+                                    "| S |       |\n"
+                                    "o---o---o---o\n";
+
+TEST(MazeTextTest, Size)
+{
+    uint8_t w = 0;
+    uint8_t h = 0;
+    ASSERT_TRUE(MazeText::size(kSmall, w, h));
+    EXPECT_EQ(w, 3u);
+    EXPECT_EQ(h, 2u);
+
+    EXPECT_FALSE(MazeText::size("", w, h));
+    EXPECT_FALSE(MazeText::size("o---o\n", w, h));
+    // Top line is not a whole number of cells
+    EXPECT_FALSE(MazeText::size("o---o-\n|   |\no---o\n", w, h));
+    // Even line count: a row of cells without its bottom edge
+    EXPECT_FALSE(MazeText::size("o---o\n|   |\n", w, h));
+}
+
+TEST(MazeTextTest, ParseWallsAndGoals)
+{
+    Maze<3, 2> maze;
+    Cell goals[4];
+    size_t num_goals = 0;
+    ASSERT_TRUE(MazeText::parse(kSmall, maze, std::span<Cell>(goals),
+                                num_goals));
+
+    ASSERT_EQ(num_goals, 1u);
+    EXPECT_EQ(goals[0], (Cell{0, 1}));
+
+    EXPECT_TRUE(maze.has_wall(Cell{0, 0}, Direction::EAST));
+    EXPECT_TRUE(maze.is_open(Cell{0, 0}, Direction::NORTH));
+    EXPECT_TRUE(maze.has_wall(Cell{1, 0}, Direction::NORTH));
+    EXPECT_FALSE(maze.has_wall(Cell{2, 0}, Direction::WEST));
+    EXPECT_TRUE(maze.has_wall(Cell{1, 1}, Direction::EAST));
+    EXPECT_TRUE(maze.is_open(Cell{2, 1}, Direction::SOUTH));
+
+    // Every interior side is now known, walls and openings alike
+    for (size_t i = 0; i < maze.kCells; i++)
+        EXPECT_EQ(maze.known(Maze<3, 2>::cell(i)), 0xFu);
+}
+
+TEST(MazeTextTest, CrlfAndShortLines)
+{
+    // Trailing spaces trimmed and Windows line ends
+    constexpr std::string_view kTrimmed = "o---o---o\r\n"
+                                          "|   |\r\n"
+                                          "o---o---o\r\n";
+    Maze<2, 1> maze;
+    Cell goals[1];
+    size_t num_goals = 0;
+    ASSERT_TRUE(MazeText::parse(kTrimmed, maze, std::span<Cell>(goals),
+                                num_goals));
+    EXPECT_EQ(num_goals, 0u);
+    EXPECT_TRUE(maze.has_wall(Cell{0, 0}, Direction::EAST));
+}
+
+TEST(MazeTextTest, WrongSizeIsRejected)
+{
+    Maze<16, 16> maze;
+    Cell goals[4];
+    size_t num_goals = 0;
+    EXPECT_FALSE(MazeText::parse(kSmall, maze, std::span<Cell>(goals),
+                                 num_goals));
+}
+
+TEST(MazeTextTest, GoalListIsBounded)
+{
+    constexpr std::string_view kAllGoals = "o---o---o\n"
+                                           "| G   G |\n"
+                                           "o---o---o\n";
+    Maze<2, 1> maze;
+    Cell goals[1];
+    size_t num_goals = 0;
+    ASSERT_TRUE(MazeText::parse(kAllGoals, maze, std::span<Cell>(goals),
+                                num_goals));
+    EXPECT_EQ(num_goals, 1u);
+}
+
+/**
+ * @brief Every goal of a corpus maze is reachable from the start
+ */
+template <uint8_t W, uint8_t H>
+void expect_solvable(std::string_view text)
+{
+    static Maze<W, H> maze;
+    static FloodFill<W, H> flood;
+    Cell goals[FloodFill<W, H>::kMaxGoals];
+    size_t num_goals = 0;
+    ASSERT_TRUE(MazeText::parse(text, maze, std::span<Cell>(goals),
+                                num_goals));
+    ASSERT_GT(num_goals, 0u);
+    ASSERT_TRUE(flood.set_goals(std::span<const Cell>(goals, num_goals)));
+    flood.flood(maze);
+    EXPECT_LT(flood.distance(Cell{0, 0}), (FloodFill<W, H>::kUnreached));
+    // The start cell is open only to the north
+    EXPECT_TRUE(maze.has_wall(Cell{0, 0}, Direction::EAST));
+}
+
+TEST(MazeTextTest, CorpusParses)
+{
+    const std::vector<Corpus::MazeFile> files = Corpus::load();
+    ASSERT_FALSE(files.empty()) << "no mazes in " << MAZE_CORPUS_DIR;
+    for (const Corpus::MazeFile& f : files)
+    {
+        SCOPED_TRACE(f.name);
+        uint8_t w = 0;
+        uint8_t h = 0;
+        ASSERT_TRUE(MazeText::size(f.text, w, h));
+        if (w == 16 && h == 16)
+            expect_solvable<16, 16>(f.text);
+        else if (w == 32 && h == 32)
+            expect_solvable<32, 32>(f.text);
+        else
+            ADD_FAILURE() << "unsupported size " << +w << "x" << +h;
+    }
+}
+
+}  // namespace
+}  // namespace MM
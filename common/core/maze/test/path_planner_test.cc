@@ -0,0 +1,203 @@
+/**
+ * @file path_planner_test.cc
+ * @brief Speed-run plans on small hand-built mazes with a known answer
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Each maze has a single route, so the expected run list and the
+ * cells it crosses can be written down by hand. Run times are checked
+ * against the trapezoidal profile computed here in double precision.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "maze.h"
+#include "maze_text.h"
+#include "path_planner.h"
+
+namespace MM
+{
+namespace
+{
+
+// One column, start at the bottom, goal at the top
+constexpr std::string_view kCorridor = "o---o\n"
+                                       "| G |\n"
+                                       "o   o\n"
+                                       "|   |\n"
+                                       "o   o\n"
+                                       "|   |\n"
+                                       "o   o\n"
+                                       "| S |\n"
+                                       "o---o\n";
+
+// North, east, north, east ... from (0, 0) to (3, 3)
+constexpr std::string_view kStaircase = "o---o---o---o---o\n"
+                                        "|   |   |     G |\n"
+                                        "o---o---o   o---o\n"
+                                        "|   |       |   |\n"
+                                        "o---o   o---o---o\n"
+                                        "|       |   |   |\n"
+                                        "o   o---o---o---o\n"
+                                        "| S |   |   |   |\n"
+                                        "o---o---o---o---o\n";
+
+// The corridor with its middle blocked
+constexpr std::string_view kBlocked = "o---o\n"
+                                      "| G |\n"
+                                      "o   o\n"
+                                      "|   |\n"
+                                      "o---o\n"
+                                      "|   |\n"
+                                      "o   o\n"
+                                      "| S |\n"
+                                      "o---o\n";
+
+/**
+ * @brief Time of a straight run of @p d mm from and back to turn speed
+ */
+double run_us(const PlannerCostModel& m, double d, double v_max)
+{
+    const double v0 = m.turn_speed_mm_s;
+    const double a = m.accel_mm_s2;
+    const double ramp = (v_max * v_max - v0 * v0) / a;
+    const double t = d >= ramp
+                         ? 2.0 * (v_max - v0) / a + (d - ramp) / v_max
+                         : 2.0 * (std::sqrt(v0 * v0 + a * d) - v0) / a;
+    return t * 1e6;
+}
+
+template <uint8_t W, uint8_t H>
+class Fixture
+{
+public:
+    bool load(std::string_view text)
+    {
+        size_t num_goals = 0;
+        goals.resize(4);
+        if (!MazeText::parse(text, maze, std::span<Cell>(goals), num_goals))
+            return false;
+        goals.resize(num_goals);
+        return num_goals > 0;
+    }
+
+    bool plan(bool known_only = true)
+    {
+        return planner.plan(maze, Cell{0, 0}, Direction::NORTH, goals,
+                            known_only);
+    }
+
+    std::vector<Cell> cells() const
+    {
+        std::vector<Cell> out(2 * Maze<W, H>::kCells);
+        out.resize(planner.cells(std::span<Cell>(out)));
+        return out;
+    }
+
+    Maze<W, H> maze;
+    std::vector<Cell> goals;
+    PathPlanner<W, H> planner;
+};
+
+TEST(PathPlannerTest, StraightCorridorIsOneRun)
+{
+    Fixture<1, 4> f;
+    ASSERT_TRUE(f.load(kCorridor));
+    ASSERT_TRUE(f.plan());
+
+    const std::span<const PlanStep> steps = f.planner.steps();
+    ASSERT_EQ(steps.size(), 1u);
+    EXPECT_EQ(steps[0].heading, Heading8::N);
+    EXPECT_EQ(steps[0].steps, 4u);
+    EXPECT_EQ(steps[0].turn, 0);
+
+    const PlannerCostModel model;
+    EXPECT_NEAR(f.planner.plan_time_us(),
+                run_us(model, 4 * model.cell_mm, model.max_speed_mm_s), 1.0);
+}
+
+TEST(PathPlannerTest, StaircaseCollapsesToADiagonal)
+{
+    Fixture<4, 4> f;
+    ASSERT_TRUE(f.load(kStaircase));
+    ASSERT_TRUE(f.plan());
+
+    // One cell north, 45 degrees right, then six half-diagonals into the
+    // goal instead of six 90 degree turns
+    const std::span<const PlanStep> steps = f.planner.steps();
+    ASSERT_EQ(steps.size(), 2u);
+    EXPECT_EQ(steps[0].heading, Heading8::N);
+    EXPECT_EQ(steps[0].steps, 1u);
+    EXPECT_EQ(steps[0].turn, 1);
+    EXPECT_EQ(steps[1].heading, Heading8::NE);
+    EXPECT_EQ(steps[1].steps, 6u);
+    EXPECT_EQ(steps[1].turn, 0);
+
+    const PlannerCostModel model;
+    const double expected =
+        run_us(model, model.cell_mm, model.max_speed_mm_s) +
+        model.turn45_ms * 1000.0 +
+        run_us(model, 6 * model.cell_mm * 0.70710678,
+               model.max_diag_speed_mm_s);
+    EXPECT_NEAR(f.planner.plan_time_us(), expected, 2.0);
+}
+
+TEST(PathPlannerTest, CellsFollowThePlan)
+{
+    Fixture<4, 4> f;
+    ASSERT_TRUE(f.load(kStaircase));
+    ASSERT_TRUE(f.plan());
+
+    const std::vector<Cell> expected = {{0, 0}, {0, 1}, {1, 1}, {1, 2},
+                                        {2, 2}, {2, 3}, {3, 3}};
+    EXPECT_EQ(f.cells(), expected);
+
+    // A short buffer is filled and no further
+    Cell out[3];
+    ASSERT_EQ(f.planner.cells(std::span<Cell>(out)), 3u);
+    EXPECT_EQ(out[2], (Cell{1, 1}));
+
+    Fixture<1, 4> corridor;
+    ASSERT_TRUE(corridor.load(kCorridor));
+    ASSERT_TRUE(corridor.plan());
+    const std::vector<Cell> straight = {{0, 0}, {0, 1}, {0, 2}, {0, 3}};
+    EXPECT_EQ(corridor.cells(), straight);
+}
+
+TEST(PathPlannerTest, UnreachableGoal)
+{
+    Fixture<1, 4> f;
+    ASSERT_TRUE(f.load(kBlocked));
+    EXPECT_FALSE(f.plan());
+    EXPECT_FALSE(f.plan(false));
+    EXPECT_TRUE(f.planner.steps().empty());
+    EXPECT_EQ(f.planner.plan_time_us(), (PathPlanner<1, 4>::kInfinity));
+}
+
+TEST(PathPlannerTest, KnownOnlySkipsUnknownWalls)
+{
+    // Only the first two sides of the corridor have been seen
+    Fixture<1, 4> f;
+    f.goals = {Cell{0, 3}};
+    f.maze.set_wall(Cell{0, 0}, Direction::NORTH, false);
+    f.maze.set_wall(Cell{0, 1}, Direction::NORTH, false);
+
+    EXPECT_FALSE(f.plan());
+    ASSERT_TRUE(f.plan(false));
+    ASSERT_EQ(f.planner.steps().size(), 1u);
+    EXPECT_EQ(f.planner.steps()[0].steps, 4u);
+
+    f.maze.set_wall(Cell{0, 2}, Direction::NORTH, false);
+    EXPECT_TRUE(f.plan());
+
+    f.maze.set_wall(Cell{0, 2}, Direction::NORTH, true);
+    EXPECT_FALSE(f.plan());
+    EXPECT_FALSE(f.plan(false));
+}
+
+}  // namespace
+}  // namespace MM
@@ -0,0 +1,102 @@
+/**
+ * @file sim_mouse_test.cc
+ * @brief Sensing, moving and noise of the simulated mouse
+ * @author Kent Hong
+ * @date 2026-10-18
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include "maze.h"
+#include "maze_text.h"
+#include "sim_mouse.h"
+
+namespace MM
+{
+namespace
+{
+
+constexpr std::string_view kSmall = "o---o---o---o\n"
+                                    "| G     |   |\n"
+                                    "o   o---o   o\n"
+                                    "| S |       |\n"
+                                    "o---o---o---o\n";
+
+class SimMouseTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Cell goals[1];
+        size_t num_goals = 0;
+        ASSERT_TRUE(MazeText::parse(kSmall, truth, std::span<Cell>(goals),
+                                    num_goals));
+    }
+
+    Maze<3, 2> truth;
+};
+
+TEST_F(SimMouseTest, CleanSensorsSeeTheTruth)
+{
+    Sim::Mouse<3, 2> mouse(truth, Sim::MouseConfig{});
+    Sim::WallReading r[3];
+    mouse.sense(r);
+
+    // Facing north from (0, 0): left, front, right
+    EXPECT_EQ(r[0].side, Direction::WEST);
+    EXPECT_TRUE(r[0].wall);
+    EXPECT_EQ(r[1].side, Direction::NORTH);
+    EXPECT_FALSE(r[1].wall);
+    EXPECT_EQ(r[2].side, Direction::EAST);
+    EXPECT_TRUE(r[2].wall);
+    EXPECT_EQ(mouse.stats().wall_reads, 3u);
+    EXPECT_EQ(mouse.stats().misreads, 0u);
+}
+
+TEST_F(SimMouseTest, MovesTurnsAndBumps)
+{
+    Sim::Mouse<3, 2> mouse(truth, Sim::MouseConfig{});
+    ASSERT_TRUE(mouse.move(Direction::NORTH));
+    EXPECT_EQ(mouse.cell(), (Cell{0, 1}));
+
+    ASSERT_TRUE(mouse.move(Direction::EAST));
+    EXPECT_EQ(mouse.cell(), (Cell{1, 1}));
+    EXPECT_EQ(mouse.heading(), Direction::EAST);
+
+    // (1, 1) is walled to the east; the mouse turns but stays put
+    EXPECT_FALSE(mouse.move(Direction::EAST));
+    EXPECT_EQ(mouse.cell(), (Cell{1, 1}));
+
+    // A U-turn counts as two quarter turns
+    ASSERT_TRUE(mouse.move(Direction::WEST));
+
+    const Sim::MouseStats& s = mouse.stats();
+    EXPECT_EQ(s.moves, 3u);
+    EXPECT_EQ(s.bumps, 1u);
+    EXPECT_EQ(s.turns, 3u);
+}
+
+TEST_F(SimMouseTest, NoiseIsVotedDownAndReproducible)
+{
+    auto misreads = [this](uint8_t samples, uint32_t seed) {
+        Sim::Mouse<3, 2> mouse(
+            truth, Sim::MouseConfig{.noise = 0.2f, .samples = samples,
+                                    .seed = seed});
+        Sim::WallReading r[3];
+        for (int i = 0; i < 2000; i++)
+            mouse.sense(r);
+        return mouse.stats().misreads;
+    };
+
+    // 6000 readings: about 20% wrong with one sample, 10.4% with three
+    const uint32_t single = misreads(1, 7);
+    const uint32_t voted = misreads(3, 7);
+    EXPECT_NEAR(single, 1200.0, 150.0);
+    EXPECT_NEAR(voted, 624.0, 120.0);
+    EXPECT_EQ(misreads(3, 7), voted);
+}
+
+}  // namespace
+}  // namespace MM
@@ -0,0 +1,101 @@
+#include "bno055_calib_store.h"
+#include <array>
+
+namespace MM
+{
+
+static uint16_t fletcher16(const uint8_t* data, size_t len)
+{
+    uint16_t sum1 = 0;
+    uint16_t sum2 = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        sum1 = (sum1 + data[i]) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+    return static_cast<uint16_t>((sum2 << 8) | sum1);
+}
+
+static void put_i16(uint8_t* dst, int16_t value)
+{
+    dst[0] = static_cast<uint8_t>(value & 0xFF);
+    dst[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+}
+
+static int16_t get_i16(const uint8_t* src)
+{
+    return static_cast<int16_t>(src[0] | (src[1] << 8));
+}
+
+Bno055CalibrationStore::Bno055CalibrationStore(W25q& flash_, uint8_t block_,
+                                               uint8_t sector_)
+    : flash{flash_}, block{block_}, sector{sector_}
+{
+}
+
+bool Bno055CalibrationStore::load(Bno055Calibration& cal)
+{
+    std::array<uint8_t, kRecordSize> record{};
+    if (!flash.read(block, sector, 0, 0, record))
+        return false;
+
+    uint32_t magic = static_cast<uint32_t>(record[0]) |
+                     (static_cast<uint32_t>(record[1]) << 8) |
+                     (static_cast<uint32_t>(record[2]) << 16) |
+                     (static_cast<uint32_t>(record[3]) << 24);
+    if (magic != kMagic || record[4] != kVersion ||
+        record[5] != Bno055Calibration::SIZE)
+        return false;
+
+    const size_t crc_idx = kRecordSize - 2;
+    uint16_t stored_crc = static_cast<uint16_t>(record[crc_idx] |
+                                                (record[crc_idx + 1] << 8));
+    if (fletcher16(record.data(), crc_idx) != stored_crc)
+        return false;
+
+    const uint8_t* payload = &record[kHeaderSize];
+    for (size_t i = 0; i < 3; i++)
+    {
+        cal.accel_offset[i] = get_i16(&payload[0 + 2 * i]);
+        cal.mag_offset[i] = get_i16(&payload[6 + 2 * i]);
+        cal.gyro_offset[i] = get_i16(&payload[12 + 2 * i]);
+    }
+    cal.accel_radius = get_i16(&payload[18]);
+    cal.mag_radius = get_i16(&payload[20]);
+    return true;
+}
+
+bool Bno055CalibrationStore::save(const Bno055Calibration& cal)
+{
+    std::array<uint8_t, kRecordSize> record{};
+    record[0] = static_cast<uint8_t>(kMagic & 0xFF);
+    record[1] = static_cast<uint8_t>((kMagic >> 8) & 0xFF);
+    record[2] = static_cast<uint8_t>((kMagic >> 16) & 0xFF);
+    record[3] = static_cast<uint8_t>((kMagic >> 24) & 0xFF);
+    record[4] = kVersion;
+    record[5] = Bno055Calibration::SIZE;
+
+    uint8_t* payload = &record[kHeaderSize];
+    for (size_t i = 0; i < 3; i++)
+    {
+        put_i16(&payload[0 + 2 * i], cal.accel_offset[i]);
+        put_i16(&payload[6 + 2 * i], cal.mag_offset[i]);
+        put_i16(&payload[12 + 2 * i], cal.gyro_offset[i]);
+    }
+    put_i16(&payload[18], cal.accel_radius);
+    put_i16(&payload[20], cal.mag_radius);
+
+    const size_t crc_idx = kRecordSize - 2;
+    uint16_t crc = fletcher16(record.data(), crc_idx);
+    record[crc_idx] = static_cast<uint8_t>(crc & 0xFF);
+    record[crc_idx + 1] = static_cast<uint8_t>(crc >> 8);
+
+    if (!flash.sector_erase(block, sector))
+        return false;
+
+    // page_program reads the page back and compares it with the record
+    std::array<uint8_t, kRecordSize> verify{};
+    return flash.page_program(block, sector, 0, 0, record, verify);
+}
+
+}  // namespace MM
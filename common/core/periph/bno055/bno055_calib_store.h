@@ -0,0 +1,65 @@
+/**
+ * @file bno055_calib_store.h
+ * @brief Persistent BNO055 calibration profile storage on W25Q flash
+ * @author Bex Saw
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "bno055_imu.h"
+#include "w25q.h"
+
+namespace MM
+{
+
+/**
+ * @class Bno055CalibrationStore
+ * @brief Saves and loads a Bno055Calibration blob in one W25Q sector
+ * @details The record is written at page 0 of the given sector:
+ *  - magic (4 bytes) and format version (1 byte)
+ *  - payload length (1 byte) and the 22-byte register image
+ *  - Fletcher-16 checksum over everything before it (2 bytes)
+ * A blank (erased) or corrupted sector fails validation, so init() falls
+ * back to the normal power-on calibration.
+ */
+class Bno055CalibrationStore
+{
+public:
+    /**
+     * @brief Construct a new Bno055CalibrationStore object
+     * @param flash W25Q flash instance (must already be initialized)
+     * @param block Block holding the record (0 - 255)
+     * @param sector Sector inside the block (0 - 15), erased on every save
+     */
+    Bno055CalibrationStore(W25q& flash, uint8_t block, uint8_t sector);
+
+    /**
+     * @brief Load and validate the stored calibration profile
+     * @param[out] cal Output profile, untouched on failure
+     * @return true if a valid record was found, false otherwise
+     */
+    bool load(Bno055Calibration& cal);
+
+    /**
+     * @brief Erase the sector and write a new calibration record
+     * @param cal Profile to store
+     * @return true if the record was written and read back correctly
+     */
+    bool save(const Bno055Calibration& cal);
+
+private:
+    static constexpr uint32_t kMagic = 0x4243'4E42u;  // "BNCB"
+    static constexpr uint8_t kVersion = 1;
+    static constexpr size_t kHeaderSize = 6;
+    static constexpr size_t kRecordSize =
+        kHeaderSize + Bno055Calibration::SIZE + 2;
+
+    W25q& flash;
+    uint8_t block;
+    uint8_t sector;
+};
+
+}  // namespace MM
@@ -0,0 +1,234 @@
+#include "bno055_health.h"
+
+namespace MM
+{
+
+static constexpr uint8_t CHIP_ID = 0xA0;
+static constexpr uint8_t SYS_STATUS_ERROR = 0x01;
+
+Bno055Health::Bno055Health(Bno055& imu, I2c& i2c,
+                           const Bno055HealthConfig& config)
+    : imu_(imu),
+      i2c_(i2c),
+      config_(config),
+      stage_(Stage::RUNNING),
+      have_sample_(false),
+      read_failures_(0),
+      i2c_failures_(0),
+      recoveries_(0),
+      last_sys_error_(0),
+      next_status_ms_(0),
+      data_changed_ms_(0),
+      deadline_ms_(0),
+      timeout_ms_(0),
+      last_quat_{0.0f, 0.0f, 0.0f, 0.0f},
+      last_accel_{0.0f, 0.0f, 0.0f},
+      last_gyro_{0.0f, 0.0f, 0.0f}
+{
+}
+
+bool Bno055Health::reached(uint32_t now_ms, uint32_t deadline_ms)
+{
+    return static_cast<int32_t>(now_ms - deadline_ms) >= 0;
+}
+
+ImuQuality Bno055Health::update(uint32_t now_ms, Bno055Data& out)
+{
+    if (stage_ == Stage::RUNNING)
+    {
+        return run(now_ms, out);
+    }
+
+    recover(now_ms);
+    return ImuQuality::INVALID;
+}
+
+ImuQuality Bno055Health::run(uint32_t now_ms, Bno055Data& out)
+{
+    Bno055Data sample;
+    if (!imu_.read_all(sample))
+    {
+        i2c_failures_++;
+        if (++read_failures_ >= config_.max_read_failures)
+        {
+            start_recovery(Stage::BUS_CLEAR, now_ms);
+            return ImuQuality::INVALID;
+        }
+        return have_sample_ ? ImuQuality::STALE : ImuQuality::INVALID;
+    }
+    read_failures_ = 0;
+
+    if (!have_sample_)
+    {
+        // First sample after start or recovery: arm the slow checks
+        have_sample_ = true;
+        data_changed_ms_ = now_ms;
+        next_status_ms_ = now_ms + config_.status_period_ms;
+        last_quat_ = sample.quat;
+        last_accel_ = sample.accel;
+        last_gyro_ = sample.gyro;
+    }
+
+    if (check_frozen(now_ms, sample) || !check_status(now_ms))
+    {
+        start_recovery(Stage::SOFT_RESET, now_ms);
+        return ImuQuality::INVALID;
+    }
+
+    out = sample;
+    return ImuQuality::GOOD;
+}
+
+static bool same(const Vec3& a, const Vec3& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+static bool same(const Quaternion& a, const Quaternion& b)
+{
+    return a.w == b.w && a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+bool Bno055Health::check_frozen(uint32_t now_ms, const Bno055Data& sample)
+{
+    // A stationary mouse can hold the fused quaternion bit-identical for
+    // seconds, so it alone proves nothing. Raw accel and gyro carry sensor
+    // noise of a few LSB, so only all three standing still means the
+    // sensor hub has stopped updating its output registers.
+    if (!same(sample.quat, last_quat_) || !same(sample.accel, last_accel_) ||
+        !same(sample.gyro, last_gyro_))
+    {
+        last_quat_ = sample.quat;
+        last_accel_ = sample.accel;
+        last_gyro_ = sample.gyro;
+        data_changed_ms_ = now_ms;
+        return false;
+    }
+
+    return reached(now_ms, data_changed_ms_ + config_.frozen_timeout_ms);
+}
+
+bool Bno055Health::check_status(uint32_t now_ms)
+{
+    if (!reached(now_ms, next_status_ms_))
+        return true;
+    next_status_ms_ = now_ms + config_.status_period_ms;
+
+    uint8_t sys_status = 0;
+    if (!imu_.get_sys_status(sys_status))
+    {
+        // Bus errors are handled by the read path; don't reset the IMU
+        i2c_failures_++;
+        return true;
+    }
+
+    if (sys_status == SYS_STATUS_ERROR)
+    {
+        imu_.get_sys_error(last_sys_error_);
+        return false;
+    }
+    return true;
+}
+
+void Bno055Health::start_recovery(Stage stage, uint32_t now_ms)
+{
+    stage_ = stage;
+    have_sample_ = false;
+    read_failures_ = 0;
+    deadline_ms_ = now_ms;
+}
+
+void Bno055Health::recover(uint32_t now_ms)
+{
+    switch (stage_)
+    {
+        case Stage::BUS_CLEAR:
+        {
+            // If the bus comes back and the IMU answers, no reset is needed
+            uint8_t id = 0;
+            if (i2c_.bus_clear() && imu_.get_chip_id(id) && id == CHIP_ID)
+            {
+                stage_ = Stage::RUNNING;
+            }
+            else
+            {
+                stage_ = Stage::SOFT_RESET;
+            }
+            break;
+        }
+        case Stage::SOFT_RESET:
+            // A failed write still gets the boot wait; the IMU may have
+            // latched the reset even if the ACK was lost.
+            if (!imu_.soft_reset())
+            {
+                i2c_failures_++;
+            }
+            deadline_ms_ = now_ms + config_.boot_time_ms;
+            timeout_ms_ = now_ms + config_.boot_timeout_ms;
+            stage_ = Stage::WAIT_BOOT;
+            break;
+        case Stage::WAIT_BOOT:
+        {
+            if (!reached(now_ms, deadline_ms_))
+                break;
+
+            uint8_t id = 0;
+            if (imu_.get_chip_id(id) && id == CHIP_ID)
+            {
+                stage_ = Stage::CONFIGURE;
+            }
+            else if (reached(now_ms, timeout_ms_))
+            {
+                // Still silent: clear the bus and start over
+                stage_ = Stage::BUS_CLEAR;
+            }
+            break;
+        }
+        case Stage::CONFIGURE:
+            // RST_SYS leaves the IMU in CONFIG mode, as configure() expects.
+            // Return to whatever mode the application had selected.
+            if (imu_.configure(imu_.operating_mode()))
+            {
+                deadline_ms_ = now_ms + config_.mode_switch_ms;
+                stage_ = Stage::WAIT_MODE;
+            }
+            else
+            {
+                i2c_failures_++;
+                stage_ = Stage::BUS_CLEAR;
+            }
+            break;
+        case Stage::WAIT_MODE:
+            if (reached(now_ms, deadline_ms_))
+            {
+                recoveries_++;
+                stage_ = Stage::RUNNING;
+            }
+            break;
+        case Stage::RUNNING:
+        default:
+            break;
+    }
+}
+
+Bno055Health::Stage Bno055Health::stage() const
+{
+    return stage_;
+}
+
+uint32_t Bno055Health::i2c_failures() const
+{
+    return i2c_failures_;
+}
+
+uint32_t Bno055Health::recoveries() const
+{
+    return recoveries_;
+}
+
+uint8_t Bno055Health::last_sys_error() const
+{
+    return last_sys_error_;
+}
+
+}  // namespace MM
@@ -0,0 +1,141 @@
+/**
+ * @file bno055_health.h
+ * @brief BNO055 health monitoring and non-blocking fault recovery
+ * @author Bex Saw
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "bno055_imu.h"
+#include "i2c.h"
+
+namespace MM
+{
+
+/**
+ * @enum ImuQuality
+ * @brief Quality flag attached to every sample handed to the controller
+ * @details
+ *  - GOOD: fresh sample read this cycle
+ *  - STALE: read failed, output holds the last good sample
+ *  - INVALID: IMU is recovering or has never produced a sample
+ */
+enum class ImuQuality : uint8_t
+{
+    GOOD = 0,
+    STALE,
+    INVALID
+};
+
+/**
+ * @struct Bno055HealthConfig
+ * @brief Thresholds and timings for the health monitor (milliseconds)
+ */
+struct Bno055HealthConfig
+{
+    uint32_t status_period_ms = 1000;  ///< SYS_STATUS/SYS_ERR poll period
+    uint32_t frozen_timeout_ms = 500;  ///< All outputs unchanged => frozen
+    uint8_t max_read_failures = 3;     ///< Consecutive I2C errors tolerated
+    uint32_t boot_time_ms = 650;       ///< Wait after RST_SYS
+    uint32_t boot_timeout_ms = 1000;   ///< CHIP_ID deadline after RST_SYS
+    uint32_t mode_switch_ms = 20;      ///< Wait after the mode switch
+};
+
+/**
+ * @class Bno055Health
+ * @brief Health layer over Bno055 for use from the main loop
+ * @details Every call to update() does at most one short I2C transaction
+ * set and never sleeps. Faults escalate through recovery stages:
+ *  1. Bus clear: recovers from I2C errors if the IMU itself is fine
+ *  2. Soft reset: RST_SYS, then wait for boot without blocking
+ *  3. Re-init: power/page setup, calibration restore, and back to the
+ *     operating mode the IMU was in (Bno055::operating_mode())
+ * A SYS_STATUS error or frozen output registers skip straight to stage 2.
+ * The registers count as frozen when the quaternion and the raw accel
+ * and gyro all stay bit-identical. A still mouse can hold its quaternion,
+ * but raw sensor noise keeps the other two moving while the hub runs.
+ */
+class Bno055Health
+{
+public:
+    /**
+     * @enum Stage
+     * @brief Recovery state machine stage
+     */
+    enum class Stage : uint8_t
+    {
+        RUNNING = 0,
+        BUS_CLEAR,
+        SOFT_RESET,
+        WAIT_BOOT,
+        CONFIGURE,
+        WAIT_MODE
+    };
+
+    /**
+     * @brief Construct a new Bno055Health object
+     * @param imu IMU driver (already initialized)
+     * @param i2c Bus the IMU is on, used for bus recovery
+     * @param config Monitor thresholds
+     */
+    Bno055Health(Bno055& imu, I2c& i2c, const Bno055HealthConfig& config = {});
+
+    /**
+     * @brief Read a sample and advance health checks/recovery by one step
+     * @param now_ms Current time in milliseconds (wrap-around safe)
+     * @param[out] out Latest good sample (kept on STALE/INVALID)
+     * @return Quality of the data in out
+     */
+    ImuQuality update(uint32_t now_ms, Bno055Data& out);
+
+    /**
+     * @brief Current recovery stage
+     */
+    Stage stage() const;
+
+    /**
+     * @brief Total failed I2C transactions since construction
+     */
+    uint32_t i2c_failures() const;
+
+    /**
+     * @brief Number of completed soft-reset recoveries
+     */
+    uint32_t recoveries() const;
+
+    /**
+     * @brief Last SYS_ERR value read while SYS_STATUS reported an error
+     */
+    uint8_t last_sys_error() const;
+
+private:
+    static bool reached(uint32_t now_ms, uint32_t deadline_ms);
+
+    ImuQuality run(uint32_t now_ms, Bno055Data& out);
+    void recover(uint32_t now_ms);
+    void start_recovery(Stage stage, uint32_t now_ms);
+    bool check_status(uint32_t now_ms);
+    bool check_frozen(uint32_t now_ms, const Bno055Data& sample);
+
+    Bno055& imu_;
+    I2c& i2c_;
+    Bno055HealthConfig config_;
+
+    Stage stage_;
+    bool have_sample_;
+    uint8_t read_failures_;
+    uint32_t i2c_failures_;
+    uint32_t recoveries_;
+    uint8_t last_sys_error_;
+    uint32_t next_status_ms_;
+    uint32_t data_changed_ms_;
+    uint32_t deadline_ms_;
+    uint32_t timeout_ms_;
+    Quaternion last_quat_;
+    Vec3 last_accel_;
+    Vec3 last_gyro_;
+};
+
+}  // namespace MM
@@ -3,11 +3,13 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include "bno055_calib_store.h"
 
 namespace MM
 {
 
-Bno055::Bno055(MM::I2c& i2c, uint8_t addr) : i2c_(i2c), address_(addr)
+Bno055::Bno055(MM::I2c& i2c, uint8_t addr, Bno055CalibrationStore* store)
+    : i2c_(i2c), address_(addr), store_(store), operating_mode_(IMU)
 {
 }
 
@@ -18,8 +20,7 @@ Bno055::Bno055(MM::I2c& i2c, uint8_t addr) : i2c_(i2c), address_(addr)
  */
 bool Bno055::set_mode(Mode mode)
 {
-    uint8_t buf = static_cast<uint8_t>(mode);
-    bool ok = i2c_.mem_write(&buf, 1, REG_OPR_MODE, address_);
+    bool ok = write_mode(mode);
     // Per BNO055 datasheet, a delay is required after changing OPR_MODE
     // to allow the sensor to switch modes and stabilize.
     MM::Utils::DelayMs(30);
@@ -49,14 +50,50 @@ void Bno055::init()
     // Per BNO055 datasheet, delay after switching to CONFIG mode.
     MM::Utils::DelayMs(25);
 
+    configure(Bno055::IMU);
+    // Per BNO055 datasheet, delay after switching to IMU mode.
+    MM::Utils::DelayMs(20);
+}
+
+bool Bno055::configure(Mode mode)
+{
     uint8_t pwr_mode = 0x00;
-    i2c_.mem_write(&pwr_mode, 1, 0x3E, address_);  // PWR_MODE = 0x3E
+    bool ok = i2c_.mem_write(&pwr_mode, 1, 0x3E, address_);  // PWR_MODE = 0x3E
     uint8_t page_id = 0x00;
-    i2c_.mem_write(&page_id, 1, 0x07, address_);  // PAGE_ID = 0x07
+    ok = i2c_.mem_write(&page_id, 1, 0x07, address_) && ok;  // PAGE_ID = 0x07
 
-    set_mode(Bno055::IMU);
-    // Per BNO055 datasheet, delay after switching to IMU mode.
-    MM::Utils::DelayMs(20);
+    // Restore a saved offset profile so heading is usable without the
+    // calibration motions. Offsets can only be written in CONFIG mode.
+    Bno055Calibration cal{};
+    if (store_ != nullptr && store_->load(cal))
+    {
+        ok = write_calibration_regs(cal) && ok;
+    }
+
+    return write_mode(mode) && ok;
+}
+
+bool Bno055::write_mode(Mode mode)
+{
+    if (mode != CONFIG)
+    {
+        operating_mode_ = mode;
+    }
+    uint8_t buf = static_cast<uint8_t>(mode);
+    return i2c_.mem_write(&buf, 1, REG_OPR_MODE, address_);
+}
+
+Bno055::Mode Bno055::operating_mode() const
+{
+    return operating_mode_;
+}
+
+bool Bno055::soft_reset()
+{
+    static constexpr uint8_t SYS_TRIGGER_REG = 0x3F;  // SYS_TRIGGER register
+    static constexpr uint8_t RST_SYS = 0x20;
+    uint8_t sys_trigger = RST_SYS;
+    return i2c_.mem_write(&sys_trigger, 1, SYS_TRIGGER_REG, address_);
 }
 
 /**
@@ -81,6 +118,12 @@ static inline int16_t combine(uint8_t lsb, uint8_t msb)
 {
     return (static_cast<int16_t>(msb) << 8) | lsb;
 }
+
+static inline void split(uint8_t* dst, int16_t value)
+{
+    dst[0] = static_cast<uint8_t>(value & 0xFF);
+    dst[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+}
 /**
  * @brief Read all sensor data from the IMU
  * @param[out] out Output struct for sensor data
@@ -89,25 +132,35 @@ static inline int16_t combine(uint8_t lsb, uint8_t msb)
  */
 bool Bno055::read_all(Bno055Data& out)
 {
-    uint8_t buf[6 + 6 + 6 + 6 + 8];  // ACC + GYR + LIA + GRAV + QUAT
-    size_t idx = 0;
+    // ACC, MAG, GYR, EUL, QUA, LIA, GRV: 0x08 to 0x33 in one burst
+    uint8_t buf[6 + 6 + 6 + 6 + 8 + 6 + 6];
 
-    // Read everything starting from ACC register (0x08)
-    i2c_.mem_read(buf, sizeof(buf), 0x08, address_);
+    // Leave the output untouched on a bus error so callers never see a
+    // half-parsed sample.
+    if (!i2c_.mem_read(buf, sizeof(buf), 0x08, address_))
+        return false;
 
     // Parse accel
     constexpr float ACCEL_SCALE = 100.0f;
     out.accel.x = combine(buf[0], buf[1]) / ACCEL_SCALE;
     out.accel.y = combine(buf[2], buf[3]) / ACCEL_SCALE;
     out.accel.z = combine(buf[4], buf[5]) / ACCEL_SCALE;
-    idx += 12;  // Skip accel (6) + mag (6)
+    size_t idx = 12;  // Skip accel (6) + mag (6)
 
     // Parse gyro
     constexpr float GYRO_SCALE = 16.0f;
     out.gyro.x = combine(buf[idx + 0], buf[idx + 1]) / GYRO_SCALE;
     out.gyro.y = combine(buf[idx + 2], buf[idx + 3]) / GYRO_SCALE;
     out.gyro.z = combine(buf[idx + 4], buf[idx + 5]) / GYRO_SCALE;
-    idx += 6;
+    idx += 12;  // Gyro (6) + Euler (6)
+
+    // Parse quaternion
+    constexpr float QUAT_SCALE = 16384.0f;
+    out.quat.w = combine(buf[idx + 0], buf[idx + 1]) / QUAT_SCALE;
+    out.quat.x = combine(buf[idx + 2], buf[idx + 3]) / QUAT_SCALE;
+    out.quat.y = combine(buf[idx + 4], buf[idx + 5]) / QUAT_SCALE;
+    out.quat.z = combine(buf[idx + 6], buf[idx + 7]) / QUAT_SCALE;
+    idx += 8;
 
     // Parse linear accel
     out.linear_accel.x = combine(buf[idx + 0], buf[idx + 1]) / ACCEL_SCALE;
@@ -119,15 +172,42 @@ bool Bno055::read_all(Bno055Data& out)
     out.gravity.x = combine(buf[idx + 0], buf[idx + 1]) / ACCEL_SCALE;
     out.gravity.y = combine(buf[idx + 2], buf[idx + 3]) / ACCEL_SCALE;
     out.gravity.z = combine(buf[idx + 4], buf[idx + 5]) / ACCEL_SCALE;
-    idx += 6;
 
-    // Parse quaternion
-    constexpr float QUAT_SCALE = 16384.0f;
-    out.quat.w = combine(buf[idx + 0], buf[idx + 1]) / QUAT_SCALE;
-    out.quat.x = combine(buf[idx + 2], buf[idx + 3]) / QUAT_SCALE;
-    out.quat.y = combine(buf[idx + 4], buf[idx + 5]) / QUAT_SCALE;
-    out.quat.z = combine(buf[idx + 6], buf[idx + 7]) / QUAT_SCALE;
+    return true;
+}
 
+bool Bno055::read_accel_gyro(Vec3& accel, Vec3& gyro)
+{
+    uint8_t buf[6 + 6 + 6];  // ACC + MAG + GYR
+    if (!i2c_.mem_read(buf, sizeof(buf), 0x08, address_))
+        return false;
+
+    constexpr float ACCEL_SCALE = 100.0f;
+    accel.x = combine(buf[0], buf[1]) / ACCEL_SCALE;
+    accel.y = combine(buf[2], buf[3]) / ACCEL_SCALE;
+    accel.z = combine(buf[4], buf[5]) / ACCEL_SCALE;
+
+    constexpr float GYRO_SCALE = 16.0f;
+    gyro.x = combine(buf[12], buf[13]) / GYRO_SCALE;
+    gyro.y = combine(buf[14], buf[15]) / GYRO_SCALE;
+    gyro.z = combine(buf[16], buf[17]) / GYRO_SCALE;
+    return true;
+}
+
+bool Bno055::read_raw(Bno055RawData& out)
+{
+    uint8_t buf[6 + 6 + 8];  // GYR + EUL + QUA
+    if (!i2c_.mem_read(buf, sizeof(buf), 0x14, address_))
+        return false;
+
+    out.gyro.x = Q4::from_raw(combine(buf[0], buf[1]));
+    out.gyro.y = Q4::from_raw(combine(buf[2], buf[3]));
+    out.gyro.z = Q4::from_raw(combine(buf[4], buf[5]));
+
+    out.quat.w = Q14::from_raw(combine(buf[12], buf[13]));
+    out.quat.x = Q14::from_raw(combine(buf[14], buf[15]));
+    out.quat.y = Q14::from_raw(combine(buf[16], buf[17]));
+    out.quat.z = Q14::from_raw(combine(buf[18], buf[19]));
     return true;
 }
 
@@ -137,6 +217,86 @@ bool Bno055::calibrate(uint8_t& value)
     return i2c_.mem_read(&value, 1, CALIB_STAT_REG, address_);
 }
 
+bool Bno055::read_calibration_regs(Bno055Calibration& cal)
+{
+    uint8_t buf[Bno055Calibration::SIZE];
+    if (!i2c_.mem_read(buf, sizeof(buf), REG_CALIB_START, address_))
+        return false;
+
+    // Register order: ACC_OFFSET, MAG_OFFSET, GYR_OFFSET (x, y, z each),
+    // then ACC_RADIUS and MAG_RADIUS, all little endian.
+    for (size_t i = 0; i < 3; i++)
+    {
+        cal.accel_offset[i] = combine(buf[0 + 2 * i], buf[1 + 2 * i]);
+        cal.mag_offset[i] = combine(buf[6 + 2 * i], buf[7 + 2 * i]);
+        cal.gyro_offset[i] = combine(buf[12 + 2 * i], buf[13 + 2 * i]);
+    }
+    cal.accel_radius = combine(buf[18], buf[19]);
+    cal.mag_radius = combine(buf[20], buf[21]);
+    return true;
+}
+
+bool Bno055::write_calibration_regs(const Bno055Calibration& cal)
+{
+    uint8_t buf[Bno055Calibration::SIZE];
+    for (size_t i = 0; i < 3; i++)
+    {
+        split(&buf[0 + 2 * i], cal.accel_offset[i]);
+        split(&buf[6 + 2 * i], cal.mag_offset[i]);
+        split(&buf[12 + 2 * i], cal.gyro_offset[i]);
+    }
+    split(&buf[18], cal.accel_radius);
+    split(&buf[20], cal.mag_radius);
+
+    return i2c_.mem_write(buf, sizeof(buf), REG_CALIB_START, address_);
+}
+
+bool Bno055::read_calibration(Bno055Calibration& cal)
+{
+    Mode prev = Bno055::CONFIG;
+    if (!get_opr_mode(prev))
+        return false;
+
+    set_mode(Bno055::CONFIG);
+    bool ok = read_calibration_regs(cal);
+    if (prev != Bno055::CONFIG)
+    {
+        ok = set_mode(prev) && ok;
+    }
+    return ok;
+}
+
+bool Bno055::write_calibration(const Bno055Calibration& cal)
+{
+    Mode prev = Bno055::CONFIG;
+    if (!get_opr_mode(prev))
+        return false;
+
+    set_mode(Bno055::CONFIG);
+    bool ok = write_calibration_regs(cal);
+    if (prev != Bno055::CONFIG)
+    {
+        ok = set_mode(prev) && ok;
+    }
+    return ok;
+}
+
+bool Bno055::save_calibration()
+{
+    if (store_ == nullptr)
+        return false;
+
+    uint8_t calib_stat = 0;
+    if (!calibrate(calib_stat) || !is_calibrated(calib_stat))
+        return false;
+
+    Bno055Calibration cal{};
+    if (!read_calibration(cal))
+        return false;
+
+    return store_->save(cal);
+}
+
 bool Bno055::get_sys_status(uint8_t& value)
 {
     static constexpr uint8_t SYS_STATUS_REG = 0x39;  // SYS_STATUS register
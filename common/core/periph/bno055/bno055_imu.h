@@ -10,6 +10,7 @@
 #include <cstddef>
 #include <cstdint>
 #include "delay.h"
+#include "fixed_point.h"
 #include "i2c.h"
 #include "imu_math.h"
 
@@ -35,6 +36,38 @@ struct Bno055Data
     Quaternion quat;
 };
 
+/**
+ * @struct Bno055RawData
+ * @brief Gyro and quaternion in the sensor's native fixed-point formats
+ * @details The register LSBs already are Q-format numbers (gyro 1/16 dps,
+ * quaternion 1/2^14), so no float conversion is needed on the hot path.
+ */
+struct Bno055RawData
+{
+    QVec3<Q4> gyro;
+    QQuaternion<Q14> quat;
+};
+
+/**
+ * @struct Bno055Calibration
+ * @brief Sensor offset/radius profile (registers 0x55..0x6A)
+ * @details Raw register values in the units of the currently selected
+ * UNIT_SEL setting. Restoring this profile on boot skips the manual
+ * calibration motions the BNO055 otherwise needs after every power-up.
+ */
+struct Bno055Calibration
+{
+    int16_t accel_offset[3];
+    int16_t mag_offset[3];
+    int16_t gyro_offset[3];
+    int16_t accel_radius;
+    int16_t mag_radius;
+
+    static constexpr size_t SIZE = 22;  ///< Bytes in the register block
+};
+
+class Bno055CalibrationStore;
+
 /**
  * @class Bno055
  * @brief BNO055 IMU interface (generic over I2c)
@@ -52,6 +85,7 @@ public:
     enum Mode : uint8_t
     {
         CONFIG = 0x00,
+        AMG = 0x07,  ///< Raw accel/mag/gyro, no on-chip fusion
         IMU = 0x08,
         NDOF = 0x0C
     };
@@ -59,6 +93,9 @@ public:
     static constexpr uint8_t REG_OPR_MODE =
         0x3D;  ///< OPR_MODE register address
 
+    static constexpr uint8_t REG_CALIB_START =
+        0x55;  ///< ACC_OFFSET_X_LSB, first calibration register
+
     static constexpr uint8_t ADDR_PRIMARY = 0x28;    ///< Default I2C Address
     static constexpr uint8_t ADDR_ALTERNATE = 0x29;  ///< Alternate I2C Address
 
@@ -66,8 +103,11 @@ public:
      * @brief Construct a new Bno055 object
      * @param i2c Reference to I2c interface
      * @param addr I2C address (default: ADDR_PRIMARY)
+     * @param store Optional persistent calibration store; when set, init()
+     *        restores a saved profile and save_calibration() can write one
      */
-    explicit Bno055(MM::I2c& i2c, uint8_t addr = ADDR_PRIMARY);
+    explicit Bno055(MM::I2c& i2c, uint8_t addr = ADDR_PRIMARY,
+                    Bno055CalibrationStore* store = nullptr);
 
     /**
      * @brief Set the IMU operating mode.
@@ -76,11 +116,44 @@ public:
      */
     bool set_mode(Mode mode);
 
+    /**
+     * @brief Write OPR_MODE without waiting for the switch to complete
+     * @details The caller must wait 7 ms (CONFIG to operating) or 19 ms
+     * (operating to CONFIG) before relying on the new mode.
+     * @param mode Mode enum
+     * @return true if successful, false otherwise
+     */
+    bool write_mode(Mode mode);
+
+    /**
+     * @brief Operating mode last requested, i.e. the one to return to
+     * @details CONFIG is never recorded, so this survives the temporary
+     * switches of read_calibration() and write_calibration().
+     */
+    Mode operating_mode() const;
+
     /**
      * @brief Initialize and configure the IMU
      */
     void init();
 
+    /**
+     * @brief Apply power/page settings, restore calibration and enter a mode
+     * @details Must be called in CONFIG mode. Does not block; the caller
+     * waits for the mode switch (see write_mode()).
+     * @param mode Operating mode to enter once configured
+     * @return true if every register write succeeded, false otherwise
+     */
+    bool configure(Mode mode);
+
+    /**
+     * @brief Trigger a system reset through SYS_TRIGGER (RST_SYS)
+     * @details Does not block; the device needs about 650 ms before it
+     * answers again and comes back in CONFIG mode.
+     * @return true if the reset command was written, false otherwise
+     */
+    bool soft_reset();
+
     /**
      * @brief Deinitialize the IMU and put it in low-power mode
      * @note @TJMalaska Check this function
@@ -94,6 +167,24 @@ public:
      */
     bool read_all(Bno055Data& out);
 
+    /**
+     * @brief Read only the raw accelerometer and gyroscope
+     * @details Single 18-byte burst (ACC, MAG, GYR) for host-side fusion in
+     * AMG mode, where the fused registers are not updated anyway.
+     * @param[out] accel Acceleration (m/s^2)
+     * @param[out] gyro Angular velocity (same units as read_all)
+     * @return true if successful, false otherwise
+     */
+    bool read_accel_gyro(Vec3& accel, Vec3& gyro);
+
+    /**
+     * @brief Read gyro and quaternion without converting to float
+     * @details Single 20-byte burst (GYR, EUL, QUA) starting at 0x14.
+     * @param[out] out Output struct in Q4 / Q14
+     * @return true if successful, false otherwise
+     */
+    bool read_raw(Bno055RawData& out);
+
     /**
      * @brief Get IMU calibration status
      * @param[out] value Output calibration status
@@ -101,6 +192,45 @@ public:
      */
     bool calibrate(uint8_t& value);
 
+    /**
+     * @brief Check whether a CALIB_STAT value is good enough to save
+     * @details IMU mode does not use the magnetometer, so only the gyro and
+     * accelerometer fields (bits 5:4 and 3:2) need to be fully calibrated.
+     * @param calib_stat Value read by calibrate()
+     * @return true if gyro and accel are both at level 3
+     */
+    static constexpr bool is_calibrated(uint8_t calib_stat)
+    {
+        return ((calib_stat >> 4) & 0x03) == 0x03 &&
+               ((calib_stat >> 2) & 0x03) == 0x03;
+    }
+
+    /**
+     * @brief Read the offset/radius profile from the IMU
+     * @details Temporarily switches to CONFIG mode and restores the
+     * previous operating mode afterwards.
+     * @param[out] cal Output calibration profile
+     * @return true if successful, false otherwise
+     */
+    bool read_calibration(Bno055Calibration& cal);
+
+    /**
+     * @brief Write an offset/radius profile to the IMU
+     * @details Temporarily switches to CONFIG mode and restores the
+     * previous operating mode afterwards.
+     * @param cal Calibration profile to load
+     * @return true if successful, false otherwise
+     */
+    bool write_calibration(const Bno055Calibration& cal);
+
+    /**
+     * @brief Persist the current profile to the calibration store
+     * @return true if the IMU is calibrated and the profile was saved,
+     *         false if there is no store, the IMU is not yet calibrated,
+     *         or the read/write failed
+     */
+    bool save_calibration();
+
     /**
      * @brief Get IMU system status
      * @param[out] value Output system status
@@ -144,8 +274,16 @@ public:
     bool get_opr_mode(Mode& mode);
 
 private:
-    MM::I2c& i2c_;     ///< Reference to I2c interface
-    uint8_t address_;  ///< I2C address
+    /**
+     * @brief Burst read/write the calibration block (CONFIG mode only)
+     */
+    bool read_calibration_regs(Bno055Calibration& cal);
+    bool write_calibration_regs(const Bno055Calibration& cal);
+
+    MM::I2c& i2c_;                   ///< Reference to I2c interface
+    uint8_t address_;                ///< I2C address
+    Bno055CalibrationStore* store_;  ///< Optional calibration store
+    Mode operating_mode_;            ///< Last non-CONFIG mode requested
 };
 
 }  // namespace MM
\ No newline at end of file
@@ -0,0 +1,357 @@
+/**
+ * @file sim_bno055.h
+ * @brief Host model of a BNO055 on an I2C bus
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Runs on the simulated native timebase and models what the
+ * driver relies on:
+ *  - It does not ACK for kBootMs after power-up or RST_SYS, and comes
+ *    back in CONFIG mode with the offset registers cleared.
+ *  - Offset registers (0x55..0x6A) only accept writes in CONFIG mode.
+ *  - CALIB_STAT rises with the time spent in a fusion mode. From scratch
+ *    the gyro needs kGyroCalMs standing still and the accelerometer
+ *    kAccelCalMs of poses; the offsets then read back as the device's
+ *    profile. If that profile was written back in CONFIG mode, both reach
+ *    level 3 after kRestoredCalMs.
+ *  - Output registers hold a mouse standing level: the quaternion is
+ *    constant, the raw accelerometer and gyro carry 1 LSB noise.
+ *
+ * Faults can be injected for the health monitor: NACKs, a slave holding
+ * SDA low, a silent device, a SYS_STATUS error and stalled outputs.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "bno055_imu.h"
+#include "i2c.h"
+#include "timebase.h"
+
+namespace MM
+{
+
+class SimBno055 : public I2c
+{
+public:
+    static constexpr uint32_t kBootMs = 650;
+    static constexpr uint32_t kGyroCalMs = 3000;
+    static constexpr uint32_t kAccelCalMs = 15000;
+    static constexpr uint32_t kRestoredCalMs = 400;
+
+    /**
+     * @param profile_ Offsets the device converges to when calibrated
+     */
+    explicit SimBno055(const Bno055Calibration& profile_,
+                       uint8_t address_ = Bno055::ADDR_PRIMARY)
+        : address(address_)
+    {
+        pack(profile_, profile.data());
+        power_cycle();
+    }
+
+    /**
+     * @brief Power the device off and on again
+     */
+    void power_cycle()
+    {
+        regs.fill(0);
+        regs[REG_CHIP_ID] = 0xA0;
+        regs[REG_ST_RESULT] = 0x0F;
+        boot(Utils::now_ms());
+    }
+
+    /**
+     * @brief NACK the next @p count transactions
+     */
+    void fail_next(uint32_t count)
+    {
+        fail_count = count;
+    }
+
+    /**
+     * @brief Hold SDA low; every transaction fails until bus_clear()
+     */
+    void hold_sda()
+    {
+        sda_held = true;
+    }
+
+    /**
+     * @brief Stop answering for @p ms, e.g. during a brown-out
+     */
+    void go_silent(uint32_t ms)
+    {
+        silent_until_ms = Utils::now_ms() + ms;
+    }
+
+    /**
+     * @brief Report a system error (SYS_STATUS = 1) until the next reset
+     */
+    void raise_sys_error(uint8_t code)
+    {
+        sys_error = code;
+    }
+
+    /**
+     * @brief Stop updating the output registers until the next reset
+     */
+    void stall_outputs()
+    {
+        stalled = true;
+    }
+
+    bool mem_read(uint8_t* data, size_t len, const uint8_t reg_addr,
+                  uint8_t dev_addr) override
+    {
+        if (!acks(dev_addr) || reg_addr + len > regs.size())
+            return false;
+
+        refresh();
+        for (size_t i = 0; i < len; i++)
+            data[i] = regs[reg_addr + i];
+        return true;
+    }
+
+    bool mem_write(const uint8_t* data, size_t len, const uint8_t reg_addr,
+                   uint8_t dev_addr) override
+    {
+        if (!acks(dev_addr) || reg_addr + len > regs.size())
+            return false;
+
+        for (size_t i = 0; i < len; i++)
+            write_reg(static_cast<uint8_t>(reg_addr + i), data[i]);
+        return true;
+    }
+
+    bool read(uint8_t*, size_t, uint8_t) override
+    {
+        return false;
+    }
+
+    bool write(const uint8_t*, size_t, uint8_t) override
+    {
+        return false;
+    }
+
+    bool bus_clear() override
+    {
+        clears++;
+        sda_held = false;
+        return true;
+    }
+
+    uint8_t mode() const
+    {
+        return regs[Bno055::REG_OPR_MODE];
+    }
+
+    /**
+     * @brief Number of RST_SYS commands received
+     */
+    uint32_t resets() const
+    {
+        return reset_count;
+    }
+
+    uint32_t bus_clears() const
+    {
+        return clears;
+    }
+
+private:
+    static constexpr uint8_t REG_CHIP_ID = 0x00;
+    static constexpr uint8_t REG_ACC_DATA = 0x08;
+    static constexpr uint8_t REG_GYR_DATA = 0x14;
+    static constexpr uint8_t REG_QUA_DATA = 0x20;
+    static constexpr uint8_t REG_GRV_DATA = 0x2E;
+    static constexpr uint8_t REG_CALIB_STAT = 0x35;
+    static constexpr uint8_t REG_ST_RESULT = 0x36;
+    static constexpr uint8_t REG_SYS_STATUS = 0x39;
+    static constexpr uint8_t REG_SYS_ERR = 0x3A;
+    static constexpr uint8_t REG_SYS_TRIGGER = 0x3F;
+    static constexpr uint8_t RST_SYS = 0x20;
+    static constexpr int16_t kGravityLsb = 981;  // 9.81 m/s^2 at 100 LSB
+    static constexpr int16_t kQuatOne = 16384;
+
+    static void put(uint8_t* dst, int16_t value)
+    {
+        dst[0] = static_cast<uint8_t>(value & 0xFF);
+        dst[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+    }
+
+    static void pack(const Bno055Calibration& cal, uint8_t* dst)
+    {
+        for (size_t i = 0; i < 3; i++)
+        {
+            put(&dst[0 + 2 * i], cal.accel_offset[i]);
+            put(&dst[6 + 2 * i], cal.mag_offset[i]);
+            put(&dst[12 + 2 * i], cal.gyro_offset[i]);
+        }
+        put(&dst[18], cal.accel_radius);
+        put(&dst[20], cal.mag_radius);
+    }
+
+    static uint8_t level(uint32_t spent_ms, uint32_t full_ms)
+    {
+        return spent_ms >= full_ms ? 3 : spent_ms * 3 / full_ms;
+    }
+
+    bool acks(uint8_t dev_addr)
+    {
+        const uint32_t now = Utils::now_ms();
+        if (sda_held || !Utils::reached(silent_until_ms, now))
+            return false;
+        if (fail_count > 0)
+        {
+            fail_count--;
+            return false;
+        }
+        return dev_addr == address && Utils::reached(boot_done_ms, now);
+    }
+
+    bool fusing() const
+    {
+        return mode() != Bno055::CONFIG;
+    }
+
+    void boot(uint32_t now_ms)
+    {
+        boot_done_ms = now_ms + kBootMs;
+        regs[Bno055::REG_OPR_MODE] = Bno055::CONFIG;
+        for (size_t i = 0; i < Bno055Calibration::SIZE; i++)
+            regs[Bno055::REG_CALIB_START + i] = 0;
+        fusion_ms = 0;
+        restored = false;
+        calibrated = false;
+        sys_error = 0;
+        stalled = false;
+    }
+
+    uint32_t fusion_time() const
+    {
+        return fusion_ms +
+               (fusing() ? Utils::now_ms() - fusion_since_ms : 0);
+    }
+
+    void write_reg(uint8_t reg, uint8_t value)
+    {
+        const bool calib_reg = reg >= Bno055::REG_CALIB_START &&
+                               reg < Bno055::REG_CALIB_START +
+                                         Bno055Calibration::SIZE;
+        if (calib_reg)
+        {
+            if (fusing())
+                return;  // Read-only outside CONFIG mode
+            regs[reg] = value;
+            restored = calibration_matches();
+            return;
+        }
+
+        if (reg == Bno055::REG_OPR_MODE)
+        {
+            const bool was_fusing = fusing();
+            const uint32_t now = Utils::now_ms();
+            regs[reg] = value & 0x0F;
+            if (was_fusing && !fusing())
+                fusion_ms += now - fusion_since_ms;
+            else if (!was_fusing && fusing())
+                fusion_since_ms = now;
+            return;
+        }
+
+        if (reg == REG_SYS_TRIGGER)
+        {
+            if ((value & RST_SYS) != 0)
+            {
+                reset_count++;
+                boot(Utils::now_ms());
+            }
+            return;
+        }
+
+        regs[reg] = value;
+    }
+
+    bool calibration_matches() const
+    {
+        for (size_t i = 0; i < Bno055Calibration::SIZE; i++)
+        {
+            if (regs[Bno055::REG_CALIB_START + i] != profile[i])
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Update the computed registers before a read
+     */
+    void refresh()
+    {
+        const uint32_t spent = fusion_time();
+        const uint8_t gyro =
+            level(spent, restored ? kRestoredCalMs : kGyroCalMs);
+        const uint8_t accel =
+            level(spent, restored ? kRestoredCalMs : kAccelCalMs);
+        const uint8_t sys = gyro < accel ? gyro : accel;
+        regs[REG_CALIB_STAT] =
+            static_cast<uint8_t>((sys << 6) | (gyro << 4) | (accel << 2));
+
+        // Converged offsets become readable in CONFIG mode
+        if (!calibrated && sys == 3)
+        {
+            calibrated = true;
+            for (size_t i = 0; i < Bno055Calibration::SIZE; i++)
+                regs[Bno055::REG_CALIB_START + i] = profile[i];
+        }
+
+        // 1: system error, 5: fusion running, 0: idle
+        regs[REG_SYS_STATUS] = sys_error != 0 ? 1 : (fusing() ? 5 : 0);
+        regs[REG_SYS_ERR] = sys_error;
+        if (fusing() && !stalled)
+            sample();
+    }
+
+    /**
+     * @brief One output sample of a mouse standing level
+     */
+    void sample()
+    {
+        // Small LCG, so runs are repeatable
+        auto noise = [this]() {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<int16_t>((seed >> 30) % 3) - 1;
+        };
+
+        put(&regs[REG_ACC_DATA + 0], noise());
+        put(&regs[REG_ACC_DATA + 2], noise());
+        put(&regs[REG_ACC_DATA + 4], kGravityLsb + noise());
+        for (size_t axis = 0; axis < 3; axis++)
+            put(&regs[REG_GYR_DATA + 2 * axis], noise());
+
+        put(&regs[REG_QUA_DATA + 0], kQuatOne);
+        put(&regs[REG_QUA_DATA + 2], 0);
+        put(&regs[REG_QUA_DATA + 4], 0);
+        put(&regs[REG_QUA_DATA + 6], 0);
+        put(&regs[REG_GRV_DATA + 4], kGravityLsb);
+    }
+
+    const uint8_t address;
+    std::array<uint8_t, Bno055Calibration::SIZE> profile{};
+    std::array<uint8_t, 0x80> regs{};
+    uint32_t boot_done_ms = 0;
+    uint32_t fusion_ms = 0;
+    uint32_t fusion_since_ms = 0;
+    uint32_t reset_count = 0;
+    uint32_t clears = 0;
+    uint32_t fail_count = 0;
+    uint32_t silent_until_ms = 0;
+    uint32_t seed = 1;
+    uint8_t sys_error = 0;
+    bool restored = false;
+    bool calibrated = false;
+    bool sda_held = false;
+    bool stalled = false;
+};
+
+}  // namespace MM
@@ -0,0 +1,172 @@
+/**
+ * @file bno055_calib_test.cc
+ * @brief Calibration save/restore against the simulated BNO055 and W25Q
+ * @author Bex Saw
+ * @date 2026-10-18
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include "bno055_calib_store.h"
+#include "bno055_imu.h"
+#include "sim_bno055.h"
+#include "sim_gpio.h"
+#include "sim_w25q.h"
+#include "timebase.h"
+
+namespace MM
+{
+namespace
+{
+
+constexpr Bno055Calibration kProfile{.accel_offset = {-12, 25, 7},
+                                     .mag_offset = {150, -80, 40},
+                                     .gyro_offset = {-2, 1, 3},
+                                     .accel_radius = 1000,
+                                     .mag_radius = 700};
+
+constexpr uint8_t kBlock = 0;
+constexpr uint8_t kSector = 1;
+constexpr uint32_t kTimeoutMs = 60000;
+
+bool same(const Bno055Calibration& a, const Bno055Calibration& b)
+{
+    for (size_t i = 0; i < 3; i++)
+    {
+        if (a.accel_offset[i] != b.accel_offset[i] ||
+            a.mag_offset[i] != b.mag_offset[i] ||
+            a.gyro_offset[i] != b.gyro_offset[i])
+            return false;
+    }
+    return a.accel_radius == b.accel_radius && a.mag_radius == b.mag_radius;
+}
+
+class Bno055CalibTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Utils::timebase_init(Utils::TimebaseConfig{});
+        ASSERT_TRUE(flash.init());
+    }
+
+    /**
+     * @brief Power the IMU on and time init() until CALIB_STAT is good
+     * @return Milliseconds from power-up, or kTimeoutMs
+     */
+    uint32_t startup_to_calibrated()
+    {
+        const uint32_t start = Utils::now_ms();
+        device.power_cycle();
+        imu.init();
+
+        uint8_t stat = 0;
+        while (Utils::now_ms() - start < kTimeoutMs)
+        {
+            if (imu.calibrate(stat) && Bno055::is_calibrated(stat))
+                return Utils::now_ms() - start;
+            Utils::DelayMs(10);
+        }
+        return kTimeoutMs;
+    }
+
+    SimW25q spi;
+    SimGpio cs_pin;
+    GpioChipSelect cs{cs_pin};
+    W25q flash{spi, cs};
+    Bno055CalibrationStore store{flash, kBlock, kSector};
+
+    SimBno055 device{kProfile};
+    Bno055 imu{device, Bno055::ADDR_PRIMARY, &store};
+};
+
+TEST_F(Bno055CalibTest, StoreRoundTrip)
+{
+    ASSERT_TRUE(store.save(kProfile));
+
+    Bno055Calibration loaded{};
+    ASSERT_TRUE(store.load(loaded));
+    EXPECT_TRUE(same(loaded, kProfile));
+    EXPECT_EQ(spi.erase_count(), 1u);
+}
+
+TEST_F(Bno055CalibTest, BlankSectorIsRejected)
+{
+    Bno055Calibration loaded{};
+    loaded.accel_radius = 42;
+    EXPECT_FALSE(store.load(loaded));
+    EXPECT_EQ(loaded.accel_radius, 42);  // Untouched on failure
+}
+
+TEST_F(Bno055CalibTest, CorruptRecordIsRejected)
+{
+    ASSERT_TRUE(store.save(kProfile));
+
+    // Flip one payload bit behind the store's back
+    const uint32_t record = kBlock * SimW25q::kBlockSizeBytes +
+                            kSector * SimW25q::kSectorSizeBytes;
+    spi.contents()[record + 10] ^= 0x04;
+
+    Bno055Calibration loaded{};
+    EXPECT_FALSE(store.load(loaded));
+}
+
+TEST_F(Bno055CalibTest, ReadWriteNeedsConfigModeOnlyTemporarily)
+{
+    device.power_cycle();
+    imu.init();
+    ASSERT_EQ(device.mode(), Bno055::IMU);
+
+    ASSERT_TRUE(imu.write_calibration(kProfile));
+    Bno055Calibration back{};
+    ASSERT_TRUE(imu.read_calibration(back));
+    EXPECT_TRUE(same(back, kProfile));
+    EXPECT_EQ(device.mode(), Bno055::IMU);
+}
+
+TEST_F(Bno055CalibTest, SaveRefusedUntilCalibrated)
+{
+    device.power_cycle();
+    imu.init();
+    EXPECT_FALSE(imu.save_calibration());
+    EXPECT_EQ(spi.erase_count(), 0u);
+}
+
+// Cold start with a blank store, save, then restart with the profile
+TEST_F(Bno055CalibTest, StartupToCalibratedTime)
+{
+    const uint32_t cold_ms = startup_to_calibrated();
+    ASSERT_LT(cold_ms, kTimeoutMs);
+    ASSERT_TRUE(imu.save_calibration());
+
+    const uint32_t warm_ms = startup_to_calibrated();
+    ASSERT_LT(warm_ms, kTimeoutMs);
+
+    std::printf("startup to calibrated: %u ms cold, %u ms with the saved "
+                "profile\n",
+                static_cast<unsigned>(cold_ms),
+                static_cast<unsigned>(warm_ms));
+    RecordProperty("cold_ms", static_cast<int>(cold_ms));
+    RecordProperty("warm_ms", static_cast<int>(warm_ms));
+
+    // Cold needs the full accelerometer calibration; warm only the boot
+    // wait, init() and the short settle
+    EXPECT_GE(cold_ms, SimBno055::kAccelCalMs);
+    EXPECT_LT(warm_ms, SimBno055::kBootMs + 100 + SimBno055::kRestoredCalMs +
+                           50);
+    EXPECT_EQ(device.mode(), Bno055::IMU);
+}
+
+TEST_F(Bno055CalibTest, WrongProfileGivesNoHeadStart)
+{
+    Bno055Calibration other = kProfile;
+    other.gyro_offset[2] += 1;
+    ASSERT_TRUE(store.save(other));
+
+    EXPECT_GE(startup_to_calibrated(), SimBno055::kAccelCalMs);
+}
+
+}  // namespace
+}  // namespace MM
@@ -0,0 +1,187 @@
+/**
+ * @file bno055_health_test.cc
+ * @brief Fault injection on the simulated I2C bus against Bno055Health
+ * @author Bex Saw
+ * @date 2026-10-18
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "bno055_calib_store.h"
+#include "bno055_health.h"
+#include "bno055_imu.h"
+#include "sim_bno055.h"
+#include "sim_gpio.h"
+#include "sim_w25q.h"
+#include "timebase.h"
+
+namespace MM
+{
+namespace
+{
+
+constexpr Bno055Calibration kProfile{.accel_offset = {-12, 25, 7},
+                                     .mag_offset = {150, -80, 40},
+                                     .gyro_offset = {-2, 1, 3},
+                                     .accel_radius = 1000,
+                                     .mag_radius = 700};
+
+class Bno055HealthTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Utils::timebase_init(Utils::TimebaseConfig{});
+        ASSERT_TRUE(flash.init());
+        ASSERT_TRUE(store.save(kProfile));
+        device.power_cycle();
+        imu.init();
+    }
+
+    /**
+     * @brief Run the 1 ms main loop for @p ms
+     * @return Number of GOOD samples
+     */
+    uint32_t run(uint32_t ms)
+    {
+        uint32_t good = 0;
+        for (uint32_t i = 0; i < ms; i++)
+        {
+            // update() must never spend (simulated) time
+            const uint32_t before = Utils::now_us();
+            last = health.update(Utils::now_ms(), sample);
+            EXPECT_EQ(Utils::now_us(), before);
+            if (last == ImuQuality::GOOD)
+                good++;
+            Utils::timebase_advance_us(1000);
+        }
+        return good;
+    }
+
+    ImuQuality step()
+    {
+        last = health.update(Utils::now_ms(), sample);
+        Utils::timebase_advance_us(1000);
+        return last;
+    }
+
+    SimW25q spi;
+    SimGpio cs_pin;
+    GpioChipSelect cs{cs_pin};
+    W25q flash{spi, cs};
+    Bno055CalibrationStore store{flash, 0, 1};
+
+    SimBno055 device{kProfile};
+    Bno055 imu{device, Bno055::ADDR_PRIMARY, &store};
+    Bno055Health health{imu, device};
+
+    Bno055Data sample{};
+    ImuQuality last = ImuQuality::INVALID;
+};
+
+TEST_F(Bno055HealthTest, HealthyStationaryImuStaysGood)
+{
+    // The quaternion of a still mouse never changes; that alone must not
+    // count as frozen
+    EXPECT_EQ(run(5000), 5000u);
+    EXPECT_EQ(health.stage(), Bno055Health::Stage::RUNNING);
+    EXPECT_EQ(device.resets(), 0u);
+    EXPECT_NEAR(sample.quat.w, 1.0f, 1e-6f);
+    EXPECT_NEAR(sample.accel.z, 9.81f, 0.02f);
+}
+
+TEST_F(Bno055HealthTest, TransientNackKeepsLastSample)
+{
+    run(10);
+    const Bno055Data before = sample;
+
+    device.fail_next(2);
+    EXPECT_EQ(step(), ImuQuality::STALE);
+    EXPECT_EQ(sample.accel.z, before.accel.z);  // Held, not garbage
+    EXPECT_EQ(step(), ImuQuality::STALE);
+    EXPECT_EQ(step(), ImuQuality::GOOD);
+
+    EXPECT_EQ(health.i2c_failures(), 2u);
+    EXPECT_EQ(health.stage(), Bno055Health::Stage::RUNNING);
+    EXPECT_EQ(device.bus_clears(), 0u);
+}
+
+TEST_F(Bno055HealthTest, HungBusRecoversWithBusClearOnly)
+{
+    run(10);
+    device.hold_sda();
+
+    EXPECT_EQ(step(), ImuQuality::STALE);
+    EXPECT_EQ(step(), ImuQuality::STALE);
+    EXPECT_EQ(step(), ImuQuality::INVALID);
+    EXPECT_EQ(health.stage(), Bno055Health::Stage::BUS_CLEAR);
+
+    EXPECT_EQ(step(), ImuQuality::INVALID);  // Clears the bus
+    EXPECT_EQ(health.stage(), Bno055Health::Stage::RUNNING);
+    EXPECT_EQ(step(), ImuQuality::GOOD);
+
+    EXPECT_EQ(device.bus_clears(), 1u);
+    EXPECT_EQ(device.resets(), 0u);
+    EXPECT_EQ(health.recoveries(), 0u);
+}
+
+TEST_F(Bno055HealthTest, SysErrorResetsAndRestoresMode)
+{
+    // The application runs raw AMG for host-side fusion
+    ASSERT_TRUE(imu.write_mode(Bno055::AMG));
+    run(10);
+
+    device.raise_sys_error(0x03);
+    run(Bno055HealthConfig{}.status_period_ms);
+    EXPECT_EQ(health.last_sys_error(), 0x03);
+    EXPECT_EQ(device.resets(), 1u);
+
+    // Boot wait, re-init and mode switch, then good data again
+    run(SimBno055::kBootMs + 50);
+    EXPECT_EQ(health.stage(), Bno055Health::Stage::RUNNING);
+    EXPECT_EQ(health.recoveries(), 1u);
+    EXPECT_EQ(device.mode(), Bno055::AMG);
+    EXPECT_EQ(last, ImuQuality::GOOD);
+
+    // configure() restored the saved offsets after the reset
+    Bno055Calibration cal{};
+    ASSERT_TRUE(imu.read_calibration(cal));
+    EXPECT_EQ(cal.accel_radius, kProfile.accel_radius);
+    EXPECT_EQ(cal.gyro_offset[2], kProfile.gyro_offset[2]);
+}
+
+TEST_F(Bno055HealthTest, StalledOutputsTriggerReset)
+{
+    run(10);
+    device.stall_outputs();
+
+    const uint32_t timeout = Bno055HealthConfig{}.frozen_timeout_ms;
+    EXPECT_EQ(run(timeout - 10), timeout - 10);  // Not yet
+    EXPECT_EQ(device.resets(), 0u);
+    run(20);
+    EXPECT_EQ(device.resets(), 1u);
+
+    run(SimBno055::kBootMs + 50);
+    EXPECT_EQ(health.recoveries(), 1u);
+    EXPECT_EQ(last, ImuQuality::GOOD);
+}
+
+TEST_F(Bno055HealthTest, SilentDeviceIsRetriedUntilItAnswers)
+{
+    run(10);
+
+    // Gone for longer than the boot timeout: bus clear, reset, wait, and
+    // round again until it answers
+    device.go_silent(2500);
+    run(2500);
+    EXPECT_NE(health.stage(), Bno055Health::Stage::RUNNING);
+    EXPECT_GE(device.bus_clears(), 2u);
+
+    run(2 * Bno055HealthConfig{}.boot_timeout_ms);
+    EXPECT_EQ(health.stage(), Bno055Health::Stage::RUNNING);
+    EXPECT_EQ(last, ImuQuality::GOOD);
+    EXPECT_EQ(device.mode(), Bno055::IMU);
+}
+
+}  // namespace
+}  // namespace MM
@@ -4,14 +4,30 @@
 
 namespace MM
 {
-class GpioChipSelect
+/**
+ * @brief Active-low chip select driven by a GPIO pin
+ * @tparam Pin Gpio (virtual, chosen at run time) or a compile-time pin
+ *         type such as Stmf4::StaticGpio, which inlines to one store
+ */
+template <GpioLike Pin>
+class ChipSelect
 {
 public:
-    explicit GpioChipSelect(Gpio& cs_pin_);
-    void cs_enable();
-    void cs_disable();
+    explicit ChipSelect(Pin& cs_pin_) : cs_pin{cs_pin_} {}
+
+    void cs_enable()
+    {
+        cs_pin.set(0);
+    }
+
+    void cs_disable()
+    {
+        cs_pin.set(1);
+    }
 
 private:
-    Gpio& cs_pin;
+    Pin& cs_pin;
 };
-}  // namespace MM
\ No newline at end of file
+
+using GpioChipSelect = ChipSelect<Gpio>;
+}  // namespace MM
@@ -0,0 +1,226 @@
+/**
+ * @file sim_w25q.h
+ * @author Kent Hong
+ * @brief Host model of a W25Q128 on an SPI bus
+ * @details Decodes the commands BasicW25q sends, one command per Spi
+ * call: status registers, write enable, read, page program, the erases
+ * and the block locks. Program and erase complete at once, so BUSY never
+ * reads back set. The array survives power_cycle(), the volatile state
+ * does not.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "spi.h"
+
+namespace MM
+{
+
+class SimW25q : public Spi
+{
+public:
+    static constexpr uint32_t kSizeBytes = 16u * 1024u * 1024u;
+    static constexpr uint32_t kBlockSizeBytes = 65536u;
+    static constexpr uint32_t kSectorSizeBytes = 4096u;
+    static constexpr uint32_t kPageSizeBytes = 256u;
+
+    SimW25q() : memory(kSizeBytes, 0xFF)
+    {
+        power_cycle();
+    }
+
+    /**
+     * @brief Drop the volatile state; every block comes back locked
+     */
+    void power_cycle()
+    {
+        sr1 = 0;
+        sr3 = 0;
+        volatile_write = false;
+        locks.fill(true);
+    }
+
+    bool read(std::span<uint8_t> rx_data) override
+    {
+        std::fill(rx_data.begin(), rx_data.end(), 0xFF);
+        return true;
+    }
+
+    bool write(std::span<uint8_t> tx_data) override
+    {
+        return command(tx_data, {});
+    }
+
+    bool seq_transfer(std::span<uint8_t> tx_data,
+                      std::span<uint8_t> rx_data) override
+    {
+        return command(tx_data, rx_data);
+    }
+
+    /**
+     * @brief Direct access to the array, e.g. to corrupt a record
+     */
+    std::span<uint8_t> contents()
+    {
+        return memory;
+    }
+
+    uint32_t erase_count() const
+    {
+        return erases;
+    }
+
+    uint32_t program_count() const
+    {
+        return programs;
+    }
+
+private:
+    static constexpr uint8_t kBusyMask = (1u << 0);
+    static constexpr uint8_t kWelMask = (1u << 1);
+    static constexpr uint8_t kWpsMask = (1u << 2);
+
+    static uint32_t address(std::span<uint8_t> tx)
+    {
+        return (static_cast<uint32_t>(tx[1]) << 16) |
+               (static_cast<uint32_t>(tx[2]) << 8) | tx[3];
+    }
+
+    bool write_enabled() const
+    {
+        return (sr1 & kWelMask) != 0;
+    }
+
+    bool writable(uint32_t addr) const
+    {
+        return (sr3 & kWpsMask) == 0 || !locks[addr / kBlockSizeBytes];
+    }
+
+    void erase(uint32_t addr, uint32_t size)
+    {
+        addr -= addr % size;
+        if (write_enabled() && writable(addr))
+        {
+            std::fill_n(memory.begin() + addr, size, 0xFF);
+            erases++;
+        }
+        sr1 &= ~kWelMask;
+    }
+
+    bool command(std::span<uint8_t> tx, std::span<uint8_t> rx)
+    {
+        if (tx.empty())
+            return false;
+
+        const bool has_addr = tx.size() >= 4;
+        switch (tx[0])
+        {
+            case 0x05:  // Read Status Register-1
+            case 0x35:  // Read Status Register-2
+            case 0x15:  // Read Status Register-3
+                for (uint8_t& b : rx)
+                    b = tx[0] == 0x05 ? sr1 : (tx[0] == 0x15 ? sr3 : 0);
+                return true;
+            case 0x06:  // Write Enable
+                sr1 |= kWelMask;
+                return true;
+            case 0x50:  // Volatile SR Write Enable
+                volatile_write = true;
+                return true;
+            case 0x01:  // Write Status Register-1
+            case 0x31:  // Write Status Register-2
+            case 0x11:  // Write Status Register-3
+                if (tx.size() >= 2 && (volatile_write || write_enabled()))
+                {
+                    if (tx[0] == 0x01)
+                        sr1 = (sr1 & (kBusyMask | kWelMask)) |
+                              (tx[1] & ~(kBusyMask | kWelMask));
+                    else if (tx[0] == 0x11)
+                        sr3 = tx[1];
+                }
+                volatile_write = false;
+                sr1 &= ~kWelMask;
+                return true;
+            case 0x98:  // Global Block Unlock
+                if (write_enabled())
+                    locks.fill(false);
+                sr1 &= ~kWelMask;
+                return true;
+            case 0x66:  // Enable Reset
+                return true;
+            case 0x99:  // Reset Device
+                sr1 = 0;
+                volatile_write = false;
+                return true;
+            case 0x03:  // Read Data
+                if (!has_addr)
+                    return false;
+                for (size_t i = 0; i < rx.size(); i++)
+                    rx[i] = memory[(address(tx) + i) % kSizeBytes];
+                return true;
+            case 0x02:  // Page Program, wraps inside the page like the chip
+            {
+                if (!has_addr)
+                    return false;
+                const uint32_t addr = address(tx);
+                if (write_enabled() && writable(addr))
+                {
+                    const uint32_t page = addr - addr % kPageSizeBytes;
+                    for (size_t i = 4; i < tx.size(); i++)
+                    {
+                        const uint32_t at =
+                            page + (addr + i - 4) % kPageSizeBytes;
+                        memory[at] &= tx[i];  // Only clears bits
+                    }
+                    programs++;
+                }
+                sr1 &= ~kWelMask;
+                return true;
+            }
+            case 0x20:  // Sector Erase
+                if (!has_addr)
+                    return false;
+                erase(address(tx), kSectorSizeBytes);
+                return true;
+            case 0xD8:  // Block Erase (64 KB)
+                if (!has_addr)
+                    return false;
+                erase(address(tx), kBlockSizeBytes);
+                return true;
+            case 0xC7:  // Chip Erase
+                erase(0, kSizeBytes);
+                return true;
+            case 0x36:  // Individual Block Lock
+            case 0x39:  // Individual Block Unlock
+                if (!has_addr)
+                    return false;
+                if (write_enabled())
+                    locks[address(tx) / kBlockSizeBytes] = tx[0] == 0x36;
+                sr1 &= ~kWelMask;
+                return true;
+            case 0x3D:  // Read Block Lock
+                if (!has_addr)
+                    return false;
+                for (uint8_t& b : rx)
+                    b = locks[(address(tx) % kSizeBytes) / kBlockSizeBytes];
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    std::vector<uint8_t> memory;
+    std::array<bool, kSizeBytes / kBlockSizeBytes> locks{};
+    uint8_t sr1 = 0;
+    uint8_t sr3 = 0;
+    bool volatile_write = false;
+    uint32_t erases = 0;
+    uint32_t programs = 0;
+};
+
+}  // namespace MM
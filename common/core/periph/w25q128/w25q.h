@@ -5,6 +5,8 @@
  * 
  */
 
+#pragma once
+
 #include <algorithm>
 #include <array>
 #include <cstdint>
@@ -17,7 +19,12 @@
 namespace MM
 {
 
-class W25q
+/**
+ * @tparam ChipSelectT ChipSelect over a run-time Gpio or a compile-time
+ *         Stmf4::StaticGpio pin
+ */
+template <typename ChipSelectT>
+class BasicW25q
 {
 public:
     /**
@@ -45,7 +52,7 @@ public:
     * @param spi_ SPI instance
     * @param cs_ Chip Select instance
     */
-    explicit W25q(Spi& spi_, GpioChipSelect& cs_);
+    explicit BasicW25q(Spi& spi_, ChipSelectT& cs_);
 
     /**
     * @brief Enable individual block and sector locks on device startup
@@ -182,9 +189,17 @@ private:
     */
     bool block_lock_status_read(uint32_t block_addr, uint8_t& block_lock_byte);
 
+    /**
+    * @brief Helper function for block_lock_status_read()
+    * 
+    * @param block_lock_byte 
+    * @return true Block is locked, false Block is unlocked
+    */
+    static bool is_block_locked(uint8_t block_lock_byte);
+
     // Member Variables
     Spi& spi;
-    GpioChipSelect& cs;
+    ChipSelectT& cs;
 
     // W25Q Opcodes from Instruction Set Table 1 in the datasheet
     struct Opcode
@@ -215,4 +230,16 @@ private:
     static constexpr uint32_t kPageSizeBytes = 256u;
     static constexpr uint32_t kOffsetSizeBit = 1u;
 };
-}  // namespace MM
\ No newline at end of file
+
+/// W25Q behind the common run-time GPIO chip select
+using W25q = BasicW25q<GpioChipSelect>;
+
+}  // namespace MM
+
+#include "w25q_impl.h"
+
+namespace MM
+{
+// Instantiated once in w25q.cc
+extern template class BasicW25q<GpioChipSelect>;
+}  // namespace MM
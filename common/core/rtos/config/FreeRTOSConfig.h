@@ -0,0 +1,100 @@
+/**
+ * @file FreeRTOSConfig.h
+ * @brief FreeRTOS kernel configuration shared by the CM4F and POSIX ports
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Only used when the build finds a FreeRTOS-Kernel checkout (see
+ * common/core/rtos/CMakeLists.txt). Written against kernel V11.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+
+#if defined(__ARM_ARCH)
+extern uint32_t SystemCoreClock;
+#define configCPU_CLOCK_HZ (SystemCoreClock)
+#else
+#define configCPU_CLOCK_HZ (100000000UL)
+#endif
+
+#define configTICK_RATE_HZ (1000)
+#define configUSE_PREEMPTION 1
+#define configUSE_TIME_SLICING 0
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configUSE_TICKLESS_IDLE 0
+#define configMAX_PRIORITIES 8
+#define configMINIMAL_STACK_SIZE 256
+#define configMAX_TASK_NAME_LEN 16
+#define configTICK_TYPE_WIDTH_IN_BITS TICK_TYPE_WIDTH_32_BITS
+#define configIDLE_SHOULD_YIELD 1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#define configQUEUE_REGISTRY_SIZE 0
+#define configENABLE_BACKWARD_COMPATIBILITY 0
+#define configUSE_NEWLIB_REENTRANT 0
+
+// Memory: drivers and tasks use the static APIs; the heap is only there
+// for the POSIX port and optional dynamic objects
+#define configSUPPORT_STATIC_ALLOCATION 1
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configKERNEL_PROVIDED_STATIC_MEMORY 1
+#define configTOTAL_HEAP_SIZE (16 * 1024)
+
+// Hooks
+#define configUSE_IDLE_HOOK 0
+#define configUSE_TICK_HOOK 0
+#define configUSE_MALLOC_FAILED_HOOK 0
+#define configCHECK_FOR_STACK_OVERFLOW 0
+
+// Run-time stats
+#define configGENERATE_RUN_TIME_STATS 0
+#define configUSE_TRACE_FACILITY 0
+
+// Features
+#define configUSE_MUTEXES 1
+#define configUSE_RECURSIVE_MUTEXES 0
+#define configUSE_COUNTING_SEMAPHORES 1
+#define configUSE_TASK_NOTIFICATIONS 1
+#define configUSE_CO_ROUTINES 0
+#define configUSE_TIMERS 0
+
+#define INCLUDE_vTaskDelay 1
+#define INCLUDE_xTaskDelayUntil 1
+#define INCLUDE_vTaskPrioritySet 0
+#define INCLUDE_uxTaskPriorityGet 0
+#define INCLUDE_vTaskDelete 0
+#define INCLUDE_vTaskSuspend 1
+#define INCLUDE_xTaskGetSchedulerState 1
+#define INCLUDE_xTaskGetCurrentTaskHandle 1
+
+#if defined(__ARM_ARCH)
+// Cortex-M4: 4 priority bits. ISRs that call FromISR APIs must have a
+// numerically higher (lower urgency) priority than this.
+#define configPRIO_BITS 4
+#define configLIBRARY_LOWEST_INTERRUPT_PRIORITY 15
+#define configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY 5
+#define configKERNEL_INTERRUPT_PRIORITY \
+    (configLIBRARY_LOWEST_INTERRUPT_PRIORITY << (8 - configPRIO_BITS))
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY \
+    (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << (8 - configPRIO_BITS))
+
+// Map the port handlers onto the CMSIS vector names in the startup file
+#define vPortSVCHandler SVC_Handler
+#define xPortPendSVHandler PendSV_Handler
+#define xPortSysTickHandler SysTick_Handler
+
+#define configASSERT(x)            \
+    if ((x) == 0)                  \
+    {                              \
+        __asm volatile("cpsid i"); \
+        for (;;)                   \
+        {                          \
+        }                          \
+    }
+#else
+#include <assert.h>
+#define configASSERT(x) assert(x)
+#endif
+
+#endif  // FREERTOS_CONFIG_H
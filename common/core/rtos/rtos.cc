@@ -0,0 +1,131 @@
+#include "rtos.h"
+#include "delay.h"
+#include "timebase.h"
+
+#if MM_USE_FREERTOS
+#include "task.h"
+#endif
+
+namespace MM::Rtos
+{
+
+/**
+ * @brief One iteration of a polling wait
+ * @details The native timebase is simulated and only moves when told to,
+ * so a poll loop has to push it forward or a timeout could never expire.
+ */
+static void poll_pause()
+{
+#ifndef STM32F4xx
+    Utils::timebase_advance_us(1);
+#endif
+}
+
+#if MM_USE_FREERTOS
+
+static TickType_t to_ticks(uint32_t timeout_us)
+{
+    // Round up so a short timeout never becomes a zero-tick poll
+    const uint64_t ticks =
+        (static_cast<uint64_t>(timeout_us) * configTICK_RATE_HZ + 999999u) /
+        1000000u;
+    return ticks >= portMAX_DELAY ? portMAX_DELAY - 1
+                                  : static_cast<TickType_t>(ticks);
+}
+
+bool scheduler_running()
+{
+    return xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+}
+
+void sleep_ms(uint32_t ms)
+{
+    if (scheduler_running())
+        vTaskDelay(pdMS_TO_TICKS(ms));
+    else
+        Utils::DelayMs(ms);
+}
+
+BinarySemaphore::BinarySemaphore()
+    : handle(xSemaphoreCreateBinaryStatic(&storage))
+{
+}
+
+bool BinarySemaphore::take(uint32_t timeout_us)
+{
+    if (scheduler_running())
+        return xSemaphoreTake(handle, to_ticks(timeout_us)) == pdTRUE;
+
+    // Blocking calls are not allowed before the scheduler starts
+    const Utils::Deadline deadline = Utils::Deadline::in_us(timeout_us);
+    while (xSemaphoreTake(handle, 0) != pdTRUE)
+    {
+        if (deadline.expired())
+            return false;
+        poll_pause();
+    }
+    return true;
+}
+
+void BinarySemaphore::give()
+{
+    xSemaphoreGive(handle);
+}
+
+void BinarySemaphore::give_from_isr()
+{
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(handle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void BinarySemaphore::reset()
+{
+    xSemaphoreTake(handle, 0);
+}
+
+#else
+
+bool scheduler_running()
+{
+    return false;
+}
+
+void sleep_ms(uint32_t ms)
+{
+    Utils::DelayMs(ms);
+}
+
+BinarySemaphore::BinarySemaphore() : signalled(false) {}
+
+bool BinarySemaphore::take(uint32_t timeout_us)
+{
+    const Utils::Deadline deadline = Utils::Deadline::in_us(timeout_us);
+    while (!signalled)
+    {
+        if (deadline.expired())
+            return false;
+        poll_pause();
+    }
+    signalled = false;
+    return true;
+}
+
+void BinarySemaphore::give()
+{
+    signalled = true;
+}
+
+void BinarySemaphore::give_from_isr()
+{
+    signalled = true;
+}
+
+void BinarySemaphore::reset()
+{
+    signalled = false;
+}
+
+#endif
+
+}  // namespace MM::Rtos
@@ -0,0 +1,74 @@
+/**
+ * @file rtos.h
+ * @brief Thin RTOS layer with a bare-metal fallback
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details With MM_USE_FREERTOS the primitives map onto statically
+ * allocated FreeRTOS objects and a blocked task yields the CPU. Without it
+ * (or before vTaskStartScheduler()) waiting degrades to polling against
+ * the Utils timebase, so drivers can use one code path everywhere.
+ */
+
+#pragma once
+#include <cstdint>
+
+#if MM_USE_FREERTOS
+#include "FreeRTOS.h"
+#include "semphr.h"
+#endif
+
+namespace MM::Rtos
+{
+
+/**
+ * @brief Whether the FreeRTOS scheduler is running
+ */
+bool scheduler_running();
+
+/**
+ * @brief Sleep (RTOS) or busy-wait (bare metal) for @p ms
+ */
+void sleep_ms(uint32_t ms);
+
+/**
+ * @class BinarySemaphore
+ * @brief Completion signal from an interrupt to a waiting thread
+ */
+class BinarySemaphore
+{
+public:
+    BinarySemaphore();
+
+    BinarySemaphore(const BinarySemaphore&) = delete;
+    BinarySemaphore& operator=(const BinarySemaphore&) = delete;
+
+    /**
+     * @brief Wait for give()/give_from_isr()
+     * @param timeout_us Give up after this long
+     * @return true if taken, false on timeout
+     */
+    bool take(uint32_t timeout_us);
+
+    void give();
+
+    /**
+     * @brief Signal from interrupt context; requests a context switch if a
+     *        higher priority task was woken
+     */
+    void give_from_isr();
+
+    /**
+     * @brief Drop a stale signal left over from an aborted wait
+     */
+    void reset();
+
+private:
+#if MM_USE_FREERTOS
+    StaticSemaphore_t storage;
+    SemaphoreHandle_t handle;
+#else
+    volatile bool signalled;
+#endif
+};
+
+}  // namespace MM::Rtos
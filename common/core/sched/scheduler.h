@@ -0,0 +1,236 @@
+/**
+ * @file scheduler.h
+ * @brief Static cooperative run-to-completion scheduler
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Fixed-rate tasks are declared in a constexpr table, checked and
+ * sorted by priority at compile time, and run from the main loop. When
+ * several tasks are due the highest priority one runs first; every task
+ * runs to completion, so nothing needs locking between tasks.
+ *
+ * Per task the scheduler counts runs and overruns and accounts CPU time in
+ * core cycles. On native builds the simulated timebase is used, so a task
+ * "costs" exactly the DelayUs() it performs and runs are deterministic.
+ *
+ * @code
+ * static constexpr auto kTasks = MM::make_task_table({
+ *     MM::Task{"control", control_step, nullptr, 1000, 3},
+ *     MM::Task{"imu", imu_step, nullptr, 10000, 2},
+ *     MM::Task{"telemetry", telemetry_step, nullptr, 100000, 1},
+ * });
+ * MM::Scheduler scheduler(kTasks);
+ * @endcode
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "timebase.h"
+
+namespace MM
+{
+
+/**
+ * @struct Task
+ * @brief One entry of the compile-time task table
+ */
+struct Task
+{
+    const char* name;
+    void (*run)(void* ctx);
+    void* ctx;
+    uint32_t period_us;
+    uint8_t priority;  ///< Higher runs first when several tasks are due
+};
+
+/**
+ * @struct TaskStats
+ * @brief Run-time accounting for one task
+ */
+struct TaskStats
+{
+    uint32_t runs;
+    uint32_t overruns;      ///< Releases skipped because the task ran late
+    uint32_t last_cycles;   ///< Execution time of the latest run
+    uint32_t max_cycles;    ///< Worst-case execution time seen
+    uint64_t total_cycles;  ///< Sum over all runs
+};
+
+/**
+ * @brief Validate a task table and sort it by descending priority
+ * @details Stable, so equal-priority tasks keep their declaration order.
+ * An invalid table is a compile error.
+ */
+template <size_t N>
+consteval std::array<Task, N> make_task_table(const Task (&tasks)[N])
+{
+    std::array<Task, N> table{};
+    for (size_t i = 0; i < N; i++)
+    {
+        if (tasks[i].run == nullptr)
+            throw "Task has no function";
+        if (tasks[i].period_us == 0)
+            throw "Task period must be non-zero";
+        if (tasks[i].period_us > 0x7FFFFFFFu)
+            throw "Task period exceeds the wrap-safe range of the timebase";
+
+        // Insertion sort
+        size_t j = i;
+        while (j > 0 && table[j - 1].priority < tasks[i].priority)
+        {
+            table[j] = table[j - 1];
+            j--;
+        }
+        table[j] = tasks[i];
+    }
+    return table;
+}
+
+/**
+ * @class Scheduler
+ * @brief Polled fixed-rate scheduler over a static task table
+ * @tparam N Number of tasks
+ */
+template <size_t N>
+class Scheduler
+{
+public:
+    /// Called with the next release time when no task is due
+    using IdleHook = void (*)(uint32_t next_release_us);
+
+    explicit constexpr Scheduler(const std::array<Task, N>& table)
+        : tasks(table)
+    {
+    }
+
+    /**
+     * @brief Release every task now and clear the statistics
+     */
+    void start()
+    {
+        const uint32_t now = Utils::now_us();
+        for (size_t i = 0; i < N; i++)
+        {
+            release[i] = now;
+            task_stats[i] = {};
+        }
+        start_us = now;
+    }
+
+    /**
+     * @brief Run the highest-priority due task, if any
+     * @return true if a task ran
+     */
+    bool run_once()
+    {
+        const uint32_t now = Utils::now_us();
+        for (size_t i = 0; i < N; i++)
+        {
+            if (Utils::reached(release[i], now))
+            {
+                dispatch(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Run forever
+     * @param idle Called whenever nothing is due (e.g. advance the
+     *        simulated clock, or sleep until the next interrupt)
+     */
+    [[noreturn]] void run(IdleHook idle = nullptr)
+    {
+        start();
+        while (true)
+        {
+            if (!run_once() && idle != nullptr)
+                idle(next_release());
+        }
+    }
+
+    /**
+     * @brief Earliest pending release time (now_us() base)
+     */
+    uint32_t next_release() const
+    {
+        uint32_t next = release[0];
+        for (size_t i = 1; i < N; i++)
+        {
+            if (static_cast<int32_t>(release[i] - next) < 0)
+                next = release[i];
+        }
+        return next;
+    }
+
+    const Task& task(size_t index) const
+    {
+        return tasks[index];
+    }
+
+    const TaskStats& stats(size_t index) const
+    {
+        return task_stats[index];
+    }
+
+    /**
+     * @brief Share of time spent in tasks since start(), in 1/1000
+     */
+    uint32_t cpu_load_permille() const
+    {
+        const uint64_t elapsed_cycles =
+            static_cast<uint64_t>(Utils::elapsed(start_us, Utils::now_us())) *
+            Utils::cycles_per_us();
+        if (elapsed_cycles == 0)
+            return 0;
+
+        uint64_t busy = 0;
+        for (size_t i = 0; i < N; i++)
+            busy += task_stats[i].total_cycles;
+        return static_cast<uint32_t>(busy * 1000 / elapsed_cycles);
+    }
+
+    static constexpr size_t size()
+    {
+        return N;
+    }
+
+private:
+    void dispatch(size_t i)
+    {
+        const Task& t = tasks[i];
+        TaskStats& s = task_stats[i];
+
+        const uint32_t begin = Utils::now_cycles();
+        t.run(t.ctx);
+        const uint32_t cycles = Utils::now_cycles() - begin;
+
+        s.runs++;
+        s.last_cycles = cycles;
+        s.total_cycles += cycles;
+        if (cycles > s.max_cycles)
+            s.max_cycles = cycles;
+
+        // Next release keeps the original phase. If that is already in the
+        // past the task overran: skip the missed releases rather than
+        // running it back-to-back to catch up.
+        release[i] += t.period_us;
+        const uint32_t now = Utils::now_us();
+        if (Utils::reached(release[i], now))
+        {
+            const uint32_t missed =
+                Utils::elapsed(release[i], now) / t.period_us + 1;
+            s.overruns += missed;
+            release[i] += missed * t.period_us;
+        }
+    }
+
+    const std::array<Task, N> tasks;
+    std::array<uint32_t, N> release{};
+    std::array<TaskStats, N> task_stats{};
+    uint32_t start_us = 0;
+};
+
+}  // namespace MM
@@ -0,0 +1,182 @@
+/**
+ * @file scheduler_test.cc
+ * @brief Cooperative scheduler on the simulated clock
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Tasks burn simulated time with DelayUs(), so every count below
+ * is exact. MixedLoad is the same table app/sched_sim prints.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "delay.h"
+#include "scheduler.h"
+#include "timebase.h"
+
+namespace MM
+{
+namespace
+{
+
+struct Load
+{
+    uint32_t cost_us;
+    std::vector<std::string>* trace = nullptr;
+    const char* name = nullptr;
+};
+
+void burn(void* ctx)
+{
+    auto* load = static_cast<Load*>(ctx);
+    if (load->trace != nullptr)
+        load->trace->push_back(load->name);
+    Utils::DelayUs(load->cost_us);
+}
+
+/**
+ * @brief Main loop with an idle hook that jumps to the next release
+ */
+template <size_t N>
+void run_for(Scheduler<N>& scheduler, uint32_t duration_us)
+{
+    scheduler.start();
+    const uint32_t begin = Utils::now_us();
+    while (Utils::elapsed(begin, Utils::now_us()) < duration_us)
+    {
+        if (!scheduler.run_once())
+            Utils::timebase_advance_us(scheduler.next_release() -
+                                       Utils::now_us());
+    }
+}
+
+class SchedulerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Utils::timebase_init({.core_clock_hz = 100'000'000});
+    }
+};
+
+// The table is sorted by priority at compile time, stably
+constexpr auto kSorted = make_task_table({
+    Task{"low", burn, nullptr, 1000, 1},
+    Task{"high", burn, nullptr, 1000, 3},
+    Task{"mid_a", burn, nullptr, 1000, 2},
+    Task{"mid_b", burn, nullptr, 1000, 2},
+});
+static_assert(kSorted[0].priority == 3 && kSorted[3].priority == 1);
+static_assert(kSorted[1].name[4] == 'a' && kSorted[2].name[4] == 'b');
+
+Load control_load{200};
+Load imu_load{1500};
+Load telemetry_load{4000};
+
+constexpr auto kMixedLoad = make_task_table({
+    Task{"control", burn, &control_load, 1000, 3},
+    Task{"imu", burn, &imu_load, 10000, 2},
+    Task{"telemetry", burn, &telemetry_load, 100000, 1},
+});
+
+TEST_F(SchedulerTest, MixedLoad)
+{
+    Scheduler scheduler(kMixedLoad);
+    run_for(scheduler, 1000000);
+
+    const TaskStats& control = scheduler.stats(0);
+    const TaskStats& imu = scheduler.stats(1);
+    const TaskStats& telemetry = scheduler.stats(2);
+
+    // Every release is either run or counted as an overrun
+    EXPECT_EQ(control.runs + control.overruns, 1000u);
+    EXPECT_EQ(control.runs, 960u);
+    EXPECT_EQ(control.overruns, 40u);
+    EXPECT_EQ(imu.runs, 100u);
+    EXPECT_EQ(imu.overruns, 0u);
+    EXPECT_EQ(telemetry.runs, 10u);
+    EXPECT_EQ(telemetry.overruns, 0u);
+
+    const uint32_t mhz = Utils::cycles_per_us();
+    EXPECT_EQ(control.max_cycles / mhz, 200u);
+    EXPECT_EQ(imu.total_cycles / mhz, 150000u);
+    EXPECT_EQ(telemetry.last_cycles / mhz, 4000u);
+
+    // 192 + 150 + 40 ms busy out of 1 s
+    EXPECT_EQ(scheduler.cpu_load_permille(), 382u);
+}
+
+// Task tables are consteval, so their contexts need static storage
+std::vector<std::string> trace;
+Load low_load{10, &trace, "low"};
+Load high_load{10, &trace, "high"};
+Load mid_load{10, &trace, "mid"};
+
+constexpr auto kPriorities = make_task_table({
+    Task{"low", burn, &low_load, 1000, 1},
+    Task{"high", burn, &high_load, 1000, 3},
+    Task{"mid", burn, &mid_load, 1000, 2},
+});
+
+TEST_F(SchedulerTest, HighestPriorityDueTaskRunsFirst)
+{
+    trace.clear();
+    Scheduler scheduler(kPriorities);
+    run_for(scheduler, 2000);
+
+    const std::vector<std::string> expected{"high", "mid", "low",
+                                            "high", "mid", "low"};
+    EXPECT_EQ(trace, expected);
+}
+
+// 2.5 ms of work in a 1 ms period
+Load heavy_load{2500};
+constexpr auto kHeavy =
+    make_task_table({Task{"heavy", burn, &heavy_load, 1000, 1}});
+
+TEST_F(SchedulerTest, OverrunningTaskSkipsReleases)
+{
+    // Releases 1 and 2 are skipped, the task keeps its phase at 3 ms
+    Scheduler scheduler(kHeavy);
+    run_for(scheduler, 3000);
+
+    EXPECT_EQ(scheduler.stats(0).runs, 1u);
+    EXPECT_EQ(scheduler.stats(0).overruns, 2u);
+    EXPECT_EQ(scheduler.next_release(), 3000u);
+
+    run_for(scheduler, 9000);
+    EXPECT_EQ(scheduler.stats(0).runs + scheduler.stats(0).overruns, 9u);
+    // Busy whenever it runs: load is at the top of the range
+    EXPECT_GE(scheduler.cpu_load_permille(), 830u);
+    EXPECT_LE(scheduler.cpu_load_permille(), 1000u);
+}
+
+Load no_load{0};
+constexpr auto kIdle =
+    make_task_table({Task{"idle", burn, &no_load, 500, 1}});
+
+TEST_F(SchedulerTest, IdleLoadIsZero)
+{
+    Scheduler scheduler(kIdle);
+    run_for(scheduler, 100000);
+
+    EXPECT_EQ(scheduler.stats(0).runs, 200u);
+    EXPECT_EQ(scheduler.stats(0).overruns, 0u);
+    EXPECT_EQ(scheduler.cpu_load_permille(), 0u);
+}
+
+TEST_F(SchedulerTest, StartClearsStatistics)
+{
+    Scheduler scheduler(kMixedLoad);
+    run_for(scheduler, 50000);
+    ASSERT_GT(scheduler.stats(0).runs, 0u);
+
+    scheduler.start();
+    EXPECT_EQ(scheduler.stats(0).runs, 0u);
+    EXPECT_EQ(scheduler.stats(2).total_cycles, 0u);
+    EXPECT_EQ(scheduler.next_release(), Utils::now_us());
+}
+
+}  // namespace
+}  // namespace MM
@@ -0,0 +1,349 @@
+/**
+ * @file timer_service_test.cc
+ * @brief TimerService on SimAlarm: fire order, re-arming and latency
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details The simulated clock only moves when the test advances it, so
+ * every expiry can be checked against the exact microsecond it was due.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "sim_alarm.h"
+#include "timebase.h"
+#include "timer_service.h"
+
+namespace MM
+{
+namespace
+{
+
+/**
+ * @brief SimAlarm that counts how often the hardware would be touched
+ */
+class CountingAlarm : public SimAlarm
+{
+public:
+    void arm(uint32_t deadline_us) override
+    {
+        arms++;
+        SimAlarm::arm(deadline_us);
+    }
+
+    void disarm() override
+    {
+        disarms++;
+        SimAlarm::disarm();
+    }
+
+    uint32_t arms = 0;
+    uint32_t disarms = 0;
+};
+
+struct Fired
+{
+    int id;
+    uint32_t at_us;
+};
+
+class TimerServiceTest : public ::testing::Test
+{
+protected:
+    static constexpr size_t kSlots = 64;
+
+    void SetUp() override
+    {
+        Utils::timebase_init(Utils::TimebaseConfig{});
+        ASSERT_TRUE(service.init());
+    }
+
+    /**
+     * @brief Advance the clock to @p until_us, firing every deadline on
+     * the exact microsecond it falls due
+     */
+    void run_until(uint32_t until_us)
+    {
+        uint32_t deadline;
+        while (alarm.pending(deadline) && Utils::reached(deadline, until_us))
+        {
+            const uint32_t now = Utils::now_us();
+            if (!Utils::reached(deadline, now))
+                Utils::timebase_advance_us(deadline - now);
+            ASSERT_TRUE(alarm.poll());
+        }
+        Utils::timebase_advance_us(until_us - Utils::now_us());
+    }
+
+    /**
+     * @brief Timer that logs its id and the time it fired
+     */
+    struct Probe
+    {
+        Probe(TimerServiceTest* test_, int id_) : test(test_), id(id_) {}
+
+        static void callback(void* ctx)
+        {
+            auto* self = static_cast<Probe*>(ctx);
+            self->test->log.push_back({self->id, Utils::now_us()});
+        }
+
+        TimerServiceTest* test;
+        int id;
+        SoftTimer timer{&Probe::callback, this};
+    };
+
+    CountingAlarm alarm;
+    StaticTimerService<kSlots> service{alarm};
+    std::vector<Fired> log;
+};
+
+TEST_F(TimerServiceTest, FiresInDeadlineOrderOnTime)
+{
+    // Deadlines out of order, with a tie
+    const uint32_t delays[] = {500, 100, 900, 300, 100, 700};
+    std::vector<Probe> probes;
+    probes.reserve(std::size(delays));
+    for (int i = 0; i < static_cast<int>(std::size(delays)); i++)
+        probes.emplace_back(this, i);
+    for (size_t i = 0; i < probes.size(); i++)
+        ASSERT_TRUE(service.start(probes[i].timer, delays[i]));
+    EXPECT_EQ(service.size(), probes.size());
+
+    run_until(1000);
+    ASSERT_EQ(log.size(), probes.size());
+    for (size_t i = 0; i < log.size(); i++)
+    {
+        // Zero latency on the simulated clock
+        EXPECT_EQ(log[i].at_us, delays[log[i].id]);
+        if (i > 0)
+            EXPECT_LE(log[i - 1].at_us, log[i].at_us);
+    }
+    EXPECT_EQ(service.size(), 0u);
+    EXPECT_FALSE(probes[0].timer.active());
+}
+
+TEST_F(TimerServiceTest, AlarmOnlyRearmedWhenRootChanges)
+{
+    Probe a(this, 0), b(this, 1), c(this, 2);
+    ASSERT_TRUE(service.start(a.timer, 1000));
+    EXPECT_EQ(alarm.arms, 1u);
+
+    // Later deadlines leave the programmed alarm alone
+    ASSERT_TRUE(service.start(b.timer, 2000));
+    ASSERT_TRUE(service.start(c.timer, 3000));
+    EXPECT_EQ(alarm.arms, 1u);
+
+    // A new earliest deadline re-arms
+    ASSERT_TRUE(service.start(b.timer, 500));
+    EXPECT_EQ(alarm.arms, 2u);
+    uint32_t deadline = 0;
+    ASSERT_TRUE(alarm.pending(deadline));
+    EXPECT_EQ(deadline, 500u);
+
+    // Cancelling the root moves the alarm to the next timer
+    ASSERT_TRUE(service.cancel(b.timer));
+    ASSERT_TRUE(alarm.pending(deadline));
+    EXPECT_EQ(deadline, 1000u);
+    EXPECT_FALSE(service.cancel(b.timer));
+
+    ASSERT_TRUE(service.cancel(a.timer));
+    ASSERT_TRUE(service.cancel(c.timer));
+    EXPECT_FALSE(alarm.pending(deadline));
+    EXPECT_EQ(alarm.disarms, 1u);
+
+    run_until(5000);
+    EXPECT_TRUE(log.empty());
+}
+
+TEST_F(TimerServiceTest, PeriodicKeepsPhase)
+{
+    Probe fast(this, 0), slow(this, 1);
+    ASSERT_TRUE(service.start(fast.timer, 250, 250));
+    ASSERT_TRUE(service.start(slow.timer, 1000, 1000));
+
+    run_until(10000);
+    size_t fast_count = 0;
+    for (const Fired& f : log)
+    {
+        const uint32_t period = f.id == 0 ? 250 : 1000;
+        EXPECT_EQ(f.at_us % period, 0u);
+        fast_count += f.id == 0;
+    }
+    EXPECT_EQ(fast_count, 40u);
+    EXPECT_EQ(log.size(), 50u);
+}
+
+TEST_F(TimerServiceTest, OverrunSkipsInsteadOfBursting)
+{
+    Probe p(this, 0);
+    ASSERT_TRUE(service.start(p.timer, 100, 100));
+
+    // The alarm interrupt was held off for 1 ms
+    Utils::timebase_advance_us(1050);
+    ASSERT_TRUE(alarm.poll());
+    ASSERT_EQ(log.size(), 1u);
+    EXPECT_EQ(p.timer.deadline(), 1150u);
+
+    run_until(1400);
+    ASSERT_EQ(log.size(), 4u);
+    EXPECT_EQ(log.back().at_us, 1350u);
+}
+
+TEST_F(TimerServiceTest, CallbackCanRestartAndCancel)
+{
+    struct Chain
+    {
+        static void callback(void* ctx)
+        {
+            auto* self = static_cast<Chain*>(ctx);
+            self->fires++;
+            if (self->fires < 3)
+                self->service->start(self->timer, 100);
+            self->service->cancel(*self->victim);
+        }
+
+        TimerService* service;
+        SoftTimer* victim;
+        uint32_t fires = 0;
+        SoftTimer timer{&Chain::callback, this};
+    };
+
+    Probe victim(this, 7);
+    Chain chain{&service, &victim.timer};
+    ASSERT_TRUE(service.start(chain.timer, 100));
+    ASSERT_TRUE(service.start(victim.timer, 150));
+
+    run_until(1000);
+    EXPECT_EQ(chain.fires, 3u);
+    EXPECT_TRUE(log.empty());
+    EXPECT_EQ(service.size(), 0u);
+}
+
+TEST_F(TimerServiceTest, FullServiceRejectsStart)
+{
+    std::vector<Probe> probes;
+    probes.reserve(kSlots + 1);
+    for (size_t i = 0; i <= kSlots; i++)
+        probes.emplace_back(this, static_cast<int>(i));
+    for (size_t i = 0; i < kSlots; i++)
+        ASSERT_TRUE(service.start(probes[i].timer, 1000 + i));
+
+    EXPECT_FALSE(service.start(probes[kSlots].timer, 10));
+    // Restarting an active timer needs no extra slot
+    EXPECT_TRUE(service.start(probes[0].timer, 10));
+}
+
+TEST_F(TimerServiceTest, DeadlinesAcrossClockWrap)
+{
+    Utils::timebase_advance_us(UINT32_MAX - 300);
+    Probe before(this, 0), after(this, 1);
+    ASSERT_TRUE(service.start(after.timer, 500));
+    ASSERT_TRUE(service.start(before.timer, 200));
+
+    run_until(Utils::now_us() + 1000);
+    ASSERT_EQ(log.size(), 2u);
+    EXPECT_EQ(log[0].id, 0);
+    EXPECT_EQ(log[1].id, 1);
+    EXPECT_EQ(log[1].at_us, 199u);  // 2^32 - 301 + 500
+}
+
+TEST_F(TimerServiceTest, RandomScheduleMatchesSortedReference)
+{
+    std::vector<Probe> probes;
+    probes.reserve(kSlots);
+    for (size_t i = 0; i < kSlots; i++)
+        probes.emplace_back(this, static_cast<int>(i));
+
+    uint32_t seed = 3;
+    auto next = [&seed](uint32_t range) {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) % range;
+    };
+
+    std::vector<uint32_t> due(kSlots, 0);
+    for (size_t i = 0; i < kSlots; i++)
+    {
+        due[i] = 1 + next(100000);
+        ASSERT_TRUE(service.start(probes[i].timer, due[i]));
+    }
+    // Cancel every third and restart every fifth
+    for (size_t i = 0; i < kSlots; i += 3)
+    {
+        ASSERT_TRUE(service.cancel(probes[i].timer));
+        due[i] = 0;
+    }
+    for (size_t i = 1; i < kSlots; i += 5)
+    {
+        due[i] = 1 + next(100000);
+        ASSERT_TRUE(service.start(probes[i].timer, due[i]));
+    }
+
+    std::vector<Fired> expected;
+    for (size_t i = 0; i < kSlots; i++)
+    {
+        if (due[i] != 0)
+            expected.push_back({static_cast<int>(i), due[i]});
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const Fired& a, const Fired& b) {
+                         return a.at_us < b.at_us;
+                     });
+
+    run_until(200000);
+    ASSERT_EQ(log.size(), expected.size());
+    for (size_t i = 0; i < log.size(); i++)
+    {
+        EXPECT_EQ(log[i].at_us, expected[i].at_us);
+        EXPECT_EQ(log[i].at_us, due[log[i].id]);
+    }
+}
+
+TEST_F(TimerServiceTest, HostLatency)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t kRounds = 2000;
+
+    std::vector<Probe> probes;
+    probes.reserve(kSlots);
+    for (size_t i = 0; i < kSlots; i++)
+        probes.emplace_back(this, static_cast<int>(i));
+
+    double insert_ns = 0, cancel_ns = 0, fire_ns = 0;
+    for (uint32_t round = 0; round < kRounds; round++)
+    {
+        log.clear();
+        // Fill the heap, so each operation pays the full log2(64) depth
+        auto t0 = Clock::now();
+        for (size_t i = 0; i < kSlots; i++)
+            service.start(probes[i].timer, 1 + (i * 37 + round) % kSlots);
+        auto t1 = Clock::now();
+        for (size_t i = 0; i < kSlots; i += 2)
+            service.cancel(probes[i].timer);
+        auto t2 = Clock::now();
+        Utils::timebase_advance_us(kSlots + 1);
+        service.dispatch();
+        auto t3 = Clock::now();
+
+        ASSERT_EQ(log.size(), kSlots / 2);
+        insert_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        cancel_ns += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        fire_ns += std::chrono::duration<double, std::nano>(t3 - t2).count();
+    }
+
+    insert_ns /= kRounds * kSlots;
+    cancel_ns /= kRounds * (kSlots / 2);
+    fire_ns /= kRounds * (kSlots / 2);
+    std::printf("timer service, %zu timers, host:\n", kSlots);
+    std::printf("  insert %.1f ns, cancel %.1f ns, fire %.1f ns\n", insert_ns,
+                cancel_ns, fire_ns);
+    RecordProperty("insert_ns", static_cast<int>(insert_ns));
+    RecordProperty("cancel_ns", static_cast<int>(cancel_ns));
+    RecordProperty("fire_ns", static_cast<int>(fire_ns));
+}
+
+}  // namespace
+}  // namespace MM
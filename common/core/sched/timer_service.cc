@@ -0,0 +1,204 @@
+#include "timer_service.h"
+#include "critical.h"
+#include "timebase.h"
+
+namespace MM
+{
+
+using Utils::CriticalSection;
+using Utils::reached;
+
+/**
+ * @brief Wrap-safe "a expires before b"
+ */
+static bool earlier(const SoftTimer* a, const SoftTimer* b)
+{
+    return static_cast<int32_t>(a->deadline() - b->deadline()) < 0;
+}
+
+SoftTimer::SoftTimer(Callback callback, void* ctx)
+    : callback_(callback), ctx_(ctx)
+{
+}
+
+TimerService::TimerService(Alarm& alarm_, SoftTimer** storage,
+                           size_t capacity_)
+    : alarm(alarm_),
+      heap(storage),
+      capacity(capacity_),
+      count(0),
+      armed_deadline(0),
+      armed(false),
+      dispatching(false)
+{
+}
+
+bool TimerService::init()
+{
+    if (heap == nullptr || capacity == 0)
+        return false;
+    alarm.set_handler(&TimerService::alarm_handler, this);
+    return true;
+}
+
+bool TimerService::start(SoftTimer& timer, uint32_t delay_us,
+                         uint32_t period_us)
+{
+    return start_at(timer, Utils::now_us() + delay_us, period_us);
+}
+
+bool TimerService::start_at(SoftTimer& timer, uint32_t deadline_us,
+                            uint32_t period_us)
+{
+    CriticalSection lock;
+    if (timer.active())
+        remove(static_cast<size_t>(timer.index_));
+    else if (count == capacity)
+        return false;
+
+    timer.deadline_ = deadline_us;
+    timer.period_ = period_us;
+    insert(timer);
+    update_alarm();
+    return true;
+}
+
+bool TimerService::cancel(SoftTimer& timer)
+{
+    CriticalSection lock;
+    if (!timer.active())
+        return false;
+
+    remove(static_cast<size_t>(timer.index_));
+    update_alarm();
+    return true;
+}
+
+void TimerService::dispatch()
+{
+    {
+        CriticalSection lock;
+        dispatching = true;
+    }
+
+    const uint32_t now = Utils::now_us();
+    while (true)
+    {
+        SoftTimer* timer;
+        {
+            CriticalSection lock;
+            if (count == 0 || !reached(heap[0]->deadline_, now))
+                break;
+
+            timer = heap[0];
+            remove(0);
+            if (timer->period_ != 0)
+            {
+                // Keep the phase, but after an overrun restart from now
+                // instead of firing a burst of catch-up callbacks
+                timer->deadline_ += timer->period_;
+                if (reached(timer->deadline_, now))
+                    timer->deadline_ = now + timer->period_;
+                insert(*timer);
+            }
+        }
+        // Unlocked so the callback can start/cancel timers itself
+        timer->callback_(timer->ctx_);
+    }
+
+    CriticalSection lock;
+    dispatching = false;
+    armed = false;  // The alarm is one-shot and has just fired
+    update_alarm();
+}
+
+void TimerService::alarm_handler(void* ctx)
+{
+    static_cast<TimerService*>(ctx)->dispatch();
+}
+
+void TimerService::insert(SoftTimer& timer)
+{
+    place(&timer, count++);
+    sift_up(count - 1);
+}
+
+void TimerService::remove(size_t index)
+{
+    SoftTimer* removed = heap[index];
+    removed->index_ = -1;
+
+    const size_t last = --count;
+    if (index == last)
+        return;
+
+    // Move the last leaf into the hole; it may need to go either way
+    place(heap[last], index);
+    if (index > 0 && earlier(heap[index], heap[(index - 1) / 2]))
+        sift_up(index);
+    else
+        sift_down(index);
+}
+
+void TimerService::place(SoftTimer* timer, size_t index)
+{
+    heap[index] = timer;
+    timer->index_ = static_cast<int32_t>(index);
+}
+
+void TimerService::sift_up(size_t index)
+{
+    SoftTimer* timer = heap[index];
+    while (index > 0)
+    {
+        const size_t parent = (index - 1) / 2;
+        if (!earlier(timer, heap[parent]))
+            break;
+        place(heap[parent], index);
+        index = parent;
+    }
+    place(timer, index);
+}
+
+void TimerService::sift_down(size_t index)
+{
+    SoftTimer* timer = heap[index];
+    while (true)
+    {
+        size_t child = 2 * index + 1;
+        if (child >= count)
+            break;
+        if (child + 1 < count && earlier(heap[child + 1], heap[child]))
+            child++;
+        if (!earlier(heap[child], timer))
+            break;
+        place(heap[child], index);
+        index = child;
+    }
+    place(timer, index);
+}
+
+void TimerService::update_alarm()
+{
+    // dispatch() re-arms once at the end of its pass
+    if (dispatching)
+        return;
+
+    if (count == 0)
+    {
+        if (armed)
+            alarm.disarm();
+        armed = false;
+        return;
+    }
+
+    const uint32_t next = heap[0]->deadline_;
+    if (armed && next == armed_deadline)
+        return;
+
+    armed_deadline = next;
+    armed = true;
+    alarm.arm(next);
+}
+
+}  // namespace MM
@@ -0,0 +1,149 @@
+/**
+ * @file timer_service.h
+ * @brief Deadline timers multiplexed onto one hardware alarm
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Pending timers live in a binary min-heap ordered by deadline
+ * (wrap-safe). Only the heap root is ever programmed into the Alarm, and
+ * only when the root actually changes, so there is no periodic tick.
+ *
+ * Insert and cancel are O(log n), firing is O(log n) per expired timer.
+ * Timers are owned by the caller; the service stores pointers only.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "alarm.h"
+
+namespace MM
+{
+
+/**
+ * @class SoftTimer
+ * @brief One-shot or periodic software timer
+ */
+class SoftTimer
+{
+public:
+    using Callback = void (*)(void* ctx);
+
+    /**
+     * @param callback Called from the alarm interrupt when the timer expires
+     * @param ctx Passed to @p callback
+     */
+    SoftTimer(Callback callback, void* ctx = nullptr);
+
+    bool active() const
+    {
+        return index_ >= 0;
+    }
+
+    uint32_t deadline() const
+    {
+        return deadline_;
+    }
+
+private:
+    friend class TimerService;
+
+    Callback callback_;
+    void* ctx_;
+    uint32_t deadline_ = 0;
+    uint32_t period_ = 0;
+    int32_t index_ = -1;  ///< Position in the heap, -1 if idle
+};
+
+/**
+ * @class TimerService
+ * @brief Min-heap of SoftTimer deadlines driving a single Alarm
+ * @details start()/cancel() may be called from thread context or from a
+ * timer callback. Callbacks run in the alarm's interrupt context and must
+ * be short; hand heavier work to the main loop.
+ *
+ * Deadlines are microseconds on the Utils timebase and must lie within
+ * 2^31 us (~35 min) of each other.
+ */
+class TimerService
+{
+public:
+    /**
+     * @param alarm Hardware (or simulated) alarm on the same timebase
+     * @param storage Heap storage, one slot per concurrently active timer
+     * @param capacity Number of slots in @p storage
+     */
+    TimerService(Alarm& alarm, SoftTimer** storage, size_t capacity);
+
+    /**
+     * @brief Install the alarm handler
+     */
+    bool init();
+
+    /**
+     * @brief Start (or restart) a timer relative to now
+     * @param delay_us First expiry, in microseconds from now
+     * @param period_us Reload period, 0 for one-shot
+     * @return false if the service is full
+     */
+    bool start(SoftTimer& timer, uint32_t delay_us, uint32_t period_us = 0);
+
+    /**
+     * @brief Start (or restart) a timer at an absolute now_us() deadline
+     */
+    bool start_at(SoftTimer& timer, uint32_t deadline_us,
+                  uint32_t period_us = 0);
+
+    /**
+     * @brief Stop a timer
+     * @return false if it was not running
+     */
+    bool cancel(SoftTimer& timer);
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * @brief Fire every expired timer and re-arm for the next one
+     * @note Called by the alarm handler; exposed for polled setups.
+     */
+    void dispatch();
+
+private:
+    static void alarm_handler(void* ctx);
+
+    void insert(SoftTimer& timer);
+    void remove(size_t index);
+    void place(SoftTimer* timer, size_t index);
+    void sift_up(size_t index);
+    void sift_down(size_t index);
+    void update_alarm();
+
+    Alarm& alarm;
+    SoftTimer** heap;
+    size_t capacity;
+    size_t count;
+    uint32_t armed_deadline;
+    bool armed;
+    bool dispatching;
+};
+
+/**
+ * @class StaticTimerService
+ * @brief TimerService with inline storage for N timers
+ */
+template <size_t N>
+class StaticTimerService : public TimerService
+{
+public:
+    explicit StaticTimerService(Alarm& alarm)
+        : TimerService(alarm, slots, N)
+    {
+    }
+
+private:
+    SoftTimer* slots[N] = {};
+};
+
+}  // namespace MM
@@ -0,0 +1,143 @@
+/**
+ * @file indexed_heap.h
+ * @brief Fixed-capacity binary min-heap over integer ids with decrease-key
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Keys live in a caller-owned array (typically the distance table
+ * of a shortest-path search), so the heap itself stores only ids and their
+ * heap positions.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace MM::Utils
+{
+
+/**
+ * @class IndexedMinHeap
+ * @tparam N Number of ids (0 .. N-1), at most 65535
+ * @tparam Key Key type, compared with '<'
+ */
+template <size_t N, typename Key = uint32_t>
+class IndexedMinHeap
+{
+    static_assert(N > 0 && N < 0xFFFF, "Ids must fit in uint16_t");
+
+public:
+    explicit IndexedMinHeap(const Key* keys_) : keys(keys_)
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        count = 0;
+        pos.fill(kAbsent);
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    bool contains(uint16_t id) const
+    {
+        return pos[id] != kAbsent;
+    }
+
+    /**
+     * @brief Insert @p id, or restore order after its key decreased
+     */
+    void push_or_decrease(uint16_t id)
+    {
+        if (pos[id] == kAbsent)
+        {
+            heap[count] = id;
+            pos[id] = static_cast<uint16_t>(count);
+            count++;
+        }
+        sift_up(pos[id]);
+    }
+
+    /**
+     * @brief Remove the id with the smallest key
+     * @return false if the heap is empty
+     */
+    bool pop(uint16_t& id)
+    {
+        if (count == 0)
+            return false;
+        id = heap[0];
+        pos[id] = kAbsent;
+        count--;
+        if (count > 0)
+        {
+            heap[0] = heap[count];
+            pos[heap[0]] = 0;
+            sift_down(0);
+        }
+        return true;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+private:
+    static constexpr uint16_t kAbsent = 0xFFFF;
+
+    bool less(size_t a, size_t b) const
+    {
+        return keys[heap[a]] < keys[heap[b]];
+    }
+
+    void swap(size_t a, size_t b)
+    {
+        const uint16_t t = heap[a];
+        heap[a] = heap[b];
+        heap[b] = t;
+        pos[heap[a]] = static_cast<uint16_t>(a);
+        pos[heap[b]] = static_cast<uint16_t>(b);
+    }
+
+    void sift_up(size_t i)
+    {
+        while (i > 0)
+        {
+            const size_t parent = (i - 1) / 2;
+            if (!less(i, parent))
+                break;
+            swap(i, parent);
+            i = parent;
+        }
+    }
+
+    void sift_down(size_t i)
+    {
+        while (true)
+        {
+            const size_t l = 2 * i + 1;
+            const size_t r = l + 1;
+            size_t smallest = i;
+            if (l < count && less(l, smallest))
+                smallest = l;
+            if (r < count && less(r, smallest))
+                smallest = r;
+            if (smallest == i)
+                break;
+            swap(i, smallest);
+            i = smallest;
+        }
+    }
+
+    const Key* keys;
+    std::array<uint16_t, N> heap{};
+    std::array<uint16_t, N> pos{};
+    size_t count = 0;
+};
+
+}  // namespace MM::Utils
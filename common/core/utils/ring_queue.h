@@ -0,0 +1,84 @@
+/**
+ * @file ring_queue.h
+ * @brief Fixed-capacity FIFO with static storage
+ * @author Kent Hong
+ * @date 2026-10-18
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+
+namespace MM::Utils
+{
+
+/**
+ * @class RingQueue
+ * @brief Single-context FIFO; not safe between an ISR and the main loop
+ * @tparam N Capacity in elements
+ */
+template <typename T, size_t N>
+class RingQueue
+{
+    static_assert(N > 0, "RingQueue needs a non-zero capacity");
+
+public:
+    /**
+     * @return false if the queue is full (the value is dropped)
+     */
+    constexpr bool push(const T& value)
+    {
+        if (count == N)
+            return false;
+        items[tail] = value;
+        tail = tail + 1 == N ? 0 : tail + 1;
+        count++;
+        return true;
+    }
+
+    /**
+     * @return false if the queue is empty
+     */
+    constexpr bool pop(T& value)
+    {
+        if (count == 0)
+            return false;
+        value = items[head];
+        head = head + 1 == N ? 0 : head + 1;
+        count--;
+        return true;
+    }
+
+    constexpr void clear()
+    {
+        head = tail = count = 0;
+    }
+
+    constexpr bool empty() const
+    {
+        return count == 0;
+    }
+
+    constexpr bool full() const
+    {
+        return count == N;
+    }
+
+    constexpr size_t size() const
+    {
+        return count;
+    }
+
+    static constexpr size_t capacity()
+    {
+        return N;
+    }
+
+private:
+    std::array<T, N> items{};
+    size_t head = 0;
+    size_t tail = 0;
+    size_t count = 0;
+};
+
+}  // namespace MM::Utils
@@ -58,6 +58,13 @@ public:
      */
     virtual bool write(const uint8_t* data, size_t len, uint8_t dev_addr) = 0;
 
+    /**
+     * @brief Recover a hung bus (e.g. a slave holding SDA low)
+     * 
+     * @return true if the bus is idle and usable again, false otherwise
+     */
+    virtual bool bus_clear() = 0;
+
     ~I2c() = default;
 };
 }  // namespace MM
\ No newline at end of file
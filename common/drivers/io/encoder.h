@@ -0,0 +1,32 @@
+/**
+ * @file encoder.h
+ * @brief Quadrature encoder interface
+ * @author Bex Saw
+ * @date 2026-10-18
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace MM
+{
+
+class Encoder
+{
+public:
+    /**
+     * @brief Read the running count (x4 decoded edges)
+     * @return Count modulo 2^32; take differences as int32_t, which stays
+     * correct across the wrap as long as reads are < 2^31 counts apart.
+     */
+    virtual int32_t count() = 0;
+
+    /**
+     * @brief Set the count back to zero
+     */
+    virtual void reset() = 0;
+
+    ~Encoder() = default;
+};
+
+}  // namespace MM
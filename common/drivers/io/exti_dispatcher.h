@@ -0,0 +1,119 @@
+/**
+ * @file exti_dispatcher.h
+ * @brief Fixed table of per-line edge-interrupt handlers
+ * @author TJ
+ * @date 2026-10-18
+ * @details Platform-neutral half of the EXTI support: the STM32 driver
+ * feeds it the pending-line mask from its IRQ handlers, and on the host a
+ * FakeExti feeds it injected edges. Handlers are plain function pointers
+ * plus a context, so the ISR path has no virtual calls.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace MM
+{
+
+enum class GpioEdge : uint8_t
+{
+    RISING = 1,
+    FALLING = 2,
+    BOTH = 3
+};
+
+class ExtiDispatcher
+{
+public:
+    using Handler = void (*)(void* ctx);
+
+    static constexpr uint8_t NUM_LINES = 16;
+
+    /**
+     * @brief Install a handler for a line
+     * @return false if the line is out of range or already taken
+     */
+    bool attach(uint8_t line, GpioEdge edge, Handler handler, void* ctx)
+    {
+        if (line >= NUM_LINES || handler == nullptr ||
+            table_[line].handler != nullptr)
+            return false;
+        table_[line] = {handler, ctx, edge};
+        return true;
+    }
+
+    void detach(uint8_t line)
+    {
+        if (line < NUM_LINES)
+            table_[line] = {};
+    }
+
+    bool attached(uint8_t line) const
+    {
+        return line < NUM_LINES && table_[line].handler != nullptr;
+    }
+
+    GpioEdge edge(uint8_t line) const
+    {
+        return table_[line].edge;
+    }
+
+    /**
+     * @brief Run the handlers of every line set in @p pending
+     * @param pending Bit n set for line n
+     * @param entry_cycles Cycle count at ISR entry, for latency stats
+     * @param now_cycles Cycle counter read just before each handler
+     */
+    template <typename CycleFn>
+    void dispatch(uint32_t pending, uint32_t entry_cycles, CycleFn now_cycles)
+    {
+        while (pending != 0)
+        {
+            const uint32_t line = __builtin_ctz(pending);
+            pending &= pending - 1;
+
+            const Entry& e = table_[line];
+            if (e.handler == nullptr)
+                continue;
+
+            const uint32_t latency = now_cycles() - entry_cycles;
+            last_latency_cycles_ = latency;
+            if (latency > max_latency_cycles_)
+                max_latency_cycles_ = latency;
+            e.handler(e.ctx);
+        }
+    }
+
+    /**
+     * @brief Cycles from ISR entry to the most recent handler call
+     */
+    uint32_t last_latency_cycles() const
+    {
+        return last_latency_cycles_;
+    }
+
+    uint32_t max_latency_cycles() const
+    {
+        return max_latency_cycles_;
+    }
+
+    void reset_stats()
+    {
+        last_latency_cycles_ = 0;
+        max_latency_cycles_ = 0;
+    }
+
+private:
+    struct Entry
+    {
+        Handler handler = nullptr;
+        void* ctx = nullptr;
+        GpioEdge edge = GpioEdge::BOTH;
+    };
+
+    Entry table_[NUM_LINES];
+    volatile uint32_t last_latency_cycles_ = 0;
+    volatile uint32_t max_latency_cycles_ = 0;
+};
+
+}  // namespace MM
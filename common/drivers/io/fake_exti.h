@@ -0,0 +1,74 @@
+/**
+ * @file fake_exti.h
+ * @brief Host stand-in for the EXTI controller
+ * @author TJ
+ * @date 2026-10-18
+ * @details Tracks pin levels and turns level changes into edges. An edge
+ * only reaches the dispatcher if the line's configured GpioEdge accepts
+ * it, matching the RTSR/FTSR filtering done by the hardware.
+ */
+
+#pragma once
+#include <cstdint>
+#include "exti_dispatcher.h"
+
+namespace MM
+{
+
+class FakeExti
+{
+public:
+    explicit FakeExti(ExtiDispatcher& dispatcher) : dispatcher_(dispatcher) {}
+
+    /**
+     * @brief Drive a pin; dispatches if this makes an accepted edge
+     * @return true if a handler was called
+     */
+    bool set_level(uint8_t line, bool level)
+    {
+        if (line >= ExtiDispatcher::NUM_LINES)
+            return false;
+
+        const uint32_t bit = 1u << line;
+        const bool previous = (levels_ & bit) != 0;
+        levels_ = level ? (levels_ | bit) : (levels_ & ~bit);
+        if (previous == level)
+            return false;
+
+        return inject(line, level ? GpioEdge::RISING : GpioEdge::FALLING);
+    }
+
+    /**
+     * @brief Deliver one edge directly
+     * @return true if a handler was called
+     */
+    bool inject(uint8_t line, GpioEdge edge)
+    {
+        if (!dispatcher_.attached(line))
+            return false;
+        const auto accepted = static_cast<uint8_t>(dispatcher_.edge(line));
+        if ((accepted & static_cast<uint8_t>(edge)) == 0)
+            return false;
+
+        dispatcher_.dispatch(1u << line, 0, [] { return 0u; });
+        edges_++;
+        return true;
+    }
+
+    bool level(uint8_t line) const
+    {
+        return (levels_ >> line) & 1u;
+    }
+
+    uint32_t edges() const
+    {
+        return edges_;
+    }
+
+private:
+    ExtiDispatcher& dispatcher_;
+    uint32_t levels_ = 0;
+    uint32_t edges_ = 0;
+};
+
+}  // namespace MM
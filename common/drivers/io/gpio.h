@@ -7,6 +7,8 @@
  */
 
 #pragma once
+#include <concepts>
+
 namespace MM
 {
 /**
@@ -41,4 +43,17 @@ public:
      */
     ~Gpio() = default;
 };
+
+/**
+ * @brief Anything usable as a GPIO pin: the Gpio interface itself, or a
+ * compile-time pin type such as Stmf4::StaticGpio that needs no vtable.
+ */
+template <typename T>
+concept GpioLike = requires(T& pin, bool active) {
+    { pin.toggle() } -> std::convertible_to<bool>;
+    { pin.set(active) } -> std::convertible_to<bool>;
+    { pin.read() } -> std::convertible_to<bool>;
+};
+
+static_assert(GpioLike<Gpio>);
 }  // namespace MM
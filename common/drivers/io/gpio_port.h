@@ -0,0 +1,126 @@
+/**
+ * @file gpio_port.h
+ * @brief Whole-port GPIO access for switching several pins at once
+ * @author TJ
+ * @date 2026-10-18
+ * @details Platform-neutral half of the port API, templated on the
+ * register block so the host tests can count register accesses. BSRR is
+ * write-only: the low half sets pins and the high half resets them, so any
+ * combination of pins on one port changes state in a single store with no
+ * read-modify-write race against interrupts. IDR is likewise sampled for
+ * all pins with one load.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace MM
+{
+
+/**
+ * @brief Compile-time set of pins on one port
+ */
+template <uint8_t... Pins>
+struct PinGroup
+{
+    static_assert(sizeof...(Pins) > 0, "Empty pin group");
+    static_assert(((Pins < 16) && ...), "GPIO pin out of range");
+
+    static constexpr uint16_t mask = (uint16_t(0) | ... | uint16_t(1u << Pins));
+
+    static_assert(__builtin_popcount(mask) == sizeof...(Pins),
+                  "Pin listed twice in group");
+};
+
+/**
+ * @tparam Regs Register block with BSRR, ODR and IDR members
+ */
+template <typename Regs>
+class BasicGpioPort
+{
+public:
+    explicit BasicGpioPort(Regs* base_addr_) : base_addr{base_addr_} {}
+
+    /**
+     * @brief Drive the pins in @p mask high
+     */
+    void set(uint16_t mask)
+    {
+        base_addr->BSRR = mask;
+    }
+
+    /**
+     * @brief Drive the pins in @p mask low
+     */
+    void clear(uint16_t mask)
+    {
+        base_addr->BSRR = static_cast<uint32_t>(mask) << 16;
+    }
+
+    /**
+     * @brief Set @p set_mask and clear @p clear_mask in one store
+     * @note Set wins if a pin is in both masks (RM0383 8.4.7)
+     */
+    void set_clear(uint16_t set_mask, uint16_t clear_mask)
+    {
+        base_addr->BSRR =
+            set_mask | (static_cast<uint32_t>(clear_mask) << 16);
+    }
+
+    /**
+     * @brief Drive the pins in @p mask to the matching bits of @p value
+     */
+    void write(uint16_t mask, uint16_t value)
+    {
+        set_clear(value & mask, ~value & mask);
+    }
+
+    /**
+     * @brief Toggle the pins in @p mask
+     * @details One ODR load, then one BSRR store. Pins outside @p mask are
+     * never touched, whatever happens in between.
+     * @warning Not atomic for the pins in @p mask: if an interrupt drives
+     * one of them between the load and the store, the store overwrites it
+     * with the inverse of the stale level. Mask interrupts around the call
+     * if another context owns any of those pins.
+     */
+    void toggle(uint16_t mask)
+    {
+        const uint16_t odr = static_cast<uint16_t>(base_addr->ODR);
+        set_clear(~odr & mask, odr & mask);
+    }
+
+    /**
+     * @brief Sample input levels of the pins in @p mask with one IDR load
+     */
+    uint16_t read_mask(uint16_t mask) const
+    {
+        return static_cast<uint16_t>(base_addr->IDR) & mask;
+    }
+
+    template <uint8_t... Pins>
+    void set(PinGroup<Pins...>)
+    {
+        set(PinGroup<Pins...>::mask);
+    }
+
+    template <uint8_t... Pins>
+    void clear(PinGroup<Pins...>)
+    {
+        clear(PinGroup<Pins...>::mask);
+    }
+
+    template <uint8_t... Pins>
+    uint16_t read_mask(PinGroup<Pins...>) const
+    {
+        return read_mask(PinGroup<Pins...>::mask);
+    }
+
+private:
+    Regs* const base_addr;
+};
+
+static_assert(PinGroup<0, 1, 4, 5>::mask == 0x0033);
+static_assert(PinGroup<15>::mask == 0x8000);
+
+}  // namespace MM
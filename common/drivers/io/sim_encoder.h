@@ -0,0 +1,70 @@
+/**
+ * @file sim_encoder.h
+ * @brief Host stand-in for a timer in encoder mode
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Models the hardware counter register at a chosen width and the
+ * same software extension HwEncoder uses, so the wrap handling of 16-bit
+ * timers can be exercised on the host.
+ */
+
+#pragma once
+#include <cstdint>
+#include "encoder.h"
+
+namespace MM
+{
+
+class SimEncoder : public Encoder
+{
+public:
+    /**
+     * @param counter_bits_ Width of the emulated CNT register (16 or 32)
+     */
+    explicit SimEncoder(uint8_t counter_bits_ = 32)
+        : mask(counter_bits_ >= 32 ? 0xFFFFFFFFu
+                                   : (1u << counter_bits_) - 1u)
+    {
+    }
+
+    /**
+     * @brief Move the shaft by @p counts edges (negative = reverse)
+     */
+    void step(int32_t counts)
+    {
+        cnt = (cnt + static_cast<uint32_t>(counts)) & mask;
+    }
+
+    /**
+     * @brief Raw value of the emulated CNT register
+     */
+    uint32_t raw() const
+    {
+        return cnt;
+    }
+
+    int32_t count() override
+    {
+        // Sign-extend the register delta to its own width
+        const uint32_t delta = (cnt - last) & mask;
+        const uint32_t sign = (mask >> 1) + 1u;
+        position += static_cast<int32_t>((delta ^ sign) - sign);
+        last = cnt;
+        return static_cast<int32_t>(position);
+    }
+
+    void reset() override
+    {
+        cnt = 0;
+        last = 0;
+        position = 0;
+    }
+
+private:
+    const uint32_t mask;
+    uint32_t cnt = 0;
+    uint32_t last = 0;
+    uint32_t position = 0;
+};
+
+}  // namespace MM
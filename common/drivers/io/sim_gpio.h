@@ -0,0 +1,47 @@
+/**
+ * @file sim_gpio.h
+ * @brief Host stand-in for an output pin
+ * @author TJ
+ * @date 2026-10-18
+ * @details Holds the pin level and counts writes, e.g. for the chip
+ * select of a simulated SPI device.
+ */
+
+#pragma once
+#include <cstdint>
+#include "gpio.h"
+
+namespace MM
+{
+
+class SimGpio : public Gpio
+{
+public:
+    bool toggle() override
+    {
+        return set(!level);
+    }
+
+    bool set(const bool active) override
+    {
+        level = active;
+        writes++;
+        return true;
+    }
+
+    bool read() override
+    {
+        return level;
+    }
+
+    uint32_t write_count() const
+    {
+        return writes;
+    }
+
+private:
+    bool level = true;
+    uint32_t writes = 0;
+};
+
+}  // namespace MM
@@ -0,0 +1,162 @@
+/**
+ * @file exti_dispatcher_test.cc
+ * @brief ExtiDispatcher driven through FakeExti on the host
+ * @author TJ
+ * @date 2026-10-18
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "exti_dispatcher.h"
+#include "fake_exti.h"
+
+namespace MM
+{
+namespace
+{
+
+/**
+ * @brief Handler context that logs which line fired
+ */
+struct Probe
+{
+    static void callback(void* ctx)
+    {
+        auto* self = static_cast<Probe*>(ctx);
+        self->log->push_back(self->line);
+    }
+
+    std::vector<uint8_t>* log;
+    uint8_t line;
+};
+
+class ExtiDispatcherTest : public ::testing::Test
+{
+protected:
+    Probe probe(uint8_t line)
+    {
+        return Probe{&log, line};
+    }
+
+    ExtiDispatcher dispatcher;
+    FakeExti exti{dispatcher};
+    std::vector<uint8_t> log;
+};
+
+TEST_F(ExtiDispatcherTest, AttachRejectsBadAndTakenLines)
+{
+    Probe p = probe(3);
+    EXPECT_FALSE(dispatcher.attach(ExtiDispatcher::NUM_LINES, GpioEdge::BOTH,
+                                   &Probe::callback, &p));
+    EXPECT_FALSE(dispatcher.attach(3, GpioEdge::BOTH, nullptr, &p));
+    ASSERT_TRUE(dispatcher.attach(3, GpioEdge::BOTH, &Probe::callback, &p));
+    EXPECT_TRUE(dispatcher.attached(3));
+
+    // A second pin with the same number cannot steal the line
+    EXPECT_FALSE(dispatcher.attach(3, GpioEdge::RISING, &Probe::callback, &p));
+    EXPECT_EQ(dispatcher.edge(3), GpioEdge::BOTH);
+
+    dispatcher.detach(3);
+    EXPECT_FALSE(dispatcher.attached(3));
+    EXPECT_TRUE(dispatcher.attach(3, GpioEdge::RISING, &Probe::callback, &p));
+}
+
+TEST_F(ExtiDispatcherTest, EdgeFilterMatchesTriggerSelection)
+{
+    Probe rising = probe(0);
+    Probe falling = probe(1);
+    Probe both = probe(2);
+    ASSERT_TRUE(
+        dispatcher.attach(0, GpioEdge::RISING, &Probe::callback, &rising));
+    ASSERT_TRUE(
+        dispatcher.attach(1, GpioEdge::FALLING, &Probe::callback, &falling));
+    ASSERT_TRUE(dispatcher.attach(2, GpioEdge::BOTH, &Probe::callback, &both));
+
+    // Two full pulses on every line
+    for (int pulse = 0; pulse < 2; pulse++)
+    {
+        for (uint8_t line = 0; line < 3; line++)
+        {
+            exti.set_level(line, true);
+            exti.set_level(line, false);
+        }
+    }
+
+    const std::vector<uint8_t> expected{0, 1, 2, 2, 0, 1, 2, 2};
+    EXPECT_EQ(log, expected);
+    EXPECT_EQ(exti.edges(), 8u);
+}
+
+TEST_F(ExtiDispatcherTest, SameLevelIsNotAnEdge)
+{
+    Probe p = probe(5);
+    ASSERT_TRUE(dispatcher.attach(5, GpioEdge::BOTH, &Probe::callback, &p));
+
+    EXPECT_TRUE(exti.set_level(5, true));
+    EXPECT_FALSE(exti.set_level(5, true));
+    EXPECT_TRUE(exti.level(5));
+    EXPECT_TRUE(exti.set_level(5, false));
+    EXPECT_FALSE(exti.set_level(5, false));
+    EXPECT_EQ(log.size(), 2u);
+}
+
+TEST_F(ExtiDispatcherTest, DetachedLineIsIgnored)
+{
+    Probe p = probe(9);
+    ASSERT_TRUE(dispatcher.attach(9, GpioEdge::BOTH, &Probe::callback, &p));
+    dispatcher.detach(9);
+
+    EXPECT_FALSE(exti.set_level(9, true));
+    EXPECT_FALSE(exti.inject(9, GpioEdge::FALLING));
+    // The level is still tracked, so the next edge after re-attach is real
+    EXPECT_TRUE(exti.level(9));
+    EXPECT_FALSE(exti.set_level(ExtiDispatcher::NUM_LINES, true));
+    EXPECT_TRUE(log.empty());
+}
+
+TEST_F(ExtiDispatcherTest, SharedVectorRunsLowestLineFirst)
+{
+    // Lines 10..15 share EXTI15_10_IRQHandler; 7 and 5 share EXTI9_5
+    Probe probes[] = {probe(5), probe(7), probe(10), probe(15)};
+    for (Probe& p : probes)
+        ASSERT_TRUE(
+            dispatcher.attach(p.line, GpioEdge::BOTH, &Probe::callback, &p));
+
+    // Line 12 is pending but has no handler
+    const uint32_t pending = (1u << 15) | (1u << 12) | (1u << 10) |
+                             (1u << 7) | (1u << 5);
+    dispatcher.dispatch(pending, 0, [] { return 0u; });
+
+    const std::vector<uint8_t> expected{5, 7, 10, 15};
+    EXPECT_EQ(log, expected);
+}
+
+TEST_F(ExtiDispatcherTest, LatencyStats)
+{
+    Probe a = probe(1);
+    Probe b = probe(4);
+    ASSERT_TRUE(dispatcher.attach(1, GpioEdge::BOTH, &Probe::callback, &a));
+    ASSERT_TRUE(dispatcher.attach(4, GpioEdge::BOTH, &Probe::callback, &b));
+
+    // A cycle counter that moves 12 cycles per read, from entry at 100
+    uint32_t cycles = 100;
+    auto now = [&cycles] { return cycles += 12; };
+    dispatcher.dispatch((1u << 1) | (1u << 4), 100, now);
+    EXPECT_EQ(dispatcher.last_latency_cycles(), 24u);
+    EXPECT_EQ(dispatcher.max_latency_cycles(), 24u);
+
+    // Counter wraps between entry and handler
+    cycles = UINT32_MAX - 3;
+    dispatcher.dispatch(1u << 1, UINT32_MAX - 5, now);
+    EXPECT_EQ(dispatcher.last_latency_cycles(), 14u);
+    EXPECT_EQ(dispatcher.max_latency_cycles(), 24u);
+
+    dispatcher.reset_stats();
+    EXPECT_EQ(dispatcher.last_latency_cycles(), 0u);
+    EXPECT_EQ(dispatcher.max_latency_cycles(), 0u);
+    EXPECT_EQ(log.size(), 3u);
+}
+
+}  // namespace
+}  // namespace MM
@@ -0,0 +1,167 @@
+/**
+ * @file gpio_port_test.cc
+ * @brief Register accesses made by BasicGpioPort
+ * @author TJ
+ * @date 2026-10-18
+ * @details FakeGpioRegs models BSRR, ODR and IDR closely enough to count
+ * every load and store and to apply BSRR writes to ODR, set winning over
+ * reset as on the part.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <functional>
+#include "gpio_port.h"
+
+namespace MM
+{
+namespace
+{
+
+struct FakeGpioRegs
+{
+    /**
+     * @brief Readable register that counts its loads
+     */
+    struct Counted
+    {
+        /**
+         * @brief Load, then run @p on_load as if an interrupt hit just
+         * after the load instruction
+         */
+        operator uint32_t() const
+        {
+            const uint32_t loaded = value;
+            loads++;
+            if (on_load)
+                on_load();
+            return loaded;
+        }
+
+        uint32_t value = 0;
+        mutable uint32_t loads = 0;
+        std::function<void()> on_load;
+    };
+
+    /**
+     * @brief Write-only BSRR, applied to ODR on every store
+     */
+    struct Bsrr
+    {
+        Bsrr& operator=(uint32_t bits)
+        {
+            stores++;
+            last = bits;
+            const uint32_t set = bits & 0xFFFFu;
+            const uint32_t reset = (bits >> 16) & ~set;
+            odr->value = (odr->value & ~reset) | set;
+            return *this;
+        }
+
+        Counted* odr;
+        uint32_t stores = 0;
+        uint32_t last = 0;
+    };
+
+    Counted ODR;
+    Counted IDR;
+    Bsrr BSRR{&ODR};
+
+    uint32_t accesses() const
+    {
+        return ODR.loads + IDR.loads + BSRR.stores;
+    }
+};
+
+using IrEmitters = PinGroup<0, 1, 4, 5>;
+
+class GpioPortTest : public ::testing::Test
+{
+protected:
+    FakeGpioRegs regs;
+    BasicGpioPort<FakeGpioRegs> port{&regs};
+};
+
+TEST_F(GpioPortTest, EachOperationIsOneRegisterAccess)
+{
+    port.set(IrEmitters{});
+    EXPECT_EQ(regs.BSRR.stores, 1u);
+    EXPECT_EQ(regs.BSRR.last, 0x0033u);
+    EXPECT_EQ(regs.ODR.value, 0x0033u);
+
+    port.clear(IrEmitters{});
+    EXPECT_EQ(regs.BSRR.stores, 2u);
+    EXPECT_EQ(regs.BSRR.last, 0x0033u << 16);
+    EXPECT_EQ(regs.ODR.value, 0u);
+
+    port.write(IrEmitters::mask, 0x0003);
+    EXPECT_EQ(regs.BSRR.stores, 3u);
+    EXPECT_EQ(regs.BSRR.last, 0x0003u | (0x0030u << 16));
+    EXPECT_EQ(regs.ODR.value, 0x0003u);
+
+    port.set_clear(0x8000, 0x0001);
+    EXPECT_EQ(regs.ODR.value, 0x8002u);
+
+    // Nothing above reads back ODR or BSRR
+    EXPECT_EQ(regs.ODR.loads, 0u);
+    EXPECT_EQ(regs.accesses(), 4u);
+}
+
+TEST_F(GpioPortTest, ReadMaskIsOneIdrLoad)
+{
+    regs.IDR.value = 0xA5A5;
+    EXPECT_EQ(port.read_mask(IrEmitters{}), 0x0021u);
+    EXPECT_EQ(port.read_mask(0xFF00), 0xA500u);
+    EXPECT_EQ(regs.IDR.loads, 2u);
+    EXPECT_EQ(regs.accesses(), 2u);
+}
+
+TEST_F(GpioPortTest, SetWinsWhenBothMasksHaveAPin)
+{
+    regs.ODR.value = 0x0000;
+    port.set_clear(0x0011, 0x0110);
+    EXPECT_EQ(regs.ODR.value, 0x0011u);
+}
+
+TEST_F(GpioPortTest, WriteLeavesOtherPinsAlone)
+{
+    regs.ODR.value = 0xF00F;
+    port.write(0x00F0, 0xFFFF);
+    EXPECT_EQ(regs.ODR.value, 0xF0FFu);
+    port.write(0xF000, 0x0000);
+    EXPECT_EQ(regs.ODR.value, 0x00FFu);
+}
+
+TEST_F(GpioPortTest, ToggleIsOneLoadAndOneStore)
+{
+    regs.ODR.value = 0x0011;
+    port.toggle(IrEmitters::mask);
+    EXPECT_EQ(regs.ODR.value, 0x0022u);
+    EXPECT_EQ(regs.ODR.loads, 1u);
+    EXPECT_EQ(regs.BSRR.stores, 1u);
+    EXPECT_EQ(regs.BSRR.last, 0x0022u | (0x0011u << 16));
+}
+
+TEST_F(GpioPortTest, ToggleRaceOnlyAffectsMaskedPins)
+{
+    // An interrupt sets pins 0 and 8 between toggle's ODR load and store
+    regs.ODR.value = 0x0000;
+    regs.ODR.on_load = [this] { regs.BSRR = 0x0101; };
+    port.toggle(0x0003);
+
+    // Pin 8 is outside the mask and keeps the interrupt's level
+    EXPECT_TRUE(regs.ODR.value & 0x0100u);
+    // Pin 0 is inverted from the stale load and stays high; had the
+    // interrupt run first, the toggle would have driven it low. This is
+    // the race the warning on toggle() documents.
+    EXPECT_EQ(regs.ODR.value, 0x0103u);
+
+    // Same the other way round: the interrupt clears pin 0, toggle clears
+    // it again instead of setting it
+    regs.ODR.on_load = [this] { regs.BSRR = 0x0001u << 16; };
+    port.toggle(0x0001);
+    EXPECT_EQ(regs.ODR.value, 0x0102u);
+}
+
+}  // namespace
+}  // namespace MM
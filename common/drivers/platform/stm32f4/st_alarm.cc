@@ -0,0 +1,72 @@
+#include "st_alarm.h"
+#include "timebase.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+
+HwAlarm::HwAlarm(const StAlarmParams& params_)
+    : base_addr(params_.base_addr),
+      irq(params_.irq),
+      handler(nullptr),
+      ctx(nullptr)
+{
+}
+
+bool HwAlarm::init()
+{
+    if (base_addr == nullptr)
+        return false;
+
+    base_addr->DIER &= ~TIM_DIER_CC1IE;
+    // CC1S = 00 (output), OC1M = 000 (frozen): compare only raises CC1IF
+    base_addr->CCMR1 &= ~(TIM_CCMR1_CC1S | TIM_CCMR1_OC1M);
+    base_addr->CCER &= ~TIM_CCER_CC1E;
+    base_addr->SR = ~TIM_SR_CC1IF;
+
+    NVIC_ClearPendingIRQ(irq);
+    NVIC_EnableIRQ(irq);
+    return true;
+}
+
+void HwAlarm::set_handler(Handler handler_, void* ctx_)
+{
+    handler = handler_;
+    ctx = ctx_;
+}
+
+void HwAlarm::arm(uint32_t deadline_us)
+{
+    base_addr->DIER &= ~TIM_DIER_CC1IE;
+    base_addr->CCR1 = deadline_us;
+    base_addr->SR = ~TIM_SR_CC1IF;
+    base_addr->DIER |= TIM_DIER_CC1IE;
+
+    // The comparator only matches on equality, so a deadline the counter
+    // has already passed would wait a full wrap; raise the event by hand
+    if (Utils::reached(deadline_us, base_addr->CNT))
+        base_addr->EGR = TIM_EGR_CC1G;
+}
+
+void HwAlarm::disarm()
+{
+    base_addr->DIER &= ~TIM_DIER_CC1IE;
+    base_addr->SR = ~TIM_SR_CC1IF;
+}
+
+void HwAlarm::irq_handler()
+{
+    if ((base_addr->SR & TIM_SR_CC1IF) == 0 ||
+        (base_addr->DIER & TIM_DIER_CC1IE) == 0)
+        return;
+
+    // One-shot: the service re-arms for its next deadline
+    base_addr->SR = ~TIM_SR_CC1IF;
+    base_addr->DIER &= ~TIM_DIER_CC1IE;
+    if (handler != nullptr)
+        handler(ctx);
+}
+
+}  // namespace Stmf4
+}  // namespace MM
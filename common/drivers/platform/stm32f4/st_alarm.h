@@ -0,0 +1,56 @@
+/**
+ * @file st_alarm.h
+ * @brief STM32F4 output-compare alarm on the timebase timer
+ * @author Kent Hong
+ * @date 2026-10-18
+ */
+
+#pragma once
+#include "alarm.h"
+#include "stm32f411xe.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+
+struct StAlarmParams
+{
+    TIM_TypeDef* base_addr;  ///< Must be the timer running the timebase
+    IRQn_Type irq;           ///< Its global interrupt, e.g. TIM5_IRQn
+};
+
+/**
+ * @class HwAlarm
+ * @brief Alarm on channel 1 of the free-running 1 MHz timebase timer
+ * @note The BSP must call irq_handler() from the timer's IRQ handler.
+ */
+class HwAlarm : public Alarm
+{
+public:
+    explicit HwAlarm(const StAlarmParams& params_);
+
+    /**
+    * @brief Put CH1 in frozen output-compare mode and enable the IRQ
+    * @note timebase_init() must already have started the timer.
+    */
+    bool init();
+
+    void set_handler(Handler handler_, void* ctx_) override;
+    void arm(uint32_t deadline_us) override;
+    void disarm() override;
+
+    /**
+    * @brief Acknowledge the compare event and run the handler
+    */
+    void irq_handler();
+
+private:
+    TIM_TypeDef* base_addr;
+    IRQn_Type irq;
+    Handler handler;
+    void* ctx;
+};
+
+}  // namespace Stmf4
+}  // namespace MM
@@ -0,0 +1,178 @@
+#include "st_clock.h"
+#include "stm32f4xx.h"
+#include "timebase.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+
+static ClockTree active_tree = kResetClock.tree;
+
+// Ready flags normally assert within a few hundred microseconds; bound the
+// wait by iterations because the timebase depends on the clock being set
+static constexpr uint32_t kReadyTimeout = 100000;
+
+static bool wait_set(volatile uint32_t& reg, uint32_t mask, uint32_t value)
+{
+    for (uint32_t i = 0; i < kReadyTimeout; i++)
+    {
+        if ((reg & mask) == value)
+            return true;
+    }
+    return false;
+}
+
+static uint32_t hpre_bits(uint32_t div)
+{
+    switch (div)
+    {
+        case 2:
+            return RCC_CFGR_HPRE_DIV2;
+        case 4:
+            return RCC_CFGR_HPRE_DIV4;
+        case 8:
+            return RCC_CFGR_HPRE_DIV8;
+        case 16:
+            return RCC_CFGR_HPRE_DIV16;
+        case 64:
+            return RCC_CFGR_HPRE_DIV64;
+        case 128:
+            return RCC_CFGR_HPRE_DIV128;
+        case 256:
+            return RCC_CFGR_HPRE_DIV256;
+        case 512:
+            return RCC_CFGR_HPRE_DIV512;
+        default:
+            return RCC_CFGR_HPRE_DIV1;
+    }
+}
+
+// PPRE encoding: 0xx = /1, 100 = /2, 101 = /4, 110 = /8, 111 = /16
+static uint32_t ppre_bits(uint32_t div)
+{
+    switch (div)
+    {
+        case 2:
+            return 0b100;
+        case 4:
+            return 0b101;
+        case 8:
+            return 0b110;
+        case 16:
+            return 0b111;
+        default:
+            return 0b000;
+    }
+}
+
+static void set_flash(uint32_t latency)
+{
+    FLASH->ACR = (latency << FLASH_ACR_LATENCY_Pos) | FLASH_ACR_PRFTEN |
+                 FLASH_ACR_ICEN | FLASH_ACR_DCEN;
+    // RM0383 3.4.1: read ACR back before running at the new frequency
+    while ((FLASH->ACR & FLASH_ACR_LATENCY) !=
+           (latency << FLASH_ACR_LATENCY_Pos))
+    {
+    }
+}
+
+bool clock_init(const ClockConfig& config)
+{
+    if (!config.valid)
+        return false;
+
+    // Run from HSI while the PLL is reconfigured
+    RCC->CR |= RCC_CR_HSION;
+    if (!wait_set(RCC->CR, RCC_CR_HSIRDY, RCC_CR_HSIRDY))
+        return false;
+    RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_SW) | RCC_CFGR_SW_HSI;
+    if (!wait_set(RCC->CFGR, RCC_CFGR_SWS, RCC_CFGR_SWS_HSI))
+        return false;
+
+    if (config.source == ClockSource::HSE)
+    {
+        RCC->CR |= RCC_CR_HSEON;
+        if (!wait_set(RCC->CR, RCC_CR_HSERDY, RCC_CR_HSERDY))
+            return false;
+    }
+
+    // Scale 1 regulator output is required above 84 MHz. The read-back
+    // covers the delay before a freshly enabled peripheral clock is live
+    RCC->APB1ENR |= RCC_APB1ENR_PWREN;
+    (void)RCC->APB1ENR;
+    PWR->CR |= PWR_CR_VOS;
+
+    // Going faster: wait states must be raised before the switch
+    const uint32_t current_latency = FLASH->ACR & FLASH_ACR_LATENCY;
+    if (config.flash_latency > current_latency)
+        set_flash(config.flash_latency);
+
+    RCC->CFGR = (RCC->CFGR & ~(RCC_CFGR_HPRE | RCC_CFGR_PPRE1 |
+                               RCC_CFGR_PPRE2)) |
+                hpre_bits(config.ahb_div) |
+                (ppre_bits(config.apb1_div) << RCC_CFGR_PPRE1_Pos) |
+                (ppre_bits(config.apb2_div) << RCC_CFGR_PPRE2_Pos);
+
+    RCC->CR &= ~RCC_CR_PLLON;
+    if (!wait_set(RCC->CR, RCC_CR_PLLRDY, 0))
+        return false;
+
+    uint32_t sw = config.source == ClockSource::HSE ? RCC_CFGR_SW_HSE
+                                                     : RCC_CFGR_SW_HSI;
+    uint32_t sws = config.source == ClockSource::HSE ? RCC_CFGR_SWS_HSE
+                                                      : RCC_CFGR_SWS_HSI;
+    if (config.use_pll)
+    {
+        RCC->PLLCFGR =
+            (config.pllm << RCC_PLLCFGR_PLLM_Pos) |
+            (config.plln << RCC_PLLCFGR_PLLN_Pos) |
+            (((config.pllp / 2) - 1) << RCC_PLLCFGR_PLLP_Pos) |
+            (config.source == ClockSource::HSE ? RCC_PLLCFGR_PLLSRC_HSE
+                                                : RCC_PLLCFGR_PLLSRC_HSI) |
+            (config.pllq << RCC_PLLCFGR_PLLQ_Pos);
+        RCC->CR |= RCC_CR_PLLON;
+        if (!wait_set(RCC->CR, RCC_CR_PLLRDY, RCC_CR_PLLRDY))
+            return false;
+
+        // The new VOS only takes effect once the PLL runs; the regulator
+        // must be ready before SYSCLK moves onto it
+        if (!wait_set(PWR->CSR, PWR_CSR_VOSRDY, PWR_CSR_VOSRDY))
+            return false;
+        sw = RCC_CFGR_SW_PLL;
+        sws = RCC_CFGR_SWS_PLL;
+    }
+
+    RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_SW) | sw;
+    if (!wait_set(RCC->CFGR, RCC_CFGR_SWS, sws))
+        return false;
+
+    // Drop to the configured wait states (no-op when speeding up)
+    set_flash(config.flash_latency);
+
+    active_tree = config.tree;
+    SystemCoreClock = config.tree.hclk_hz;
+
+    // Delays and now_us() scale with the clock: keep the timer the BSP
+    // chose, at its new kernel clock
+    Utils::TimebaseConfig timebase = Utils::timebase_config();
+    timebase.core_clock_hz = config.tree.hclk_hz;
+    timebase.timer_clock_hz = timer_clock_hz(
+        reinterpret_cast<const TIM_TypeDef*>(timebase.timer_base));
+    return Utils::timebase_init(timebase);
+}
+
+const ClockTree& clock_tree()
+{
+    return active_tree;
+}
+
+uint32_t timer_clock_hz(const TIM_TypeDef* tim)
+{
+    if (tim == TIM1 || tim == TIM9 || tim == TIM10 || tim == TIM11)
+        return active_tree.apb2_timer_hz;
+    return active_tree.apb1_timer_hz;
+}
+
+}  // namespace Stmf4
+}  // namespace MM
@@ -0,0 +1,42 @@
+/**
+ * @file st_clock.h
+ * @brief STM32F4 clock-tree bring-up and frequency registry
+ * @author Kent Hong
+ * @date 2026-10-18
+ */
+
+#pragma once
+#include "st_clock_config.h"
+#include "stm32f411xe.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+
+/**
+ * @brief Switch SYSCLK to the given configuration
+ * @details Raises VOS, flash wait states and the ART accelerator
+ * (prefetch, I-cache, D-cache) before speeding up, then programs the
+ * prescalers and the PLL and switches SYSCLK over. Updates
+ * SystemCoreClock and clock_tree(), and re-initialises the Utils timebase
+ * at the new frequency (on the same timer, if one was configured).
+ * @note Peripherals that derive timing from the clocks (HwPwm, HwI2c)
+ *       must be initialised after this call.
+ * @return true if successful, false if an oscillator or the PLL failed to
+ *         lock (the chip is then left on HSI)
+ */
+bool clock_init(const ClockConfig& config);
+
+/**
+ * @brief Frequencies currently in effect (reset values before clock_init)
+ */
+const ClockTree& clock_tree();
+
+/**
+ * @brief Kernel clock of a timer in Hz (APB1 or APB2 timer clock)
+ */
+uint32_t timer_clock_hz(const TIM_TypeDef* tim);
+
+}  // namespace Stmf4
+}  // namespace MM
@@ -0,0 +1,90 @@
+#include "st_encoder.h"
+#include "reg_helpers.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+static constexpr uint8_t kTimSmcrSmsEncoderX4 = 3;  // Count TI1 and TI2 edges
+
+HwEncoder::HwEncoder(const StEncoderParams& params)
+    : base_addr{params.base_addr},
+      filter{params.filter},
+      invert{params.invert},
+      wide{false},
+      last_cnt{0},
+      position{0}
+{
+}
+
+bool HwEncoder::init()
+{
+    if (base_addr == nullptr || filter > 15)
+    {
+        return false;
+    }
+
+    if (base_addr == TIM2 || base_addr == TIM5)
+    {
+        wide = true;
+    }
+    else if (base_addr != TIM1 && base_addr != TIM3 && base_addr != TIM4)
+    {
+        // TIM9..TIM11 have no encoder interface
+        return false;
+    }
+
+    base_addr->CR1 = 0;
+    base_addr->SMCR = 0;
+    base_addr->CCER = 0;
+
+    // CC1/CC2 as inputs mapped on TI1/TI2, same filter on both
+    base_addr->CCMR1 = (1u << TIM_CCMR1_CC1S_Pos) |
+                       (1u << TIM_CCMR1_CC2S_Pos) |
+                       (static_cast<uint32_t>(filter) << TIM_CCMR1_IC1F_Pos) |
+                       (static_cast<uint32_t>(filter) << TIM_CCMR1_IC2F_Pos);
+
+    // Non-inverted TI2 counts up when TI1 leads; inverting TI1 flips that
+    if (invert)
+    {
+        base_addr->CCER |= TIM_CCER_CC1P;
+    }
+
+    SetReg(&base_addr->SMCR, kTimSmcrSmsEncoderX4, TIM_SMCR_SMS_Pos, 3);
+
+    base_addr->PSC = 0;
+    base_addr->ARR = wide ? 0xFFFFFFFFu : 0xFFFFu;
+    base_addr->CNT = 0;
+    base_addr->EGR = TIM_EGR_UG;
+    base_addr->SR = 0;
+    last_cnt = 0;
+    position = 0;
+
+    base_addr->CR1 = TIM_CR1_CEN;
+    return true;
+}
+
+int32_t HwEncoder::count()
+{
+    if (wide)
+    {
+        return static_cast<int32_t>(base_addr->CNT);
+    }
+
+    // 16-bit counter: the signed register delta is exact while reads are
+    // less than half a wrap apart
+    const uint16_t cnt = static_cast<uint16_t>(base_addr->CNT);
+    position += static_cast<int16_t>(cnt - last_cnt);
+    last_cnt = cnt;
+    return static_cast<int32_t>(position);
+}
+
+void HwEncoder::reset()
+{
+    base_addr->CNT = 0;
+    last_cnt = 0;
+    position = 0;
+}
+
+}  // namespace Stmf4
+}  // namespace MM
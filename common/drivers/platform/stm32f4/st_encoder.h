@@ -0,0 +1,54 @@
+/**
+ * @file st_encoder.h
+ * @brief STM32F4 quadrature encoder on a timer in encoder interface mode
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details The timer counts both edges of both channels (x4) in hardware,
+ * so there is no per-edge interrupt at any wheel speed. TIM2 and TIM5 have
+ * 32-bit counters; TIM1/TIM3/TIM4 are 16-bit and are extended in software
+ * on every read, which must then happen at least once per 32768 counts.
+ */
+
+#pragma once
+#include "encoder.h"
+#include "stm32f411xe.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+
+struct StEncoderParams
+{
+    TIM_TypeDef* base_addr;
+    uint8_t filter;  ///< IC1F/IC2F digital filter, 0 (off) .. 15 (RM0383 13.4.7)
+    bool invert;     ///< Swap the count direction
+};
+
+class HwEncoder : public Encoder
+{
+public:
+    explicit HwEncoder(const StEncoderParams& params_);
+
+    /**
+     * @brief Put the timer in encoder mode 3 and start counting
+     * @note The BSP enables the timer clock and puts CH1/CH2 pins in AF mode
+     * @return true if successful, false otherwise
+     */
+    bool init();
+
+    int32_t count() override;
+
+    void reset() override;
+
+private:
+    TIM_TypeDef* base_addr;
+    uint8_t filter;
+    bool invert;
+    bool wide;           ///< 32-bit counter, no extension needed
+    uint16_t last_cnt;   ///< Extension state for 16-bit timers
+    uint32_t position;
+};
+
+}  // namespace Stmf4
+}  // namespace MM
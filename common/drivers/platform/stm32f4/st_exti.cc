@@ -0,0 +1,160 @@
+#include "st_exti.h"
+#include "stm32f4xx.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+namespace Exti
+{
+
+static ExtiDispatcher table;
+
+static int8_t port_index(const GPIO_TypeDef* port)
+{
+    if (port == GPIOA)
+        return 0;
+    if (port == GPIOB)
+        return 1;
+    if (port == GPIOC)
+        return 2;
+    if (port == GPIOD)
+        return 3;
+    if (port == GPIOE)
+        return 4;
+    if (port == GPIOH)
+        return 7;
+    return -1;
+}
+
+static IRQn_Type line_irq(uint8_t line)
+{
+    switch (line)
+    {
+        case 0:
+            return EXTI0_IRQn;
+        case 1:
+            return EXTI1_IRQn;
+        case 2:
+            return EXTI2_IRQn;
+        case 3:
+            return EXTI3_IRQn;
+        case 4:
+            return EXTI4_IRQn;
+        default:
+            return line <= 9 ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+    }
+}
+
+bool attach(GPIO_TypeDef* port, uint8_t pin, GpioEdge edge,
+            ExtiDispatcher::Handler handler, void* ctx, uint32_t priority)
+{
+    const int8_t index = port_index(port);
+    if (index < 0 || !table.attach(pin, edge, handler, ctx))
+        return false;
+
+    const uint32_t bit = 1u << pin;
+    EXTI->IMR &= ~bit;
+
+    // SYSCFG holds the line -> port mux, four lines per EXTICR register
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+    const uint32_t shift = (pin % 4u) * 4u;
+    SYSCFG->EXTICR[pin / 4u] =
+        (SYSCFG->EXTICR[pin / 4u] & ~(0xFu << shift)) |
+        (static_cast<uint32_t>(index) << shift);
+
+    const auto mask = static_cast<uint8_t>(edge);
+    if (mask & static_cast<uint8_t>(GpioEdge::RISING))
+        EXTI->RTSR |= bit;
+    else
+        EXTI->RTSR &= ~bit;
+    if (mask & static_cast<uint8_t>(GpioEdge::FALLING))
+        EXTI->FTSR |= bit;
+    else
+        EXTI->FTSR &= ~bit;
+
+    EXTI->PR = bit;  // Drop an edge latched before attach
+    EXTI->IMR |= bit;
+
+    const IRQn_Type irq = line_irq(pin);
+    NVIC_SetPriority(irq, priority);
+    NVIC_EnableIRQ(irq);
+    return true;
+}
+
+bool detach(GPIO_TypeDef* port, uint8_t pin)
+{
+    const int8_t index = port_index(port);
+    if (index < 0 || !table.attached(pin))
+        return false;
+
+    // Only the port currently selected in the mux owns the line
+    const uint32_t shift = (pin % 4u) * 4u;
+    const uint32_t routed = (SYSCFG->EXTICR[pin / 4u] >> shift) & 0xFu;
+    if (routed != static_cast<uint32_t>(index))
+        return false;
+
+    EXTI->IMR &= ~(1u << pin);
+    EXTI->PR = 1u << pin;
+    table.detach(pin);
+    return true;
+}
+
+ExtiDispatcher& dispatcher()
+{
+    return table;
+}
+
+/**
+ * @brief Common body of the EXTI vectors
+ * @details CYCCNT is sampled first so the recorded latency covers the
+ * whole software path from vector entry to the handler call.
+ */
+static inline void service(uint32_t lines)
+{
+    const uint32_t entry = DWT->CYCCNT;
+    const uint32_t pending = EXTI->PR & lines;
+    EXTI->PR = pending;  // rc_w1: clear before running, so re-edges latch
+    table.dispatch(pending, entry, [] { return DWT->CYCCNT; });
+}
+
+}  // namespace Exti
+}  // namespace Stmf4
+}  // namespace MM
+
+using MM::Stmf4::Exti::service;
+
+extern "C" void EXTI0_IRQHandler()
+{
+    service(1u << 0);
+}
+
+extern "C" void EXTI1_IRQHandler()
+{
+    service(1u << 1);
+}
+
+extern "C" void EXTI2_IRQHandler()
+{
+    service(1u << 2);
+}
+
+extern "C" void EXTI3_IRQHandler()
+{
+    service(1u << 3);
+}
+
+extern "C" void EXTI4_IRQHandler()
+{
+    service(1u << 4);
+}
+
+extern "C" void EXTI9_5_IRQHandler()
+{
+    service(0x03E0u);  // Lines 5..9
+}
+
+extern "C" void EXTI15_10_IRQHandler()
+{
+    service(0xFC00u);  // Lines 10..15
+}
@@ -0,0 +1,58 @@
+/**
+ * @file st_exti.h
+ * @brief STM32F4 EXTI edge interrupts for GPIO pins
+ * @author TJ
+ * @date 2026-10-18
+ */
+
+#pragma once
+#include <cstdint>
+#include "exti_dispatcher.h"
+#include "stm32f411xe.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+
+/**
+ * @brief EXTI lines 0..15, shared by all GPIO ports
+ * @details Line n can be routed to pin n of one port at a time. The
+ * EXTIx_IRQHandler functions are defined here and dispatch straight into
+ * the handler table.
+ */
+namespace Exti
+{
+
+/**
+ * @brief Route a pin to its EXTI line and enable the interrupt
+ * @param port GPIO port of the pin (GPIOA..GPIOH)
+ * @param pin Pin number 0..15 (= EXTI line)
+ * @param edge Edge(s) that trigger
+ * @param handler Called from the EXTI interrupt
+ * @param ctx Passed to @p handler
+ * @param priority NVIC priority of the line's interrupt
+ * @return false if the line is already in use or the arguments are invalid
+ */
+bool attach(GPIO_TypeDef* port, uint8_t pin, GpioEdge edge,
+            ExtiDispatcher::Handler handler, void* ctx,
+            uint32_t priority = 6);
+
+/**
+ * @brief Mask the line and free its table slot
+ * @param port GPIO port the line is expected to be routed to
+ * @param pin Pin number 0..15 (= EXTI line)
+ * @return false, leaving the line untouched, if it is not attached or
+ * SYSCFG routes it to a different port
+ */
+bool detach(GPIO_TypeDef* port, uint8_t pin);
+
+/**
+ * @brief Dispatcher holding the handler table and latency stats
+ */
+ExtiDispatcher& dispatcher();
+
+}  // namespace Exti
+
+}  // namespace Stmf4
+}  // namespace MM
@@ -1,4 +1,6 @@
 #include "st_gpio.h"
+#include "st_exti.h"
+#include "st_gpio_port.h"
 #include "mcu_support/stm32/f4xx/stm32f4xx.h"
 #include "stm32f411xe.h"
 
@@ -51,13 +53,16 @@ bool HwGpio::toggle(void)
 
 bool HwGpio::set(const bool active)
 {
+    // BSRR is write-only: one store, never a read-modify-write
+    GpioPort port{base_addr_};
+    const auto bit = static_cast<uint16_t>(1u << pin_num_);
     if (active)
     {
-        base_addr_->BSRR |= 1u << (pin_num_);
+        port.set(bit);
     }
     else
     {
-        base_addr_->BSRR |= 1u << (pin_num_ + 16);
+        port.clear(bit);
     }
     return true;
 }
@@ -67,5 +72,24 @@ bool HwGpio::read(void)
     return base_addr_->IDR & (1u << pin_num_);
 }
 
+bool HwGpio::attach_interrupt(GpioEdge edge, ExtiDispatcher::Handler handler,
+                              void* ctx)
+{
+    if (pin_num_ >= ST_GPIO_MAX_PINS)
+    {
+        return false;
+    }
+    return Exti::attach(base_addr_, pin_num_, edge, handler, ctx);
+}
+
+bool HwGpio::detach_interrupt(void)
+{
+    if (pin_num_ >= ST_GPIO_MAX_PINS)
+    {
+        return false;
+    }
+    return Exti::detach(base_addr_, pin_num_);
+}
+
 }  // namespace Stmf4
 }  // namespace MM
\ No newline at end of file
@@ -3,6 +3,7 @@
 #define ST_GPIO_H
 
 #include <cstdint>
+#include "exti_dispatcher.h"
 #include "gpio.h"
 #include "mcu_support/stm32/f4xx/stm32f4xx.h"
 #include "stm32f411xe.h"
@@ -89,6 +90,24 @@ public:
     */
     bool read(void);
 
+    /**
+     * @brief Route this pin to its EXTI line and call @p handler on @p edge
+     * @details The pin should be configured as an input. Only one port can
+     * own a given pin number's line at a time.
+     * @return Returns true if success.
+     */
+    bool attach_interrupt(GpioEdge edge, ExtiDispatcher::Handler handler,
+                          void* ctx);
+
+    /**
+     * @brief Mask the pin's EXTI line
+     * @details Does nothing if the line is currently routed to another
+     * port, so one pin cannot tear down another port's handler.
+     * @return Returns true if the line was routed to this pin and is now
+     * detached.
+     */
+    bool detach_interrupt(void);
+
 private:
     StGpioSettings settings_;
     const uint8_t pin_num_;
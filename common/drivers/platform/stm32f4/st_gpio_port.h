@@ -0,0 +1,29 @@
+/**
+ * @file st_gpio_port.h
+ * @brief Whole-port GPIO access on the STM32F4
+ * @author TJ
+ * @date 2026-10-18
+ * @details See gpio_port.h for the access rules; this only binds the
+ * port to the device register block.
+ *
+ * @code
+ * using IrEmitters = MM::PinGroup<0, 1, 4, 5>;
+ * MM::Stmf4::GpioPort port_a(GPIOA);
+ * port_a.set(IrEmitters{});  // One BSRR write
+ * port_a.write(IrEmitters::mask, 0x0003);  // 0/1 on, 4/5 off
+ * @endcode
+ */
+
+#pragma once
+#include "gpio_port.h"
+#include "stm32f411xe.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+
+using GpioPort = BasicGpioPort<GPIO_TypeDef>;
+
+}  // namespace Stmf4
+}  // namespace MM
@@ -1,7 +1,8 @@
 #include "st_i2c.h"
 
 /**
-* The implementation in polling based I2C read and write functions
+* The implementation in polling based I2C read and write functions, plus
+* the event/error interrupt path selected by enable_irq()
 * We have data, len, reg_addr, dev_addr to do I2C read and write
 * @date 1/23/2026
 */
@@ -11,10 +12,36 @@ namespace MM
 namespace Stmf4
 {
 HwI2c::HwI2c(const StI2cParams& params)
-    : _base_addr{params.base_addr}, _ccr{params.ccr}, _trise{params.trise}
+    : _base_addr{params.base_addr},
+      _ccr{params.ccr},
+      _trise{params.trise},
+      _use_irq{false},
+      _job_ok{false},
+      _job_addr{0},
+      _job_reading{false},
+      _job_has_reg{false},
+      _job_reg{0},
+      _job_tx{nullptr},
+      _job_tx_len{0},
+      _job_rx{nullptr},
+      _job_rx_len{0},
+      _job_index{0}
 {
 }
 
+// Must stay numerically above configMAX_SYSCALL_INTERRUPT_PRIORITY (5) for
+// give_from_isr(); the same level as the HwSpi DMA interrupt
+static constexpr uint32_t kIrqPriority = 6;
+
+// A byte takes 90 us at 100 kHz; allow twice that plus START/STOP slack
+static constexpr uint32_t kIrqTimeoutBaseUs = 1000;
+static constexpr uint32_t kIrqTimeoutPerByteUs = 200;
+
+static constexpr uint32_t kIrqEnables =
+    I2C_CR2_ITEVTEN | I2C_CR2_ITBUFEN | I2C_CR2_ITERREN;
+static constexpr uint32_t kErrorFlags =
+    I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF | I2C_SR1_OVR;
+
 bool HwI2c::init()
 {
     if (_base_addr == nullptr)
@@ -25,6 +52,10 @@ bool HwI2c::init()
     // Reset peripheral
     _base_addr->CR1 &= ~I2C_CR1_PE;
 
+    // Peripheral clock in MHz, as published by clock_init()
+    _base_addr->CR2 = (_base_addr->CR2 & ~I2C_CR2_FREQ) |
+                      (clock_tree().pclk1_hz / 1000000U);
+
     // Configure timing (CCR and TRISE)
     _base_addr->CCR = _ccr;
     _base_addr->TRISE = _trise;
@@ -35,6 +66,22 @@ bool HwI2c::init()
     return true;
 }
 
+bool HwI2c::wait_bus_idle()
+{
+    // Wait for bus idle, try to recover if stuck
+    int timeout = 10000;
+    while ((_base_addr->SR2 & I2C_SR2_BUSY) && --timeout);
+    if (timeout == 0)
+    {
+        // Try to recover bus
+        _base_addr->CR1 |= I2C_CR1_STOP;
+        MM::Utils::DelayUs(10);
+        if (_base_addr->SR2 & I2C_SR2_BUSY)
+            return false;
+    }
+    return true;
+}
+
 bool HwI2c::mem_read(uint8_t* data, size_t len, const uint8_t reg_addr,
                      uint8_t dev_addr)
 {
@@ -49,21 +96,16 @@ bool HwI2c::mem_read(uint8_t* data, size_t len, const uint8_t reg_addr,
         return false;
     }
 
-    // Wait for bus idle, try to recover if stuck
-    int timeout = 10000;
-    while ((_base_addr->SR2 & I2C_SR2_BUSY) && --timeout);
-    if (timeout == 0)
-    {
-        // Try to recover bus
-        _base_addr->CR1 |= I2C_CR1_STOP;
-        MM::Utils::DelayUs(10);
-        if (_base_addr->SR2 & I2C_SR2_BUSY)
-            return false;
-    }
+    if (_use_irq)
+        return len > 0 &&
+               transfer_irq(dev_addr, &reg_addr, nullptr, 0, data, len);
+
+    if (!wait_bus_idle())
+        return false;
 
     // START, send address (write)
     _base_addr->CR1 |= I2C_CR1_START;
-    timeout = 10000;
+    int timeout = 10000;
     while (!(_base_addr->SR1 & I2C_SR1_SB) && --timeout);
     if (timeout == 0)
         return false;
@@ -188,21 +230,15 @@ bool HwI2c::mem_write(const uint8_t* data, size_t len, const uint8_t reg_addr,
     if (!(_base_addr->CR1 & I2C_CR1_PE))
         return false;
 
-    // Wait for bus idle, try to recover if stuck
-    int timeout = 10000;
-    while ((_base_addr->SR2 & I2C_SR2_BUSY) && --timeout);
-    if (timeout == 0)
-    {
-        // Try to recover bus
-        _base_addr->CR1 |= I2C_CR1_STOP;
-        MM::Utils::DelayUs(10);
-        if (_base_addr->SR2 & I2C_SR2_BUSY)
-            return false;
-    }
+    if (_use_irq)
+        return transfer_irq(dev_addr, &reg_addr, data, len, nullptr, 0);
+
+    if (!wait_bus_idle())
+        return false;
 
     // START, send address (write)
     _base_addr->CR1 |= I2C_CR1_START;
-    timeout = 10000;
+    int timeout = 10000;
     while (!(_base_addr->SR1 & I2C_SR1_SB) && --timeout);
     if (timeout == 0)
         return false;
@@ -250,21 +286,16 @@ bool HwI2c::write(const uint8_t* data, size_t len, uint8_t dev_addr)
     if (!(_base_addr->CR1 & I2C_CR1_PE))
         return false;
 
-    // Wait for bus idle, try to recover if stuck
-    int timeout = 10000;
-    while ((_base_addr->SR2 & I2C_SR2_BUSY) && --timeout);
-    if (timeout == 0)
-    {
-        // Try to recover bus
-        _base_addr->CR1 |= I2C_CR1_STOP;
-        MM::Utils::DelayUs(10);
-        if (_base_addr->SR2 & I2C_SR2_BUSY)
-            return false;
-    }
+    if (_use_irq)
+        return len > 0 &&
+               transfer_irq(dev_addr, nullptr, data, len, nullptr, 0);
+
+    if (!wait_bus_idle())
+        return false;
 
     // START, send address (write)
     _base_addr->CR1 |= I2C_CR1_START;
-    timeout = 10000;
+    int timeout = 10000;
     while (!(_base_addr->SR1 & I2C_SR1_SB) && --timeout);
     if (timeout == 0)
         return false;
@@ -303,21 +334,16 @@ bool HwI2c::read(uint8_t* data, size_t len, uint8_t dev_addr)
     if (!(_base_addr->CR1 & I2C_CR1_PE))
         return false;
 
-    // Wait for bus idle, try to recover if stuck
-    int timeout = 10000;
-    while ((_base_addr->SR2 & I2C_SR2_BUSY) && --timeout);
-    if (timeout == 0)
-    {
-        // Try to recover bus
-        _base_addr->CR1 |= I2C_CR1_STOP;
-        MM::Utils::DelayUs(10);
-        if (_base_addr->SR2 & I2C_SR2_BUSY)
-            return false;
-    }
+    if (_use_irq)
+        return len > 0 &&
+               transfer_irq(dev_addr, nullptr, nullptr, 0, data, len);
+
+    if (!wait_bus_idle())
+        return false;
 
     // START, send address (read)
     _base_addr->CR1 |= I2C_CR1_START;
-    timeout = 10000;
+    int timeout = 10000;
     while (!(_base_addr->SR1 & I2C_SR1_SB) && --timeout);
     if (timeout == 0)
         return false;
@@ -356,5 +382,222 @@ bool HwI2c::read(uint8_t* data, size_t len, uint8_t dev_addr)
     return true;
 }
 
+bool HwI2c::bus_clear()
+{
+    if (_base_addr == nullptr)
+        return false;
+
+    // SWRST clears every I2C register, so the timing has to be re-applied
+    _base_addr->CR1 |= I2C_CR1_SWRST;
+    _base_addr->CR1 &= ~I2C_CR1_SWRST;
+    if (!init())
+        return false;
+
+    return !(_base_addr->SR2 & I2C_SR2_BUSY);
+}
+
+bool HwI2c::enable_irq(IRQn_Type ev_irq, IRQn_Type er_irq)
+{
+    if (_base_addr == nullptr)
+        return false;
+
+    _base_addr->CR2 &= ~kIrqEnables;
+    NVIC_SetPriority(ev_irq, kIrqPriority);
+    NVIC_SetPriority(er_irq, kIrqPriority);
+    NVIC_ClearPendingIRQ(ev_irq);
+    NVIC_ClearPendingIRQ(er_irq);
+    NVIC_EnableIRQ(ev_irq);
+    NVIC_EnableIRQ(er_irq);
+    _use_irq = true;
+    return true;
+}
+
+/**
+ * @brief One START ... STOP transaction driven by ev_irq_handler()
+ * @param reg Register address sent before @p tx, or nullptr for none
+ * @details With both a register and @p rx, the write phase ends in a
+ * repeated START and the read phase follows (mem_read()).
+ */
+bool HwI2c::transfer_irq(uint8_t dev_addr, const uint8_t* reg,
+                         const uint8_t* tx, size_t tx_len, uint8_t* rx,
+                         size_t rx_len)
+{
+    if (!wait_bus_idle())
+        return false;
+
+    _job_addr = dev_addr;
+    _job_has_reg = reg != nullptr;
+    _job_reg = reg != nullptr ? *reg : 0;
+    _job_tx = tx;
+    _job_tx_len = tx_len;
+    _job_rx = rx;
+    _job_rx_len = rx_len;
+    _job_reading = reg == nullptr && tx_len == 0;
+    _job_index = 0;
+    _job_ok = false;
+    _done.reset();
+
+    _base_addr->CR1 = (_base_addr->CR1 & ~I2C_CR1_POS) | I2C_CR1_ACK;
+    _base_addr->CR2 |= kIrqEnables;
+    _base_addr->CR1 |= I2C_CR1_START;
+
+    const uint32_t bytes = static_cast<uint32_t>(tx_len + rx_len) + 2;
+    const bool taken =
+        _done.take(kIrqTimeoutBaseUs + kIrqTimeoutPerByteUs * bytes);
+    if (!taken)
+    {
+        _base_addr->CR2 &= ~kIrqEnables;
+        _base_addr->CR1 |= I2C_CR1_STOP;
+    }
+
+    // Let the STOP go out before touching CR1 again
+    int timeout = 10000;
+    while ((_base_addr->CR1 & I2C_CR1_STOP) && --timeout);
+    _base_addr->CR1 = (_base_addr->CR1 & ~I2C_CR1_POS) | I2C_CR1_ACK;
+    return taken && _job_ok;
+}
+
+void HwI2c::ev_irq_handler()
+{
+    // Reading SR1 then writing DR clears SB
+    const uint32_t sr1 = _base_addr->SR1;
+    if (sr1 & I2C_SR1_SB)
+    {
+        _base_addr->DR = (_job_addr << 1) | (_job_reading ? 1 : 0);
+        return;
+    }
+    if (sr1 & I2C_SR1_ADDR)
+    {
+        on_addr();
+        return;
+    }
+    if (_job_reading)
+        on_rx(sr1);
+    else
+        on_tx(sr1);
+}
+
+void HwI2c::on_addr()
+{
+    if (!_job_reading)
+    {
+        (void)_base_addr->SR2;
+        return;
+    }
+
+    // ACK/STOP must be set up before ADDR is cleared (RM0383, master
+    // receiver)
+    const size_t n = _job_rx_len;
+    if (n == 1)
+    {
+        _base_addr->CR1 &= ~I2C_CR1_ACK;
+        (void)_base_addr->SR2;
+        _base_addr->CR1 |= I2C_CR1_STOP;
+    }
+    else if (n == 2)
+    {
+        // NACK the second byte; both are read on BTF
+        _base_addr->CR1 = (_base_addr->CR1 & ~I2C_CR1_ACK) | I2C_CR1_POS;
+        (void)_base_addr->SR2;
+        _base_addr->CR2 &= ~I2C_CR2_ITBUFEN;
+    }
+    else
+    {
+        _base_addr->CR1 |= I2C_CR1_ACK;
+        if (n == 3)
+            _base_addr->CR2 &= ~I2C_CR2_ITBUFEN;
+        (void)_base_addr->SR2;
+    }
+}
+
+void HwI2c::on_tx(uint32_t sr1)
+{
+    if ((_base_addr->CR2 & I2C_CR2_ITBUFEN) && (sr1 & I2C_SR1_TXE))
+    {
+        if (_job_has_reg)
+        {
+            _base_addr->DR = _job_reg;
+            _job_has_reg = false;
+            return;
+        }
+        if (_job_index < _job_tx_len)
+        {
+            _base_addr->DR = _job_tx[_job_index++];
+            return;
+        }
+        // Nothing left to queue; wait for the last byte on BTF
+        _base_addr->CR2 &= ~I2C_CR2_ITBUFEN;
+    }
+    if (!(sr1 & I2C_SR1_BTF))
+        return;
+
+    if (_job_rx_len > 0)
+    {
+        // Register sent, turn the bus around with a repeated START
+        _job_reading = true;
+        _job_index = 0;
+        _base_addr->CR1 |= I2C_CR1_START;
+        _base_addr->CR2 |= I2C_CR2_ITBUFEN;
+        return;
+    }
+    _base_addr->CR1 |= I2C_CR1_STOP;
+    finish(true);
+}
+
+void HwI2c::on_rx(uint32_t sr1)
+{
+    if (_base_addr->CR2 & I2C_CR2_ITBUFEN)
+    {
+        if (!(sr1 & I2C_SR1_RXNE))
+            return;
+        _job_rx[_job_index++] = _base_addr->DR;
+        const size_t left = _job_rx_len - _job_index;
+        if (left == 0)
+            finish(true);  // Single byte, STOP already set
+        else if (left == 3)
+            _base_addr->CR2 &= ~I2C_CR2_ITBUFEN;  // Finish the last 3 on BTF
+        return;
+    }
+    if (!(sr1 & I2C_SR1_BTF))
+        return;
+
+    // BTF: one byte in DR and one in the shift register
+    const size_t left = _job_rx_len - _job_index;
+    if (left == 3)
+    {
+        _base_addr->CR1 &= ~I2C_CR1_ACK;
+        _job_rx[_job_index++] = _base_addr->DR;
+    }
+    else
+    {
+        _base_addr->CR1 |= I2C_CR1_STOP;
+        _job_rx[_job_index++] = _base_addr->DR;
+        _job_rx[_job_index++] = _base_addr->DR;
+        finish(true);
+    }
+}
+
+void HwI2c::er_irq_handler()
+{
+    const uint32_t errors = _base_addr->SR1 & kErrorFlags;
+    if (errors == 0)
+        return;
+
+    // The error flags are cleared by writing 0; the rest of SR1 ignores it
+    _base_addr->SR1 = ~errors & 0xFFFFU;
+    // A lost arbitration already left master mode; anything else must
+    // release the bus
+    if (errors & (I2C_SR1_AF | I2C_SR1_BERR))
+        _base_addr->CR1 |= I2C_CR1_STOP;
+    finish(false);
+}
+
+void HwI2c::finish(bool ok)
+{
+    _base_addr->CR2 &= ~kIrqEnables;
+    _job_ok = ok;
+    _done.give_from_isr();
+}
+
 }  // namespace Stmf4
 }  // namespace MM
\ No newline at end of file
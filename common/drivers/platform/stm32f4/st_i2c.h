@@ -5,6 +5,8 @@
 #include <cstddef>
 #include "delay.h"
 #include "i2c.h"
+#include "rtos.h"
+#include "st_clock.h"
 #include "mcu_support/stm32/f4xx/stm32f4xx.h"
 #include "stm32f411xe.h"
 
@@ -20,6 +22,44 @@ struct StI2cParams
     uint8_t trise;  // Maximum rise time register value
 };
 
+/**
+ * @brief Compute CCR/TRISE for a bus speed from the PCLK1 frequency
+ * @details Standard mode (<= 100 kHz): Thigh = Tlow = CCR * Tpclk, 1000 ns
+ * max rise time. Fast mode (<= 400 kHz, DUTY = 0): Tlow = 2 * Thigh,
+ * 300 ns max rise time. The F/S bit is folded into the returned ccr.
+ * @param pclk1_hz APB1 clock, e.g. ClockConfig::tree.pclk1_hz
+ * @param bus_hz SCL frequency
+ */
+constexpr StI2cParams i2c_timing(I2C_TypeDef* base_addr, uint32_t pclk1_hz,
+                                 uint32_t bus_hz)
+{
+    const uint32_t pclk_mhz = pclk1_hz / 1000000U;
+    if (bus_hz <= 100000U)
+    {
+        uint32_t ccr = (pclk1_hz + 2 * bus_hz - 1) / (2 * bus_hz);
+        ccr = ccr < 4 ? 4 : ccr;
+        return {base_addr, static_cast<uint16_t>(ccr),
+                static_cast<uint8_t>(pclk_mhz + 1)};
+    }
+
+    uint32_t ccr = (pclk1_hz + 3 * bus_hz - 1) / (3 * bus_hz);
+    ccr = ccr < 1 ? 1 : ccr;
+    return {base_addr, static_cast<uint16_t>(I2C_CCR_FS | ccr),
+            static_cast<uint8_t>(pclk_mhz * 300U / 1000U + 1)};
+}
+
+static_assert(i2c_timing(nullptr, 50000000, 100000).ccr == 250 &&
+              i2c_timing(nullptr, 50000000, 100000).trise == 51);
+static_assert(i2c_timing(nullptr, 50000000, 400000).ccr == (I2C_CCR_FS | 42));
+
+/**
+ * @class HwI2c
+ * @brief I2C master on an F4 I2C peripheral, polled or interrupt-driven
+ * @details Polled by default. After enable_irq() the event and error
+ * interrupts step each transfer through START, address, data and STOP,
+ * and the caller blocks on a semaphore (and yields under FreeRTOS). Reads
+ * follow the RM0383 1-, 2- and N-byte ACK/STOP sequences.
+ */
 class HwI2c : public I2c
 {
 
@@ -33,7 +73,8 @@ public:
     bool init();
 
     /*
-    This function are polling based I2C read and write functions
+    This function are polling based I2C read and write functions, or
+    interrupt driven after enable_irq()
     Because of F4 design, it's not modern so we have to do START, ADDR, DATA, STOP manually
     */
 
@@ -67,10 +108,60 @@ public:
     */
     bool write(const uint8_t* data, size_t len, uint8_t dev_addr) override;
 
+    /**
+    * @brief Reset the peripheral through SWRST and re-apply its timing
+    * @note The pins are owned by the BSP, so this cannot clock SCL manually;
+    *       it clears a stuck BUSY/ARLO state inside the peripheral.
+    */
+    bool bus_clear() override;
+
+    /**
+    * @brief Switch transfers to event/error-interrupt mode
+    * @details The BSP must call ev_irq_handler() and er_irq_handler() from
+    *          the matching I2Cx_EV_IRQHandler and I2Cx_ER_IRQHandler.
+    * @param ev_irq The event interrupt, e.g. I2C1_EV_IRQn
+    * @param er_irq The error interrupt, e.g. I2C1_ER_IRQn
+    */
+    bool enable_irq(IRQn_Type ev_irq, IRQn_Type er_irq);
+
+    /**
+    * @brief Step the active transfer on SB, ADDR, TXE, RXNE or BTF
+    */
+    void ev_irq_handler();
+
+    /**
+    * @brief End the active transfer on a bus error, lost arbitration,
+    *        NACK or overrun
+    */
+    void er_irq_handler();
+
 private:
+    bool wait_bus_idle();
+    bool transfer_irq(uint8_t dev_addr, const uint8_t* reg,
+                      const uint8_t* tx, size_t tx_len, uint8_t* rx,
+                      size_t rx_len);
+    void on_addr();
+    void on_tx(uint32_t sr1);
+    void on_rx(uint32_t sr1);
+    void finish(bool ok);
+
     I2C_TypeDef* _base_addr;
     uint16_t _ccr;
     uint8_t _trise;
+
+    // Interrupt-mode transfer state
+    bool _use_irq;
+    Rtos::BinarySemaphore _done;
+    volatile bool _job_ok;
+    uint8_t _job_addr;
+    bool _job_reading;  ///< Address phase and data are in the read direction
+    bool _job_has_reg;  ///< A register address goes out before the data
+    uint8_t _job_reg;
+    const uint8_t* _job_tx;
+    size_t _job_tx_len;
+    uint8_t* _job_rx;
+    size_t _job_rx_len;
+    size_t _job_index;  ///< Bytes moved in the current direction
 };
 }  // namespace Stmf4
 }  // namespace MM
\ No newline at end of file
@@ -1,21 +1,25 @@
 #include "st_pwm.h"
 #include <cstdint>
+#include <iterator>
 #include "reg_helpers.h"
+#include "st_clock.h"
+#include "st_pwm_timing.h"
 
 namespace MM
 {
 namespace Stmf4
 {
 // Constants values for PWM calculations and register bit widths
-static constexpr uint32_t kPclkFreq = 16000000;  // 16 MHz timer clock
 static constexpr uint8_t kTimCcmrxOcxmBitWidth = 3;
 static constexpr uint8_t kTimCr1CmsBitWidth = 2;
 static constexpr uint8_t kTimCr1DirBitWidth = 1;
-static constexpr uint8_t kArrVal =
-    99;  // counts 0..99 => 100 ticks per PWM period
-static constexpr uint32_t kMaxFreqEdgeAligned = kPclkFreq / (kArrVal + 1);
-static constexpr uint32_t kMaxFreqCenterAligned =
-    kPclkFreq / (2 * (kArrVal + 1));
+// PERCENT mode: 100 CCR steps per period, ARR = 99 edge-aligned and
+// ARR = 100 center-aligned (see pwm_full_scale())
+static constexpr uint32_t kPercentFullScale = 100;
+
+// Channels of one timer share PSC and ARR, so the duty full scale is kept
+// per timer and every HwPwm on that timer points at the same slot
+static uint32_t timer_full_scale[8];
 
 // Helper functions to check timer type for channel validity and mode rules
 static inline bool is_timer_1_to_5(TIM_TypeDef* t)
@@ -27,12 +31,28 @@ static inline bool is_timer_9_to_11(TIM_TypeDef* t)
     return (t == TIM9 || t == TIM10 || t == TIM11);
 }
 
+static uint32_t* full_scale_slot(const TIM_TypeDef* t)
+{
+    const TIM_TypeDef* const timers[] = {TIM1, TIM2, TIM3,  TIM4,
+                                         TIM5, TIM9, TIM10, TIM11};
+    for (size_t i = 0; i < std::size(timers); i++)
+    {
+        if (timers[i] == t)
+        {
+            return &timer_full_scale[i];
+        }
+    }
+    return nullptr;
+}
+
 HwPwm::HwPwm(const StPwmParams& params)
     : base_addr{params.base_addr},
       channel{params.channel},
       settings{params.settings},
-      current_frequency{kPclkFreq},
-      current_duty_cycle{0}
+      current_frequency{0},
+      current_duty_cycle{0},
+      full_scale{nullptr},
+      ccr{nullptr}
 {
 }
 
@@ -89,7 +109,7 @@ bool HwPwm::init()
                    static_cast<uint32_t>(settings.output_mode),
                    TIM_CCMR1_OC1M_Pos, kTimCcmrxOcxmBitWidth);
             base_addr->CCMR1 |= TIM_CCMR1_OC1PE;
-            base_addr->CCR1 = 0;
+            ccr = &base_addr->CCR1;
             base_addr->CCER |= TIM_CCER_CC1E;
             break;
         case PwmChannel::CH2:
@@ -98,7 +118,7 @@ bool HwPwm::init()
                    static_cast<uint32_t>(settings.output_mode),
                    TIM_CCMR1_OC2M_Pos, kTimCcmrxOcxmBitWidth);
             base_addr->CCMR1 |= TIM_CCMR1_OC2PE;
-            base_addr->CCR2 = 0;
+            ccr = &base_addr->CCR2;
             base_addr->CCER |= TIM_CCER_CC2E;
             break;
         case PwmChannel::CH3:
@@ -107,7 +127,7 @@ bool HwPwm::init()
                    static_cast<uint32_t>(settings.output_mode),
                    TIM_CCMR2_OC3M_Pos, kTimCcmrxOcxmBitWidth);
             base_addr->CCMR2 |= TIM_CCMR2_OC3PE;
-            base_addr->CCR3 = 0;
+            ccr = &base_addr->CCR3;
             base_addr->CCER |= TIM_CCER_CC3E;
             break;
         case PwmChannel::CH4:
@@ -116,7 +136,7 @@ bool HwPwm::init()
                    static_cast<uint32_t>(settings.output_mode),
                    TIM_CCMR2_OC4M_Pos, kTimCcmrxOcxmBitWidth);
             base_addr->CCMR2 |= TIM_CCMR2_OC4PE;
-            base_addr->CCR4 = 0;
+            ccr = &base_addr->CCR4;
             base_addr->CCER |= TIM_CCER_CC4E;
             break;
         default:
@@ -137,18 +157,32 @@ bool HwPwm::init()
     SetReg(&base_addr->CR1, static_cast<uint32_t>(settings.dir),
            TIM_CR1_DIR_Pos, kTimCr1DirBitWidth);
 
-    // Fixed ARR
-    base_addr->ARR = kArrVal;
+    *ccr = 0;
+    full_scale = full_scale_slot(base_addr);
+    const bool center = settings.mode != PwmMode::EDGE_ALIGNED;
+
+    // The first channel on a timer sets up its period. Later ones join
+    // the running timer and keep its PSC/ARR, which the other channels'
+    // CCRs were computed against.
+    if (!(base_addr->CR1 & TIM_CR1_CEN_Msk))
+    {
+        // PERCENT scale until a MAX-resolution set_frequency() widens it
+        *full_scale = kPercentFullScale;
+        base_addr->ARR = center ? kPercentFullScale : kPercentFullScale - 1u;
+
+        // Buffer ARR updates
+        base_addr->CR1 |= TIM_CR1_ARPE;
 
-    // Buffer ARR updates
-    base_addr->CR1 |= TIM_CR1_ARPE;
+        // Reset counter + force update to latch preloads
+        base_addr->CNT = 0;
+        base_addr->EGR |= TIM_EGR_UG;
 
-    // Reset counter + force update to latch preloads
-    base_addr->CNT = 0;
-    base_addr->EGR |= TIM_EGR_UG;
+        // Enable counter
+        base_addr->CR1 |= TIM_CR1_CEN;
+    }
 
-    // Enable counter
-    base_addr->CR1 |= TIM_CR1_CEN;
+    current_frequency = timer_clock_hz(base_addr) /
+                        ((base_addr->PSC + 1) * *full_scale * (center ? 2 : 1));
 
     return true;
 }
@@ -165,28 +199,68 @@ bool HwPwm::set_frequency(uint32_t frequency)
         return false;
     }
 
+    // Timer kernel clock as published by clock_init()
+    const uint32_t tim_clk = timer_clock_hz(base_addr);
+
+    if (settings.resolution == PwmResolution::MAX)
+    {
+        const bool wide = base_addr == TIM2 || base_addr == TIM5;
+        const bool center = settings.mode != PwmMode::EDGE_ALIGNED;
+        const PwmTiming timing = pwm_timing(tim_clk, frequency, center,
+                                            wide ? 0xFFFFFFFFu : 0xFFFFu);
+        if (!timing.valid)
+        {
+            return false;
+        }
+
+        // Keep every channel's duty fraction, not just this one's: PSC,
+        // ARR and the CCRs are preloaded, and with UDIS set they all move
+        // to the active registers on the same update event
+        base_addr->CR1 |= TIM_CR1_UDIS;
+        volatile uint32_t* const ccrs[] = {&base_addr->CCR1, &base_addr->CCR2,
+                                           &base_addr->CCR3, &base_addr->CCR4};
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            if (base_addr->CCER & (TIM_CCER_CC1E << (i * 4u)))
+            {
+                *ccrs[i] =
+                    rescale_ccr(*ccrs[i], *full_scale, timing.full_scale);
+            }
+        }
+        base_addr->PSC = timing.psc;
+        base_addr->ARR = timing.arr;
+        base_addr->CR1 &= ~TIM_CR1_UDIS;
+
+        *full_scale = timing.full_scale;
+        current_frequency = timing.frequency_hz;
+        return true;
+    }
+    const uint32_t max_freq_edge_aligned = tim_clk / kPercentFullScale;
+    const uint32_t max_freq_center_aligned = tim_clk / (2 * kPercentFullScale);
+
     if ((settings.mode == PwmMode::EDGE_ALIGNED) &&
-        (frequency > kMaxFreqEdgeAligned))
+        (frequency > max_freq_edge_aligned))
     {
         return false;
     }
 
     if ((settings.mode != PwmMode::EDGE_ALIGNED) &&
-        (frequency > kMaxFreqCenterAligned))
+        (frequency > max_freq_center_aligned))
     {
         return false;
     }
 
     // denom can exceed 2^32 when frequency is large
-    // PSC+1 = round(pclk / (frequency * (ARR+1))) for edge-aligned
-    const uint64_t arrp1 = static_cast<uint64_t>(kArrVal) + 1ULL;
-    const uint64_t denom = static_cast<uint64_t>(frequency) * arrp1;
+    // PSC+1 = round(pclk / (frequency * full scale)) for edge-aligned
+    const uint64_t denom =
+        static_cast<uint64_t>(frequency) * kPercentFullScale;
 
     // Rounded division: psc_val = round(pclk / denom)
     uint64_t psc_val =
-        (static_cast<uint64_t>(kPclkFreq) + (denom / 2ULL)) / denom;
+        (static_cast<uint64_t>(tim_clk) + (denom / 2ULL)) / denom;
 
-    // Center-aligned: same PSC/ARR → need half PSC+1
+    // Center-aligned: the period is 2 x ARR = 2 x full scale, so PSC+1 is
+    // halved
     if (settings.mode != PwmMode::EDGE_ALIGNED)
     {
         // rounded divide-by-2
@@ -202,8 +276,9 @@ bool HwPwm::set_frequency(uint32_t frequency)
     base_addr->PSC = static_cast<uint32_t>(psc_val - 1ULL);
     current_frequency = frequency;
 
-    // force update so PSC takes effect immediately (safe/typical)
-    base_addr->EGR |= TIM_EGR_UG;
+    // PSC is preloaded and takes effect at the next update event. Forcing
+    // one with EGR.UG would restart the period of every channel on this
+    // timer, so it is not done here.
 
     return true;
 }
@@ -221,31 +296,24 @@ bool HwPwm::set_duty_cycle(uint8_t duty_cycle)
     }
 
     // CCR (Capture/Compare Register value) = round(duty% * (ARR+1) / 100)
-    const uint32_t arrp1 = static_cast<uint32_t>(kArrVal) + 1U;
-    uint32_t ccr_val = (static_cast<uint32_t>(duty_cycle) * arrp1 + 50U) / 100U;
-
-    switch (channel)
-    {
-        case PwmChannel::CH1:
-            base_addr->CCR1 = ccr_val;
-            break;
-        case PwmChannel::CH2:
-            base_addr->CCR2 = ccr_val;
-            break;
-        case PwmChannel::CH3:
-            base_addr->CCR3 = ccr_val;
-            break;
-        case PwmChannel::CH4:
-            base_addr->CCR4 = ccr_val;
-            break;
-        default:
-            return false;
-    }
+    *ccr = duty_ccr_permille(*full_scale,
+                             static_cast<uint32_t>(duty_cycle) * 10u);
 
     current_duty_cycle = duty_cycle;
 
     return true;
 }
 
+void HwPwm::set_duty(Q16_16 duty)
+{
+    const int32_t raw = duty.raw();
+    *ccr = duty_ccr_q16(*full_scale, raw < 0 ? 0u : static_cast<uint32_t>(raw));
+}
+
+void HwPwm::set_duty_permille(uint16_t duty_permille)
+{
+    *ccr = duty_ccr_permille(*full_scale, duty_permille);
+}
+
 }  // namespace Stmf4
 }  // namespace MM
@@ -6,6 +6,7 @@
 */
 
 #pragma once
+#include "fixed_point.h"
 #include "pwm.h"
 #include "stm32f411xe.h"
 
@@ -65,6 +66,18 @@ enum class PwmChannel : uint8_t
     CH4 = 4
 };
 
+/**
+* @brief Duty resolution policy
+* @note PERCENT: fixed 100-step full scale (ARR = 99, or 100 when
+        center-aligned), frequency set through PSC only (101 levels)
+        MAX: set_frequency() picks the largest ARR the frequency allows
+*/
+enum class PwmResolution : uint8_t
+{
+    PERCENT = 0,
+    MAX
+};
+
 /**
 * @brief Configuration structure for STM32F4 PWM settings
 */
@@ -73,6 +86,7 @@ struct StPwmSettings
     PwmMode mode;
     PwmOutputMode output_mode;
     PwmDir dir;
+    PwmResolution resolution;
 };
 
 struct StPwmParams
@@ -100,6 +114,9 @@ public:
     * @brief Sets the frequency of the PWM timer
     * @param frequency Desired frequency in Hz
     * @return true if the frequency was set successfully, false otherwise
+    * @note PSC and ARR belong to the timer, so this changes the frequency
+            of every channel on it. In MAX resolution the CCR of each
+            enabled channel is rescaled so all duty fractions are kept.
     */
     bool set_frequency(uint32_t frequency) override;
 
@@ -107,17 +124,40 @@ public:
     * @brief Sets the duty cycle of the PWM signal
     * @param duty_cycle Desired duty cycle as a percentage (0-100)
     * @return true if the duty cycle was set successfully, false otherwise
-    * @note     Edge-aligned: 42 MHz  / (PSC + 1)
-                Center-aligned: 21 MHz  / (PSC + 1)
+    * @note     Edge-aligned: timer clock / (PSC + 1)
+                Center-aligned: timer clock / 2 / (PSC + 1)
     */
     bool set_duty_cycle(uint8_t duty_cycle) override;
 
+    /**
+    * @brief Sets the duty cycle as a fraction of the period
+    * @param duty 0.0 .. 1.0; values outside are clamped
+    * @note A single CCR store: the CCR scale was fixed by set_frequency()
+    */
+    void set_duty(Q16_16 duty);
+
+    /**
+    * @brief Sets the duty cycle in 1/1000 (clamped to 1000)
+    */
+    void set_duty_permille(uint16_t duty_permille);
+
+    /**
+    * @brief Number of duty steps: ARR + 1 edge-aligned, ARR center-aligned
+    * @note Shared with every other HwPwm on the same timer
+    */
+    uint32_t resolution() const
+    {
+        return full_scale != nullptr ? *full_scale : 0u;
+    }
+
 private:
     TIM_TypeDef* base_addr;
     PwmChannel channel;
     StPwmSettings settings;
     uint32_t current_frequency;
     uint8_t current_duty_cycle;
+    uint32_t* full_scale;  ///< CCR for 100 % duty, one slot per timer
+    volatile uint32_t* ccr;
 };
 }  // namespace Stmf4
 }  // namespace MM
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "st_pwm_dma.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+// Bit offset of streams 0..3 (and 4..7) within LISR/HISR
+static constexpr uint8_t kFlagShift[4] = {0, 6, 16, 22};
+static constexpr uint32_t kAllFlags = 0x3Du;  // FEIF, DMEIF, TEIF, HTIF, TCIF
+static constexpr uint32_t kTcif = 1u << 5;
+static constexpr uint32_t kTeif = 1u << 3;
+static constexpr uint32_t kStreamStride = 0x18u;
+static constexpr uint32_t kStreamOffset = 0x10u;
+static constexpr uint32_t kMaxWords = 0xFFFFu;
+
+static inline uint32_t bus_address(const volatile void* p)
+{
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(p));
+}
+
+PwmDma::PwmDma(const StPwmDmaParams& params)
+    : base_addr{params.base_addr},
+      first_channel{params.first_channel},
+      num_channels{params.num_channels},
+      stream_regs{params.stream},
+      dma_channel{params.dma_channel},
+      irq{params.irq},
+      dma{nullptr},
+      flag_shift{0},
+      flag_clear{nullptr},
+      flag_status{nullptr},
+      handler{nullptr},
+      ctx{nullptr},
+      buffers{nullptr, nullptr},
+      active{false},
+      double_buffer{false}
+{
+}
+
+bool PwmDma::init()
+{
+    const auto first = static_cast<uint8_t>(first_channel);
+    if (base_addr == nullptr || stream_regs == nullptr || dma_channel > 7)
+    {
+        return false;
+    }
+    if (first < 1 || num_channels < 1 || first + num_channels - 1 > 4)
+    {
+        return false;
+    }
+
+    // Locate the stream's controller and its slot in the flag registers
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(stream_regs);
+    dma = addr >= DMA2_BASE ? DMA2 : DMA1;
+    const uintptr_t dma_base = reinterpret_cast<uintptr_t>(dma);
+    const uint32_t index = (addr - dma_base - kStreamOffset) / kStreamStride;
+    if (index > 7)
+    {
+        return false;
+    }
+    flag_shift = kFlagShift[index % 4];
+    flag_clear = index < 4 ? &dma->LIFCR : &dma->HIFCR;
+    flag_status = index < 4 ? &dma->LISR : &dma->HISR;
+
+    // DMAR bursts num_channels words starting at CCRx (DBA in words from CR1)
+    const uint32_t ccr_offset =
+        (reinterpret_cast<uintptr_t>(&base_addr->CCR1) -
+         reinterpret_cast<uintptr_t>(base_addr)) /
+            4u +
+        (first - 1u);
+    base_addr->DCR = ((num_channels - 1u) << TIM_DCR_DBL_Pos) |
+                     (ccr_offset << TIM_DCR_DBA_Pos);
+    base_addr->DIER &= ~TIM_DIER_UDE;
+
+    disable_stream();
+    clear_flags();
+    NVIC_ClearPendingIRQ(irq);
+    NVIC_EnableIRQ(irq);
+    return true;
+}
+
+void PwmDma::disable_stream()
+{
+    stream_regs->CR &= ~DMA_SxCR_EN;
+    while (stream_regs->CR & DMA_SxCR_EN)
+    {
+    }
+}
+
+void PwmDma::clear_flags()
+{
+    *flag_clear = kAllFlags << flag_shift;
+}
+
+bool PwmDma::start(const uint32_t* m0, const uint32_t* m1, size_t words,
+                   Handler handler_, void* ctx_)
+{
+    if (active || dma == nullptr || words == 0 || words > kMaxWords ||
+        words % num_channels != 0)
+    {
+        return false;
+    }
+
+    handler = handler_;
+    ctx = ctx_;
+    buffers[0] = const_cast<uint32_t*>(m0);
+    buffers[1] = const_cast<uint32_t*>(m1);
+    double_buffer = m1 != nullptr;
+
+    disable_stream();
+    clear_flags();
+
+    stream_regs->PAR = bus_address(&base_addr->DMAR);
+    stream_regs->M0AR = bus_address(m0);
+    if (double_buffer)
+    {
+        // Only used, and only meant to be written, with DBM set
+        stream_regs->M1AR = bus_address(m1);
+    }
+    stream_regs->NDTR = static_cast<uint32_t>(words);
+    stream_regs->FCR = 0;  // Direct mode, word to word
+
+    uint32_t cr = (static_cast<uint32_t>(dma_channel) << DMA_SxCR_CHSEL_Pos) |
+                  DMA_SxCR_PL_1 |     // High priority
+                  DMA_SxCR_MSIZE_1 |  // 32-bit memory
+                  DMA_SxCR_PSIZE_1 |  // 32-bit peripheral
+                  DMA_SxCR_MINC | DMA_SxCR_DIR_0 |  // Memory to peripheral
+                  DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+    if (double_buffer)
+    {
+        cr |= DMA_SxCR_DBM | DMA_SxCR_CIRC;
+    }
+    stream_regs->CR = cr;
+
+    active = true;
+    stream_regs->CR |= DMA_SxCR_EN;
+    base_addr->DIER |= TIM_DIER_UDE;
+    return true;
+}
+
+bool PwmDma::play(std::span<const uint32_t> table, Handler done, void* ctx_)
+{
+    return start(table.data(), nullptr, table.size(), done, ctx_);
+}
+
+bool PwmDma::stream(std::span<uint32_t> buffer0, std::span<uint32_t> buffer1,
+                    Handler refill, void* ctx_)
+{
+    if (buffer0.size() != buffer1.size() || refill == nullptr)
+    {
+        return false;
+    }
+    return start(buffer0.data(), buffer1.data(), buffer0.size(), refill,
+                 ctx_);
+}
+
+void PwmDma::stop()
+{
+    base_addr->DIER &= ~TIM_DIER_UDE;
+    disable_stream();
+    clear_flags();
+    active = false;
+}
+
+void PwmDma::irq_handler()
+{
+    const uint32_t status = *flag_status >> flag_shift;
+    clear_flags();
+
+    if (status & kTeif)
+    {
+        stop();
+        return;
+    }
+    if ((status & kTcif) == 0)
+    {
+        return;
+    }
+
+    if (double_buffer)
+    {
+        // CT names the buffer now being played; the other one is free
+        const bool playing_m1 = (stream_regs->CR & DMA_SxCR_CT) != 0;
+        handler(buffers[playing_m1 ? 0 : 1], ctx);
+        return;
+    }
+
+    base_addr->DIER &= ~TIM_DIER_UDE;
+    active = false;
+    if (handler != nullptr)
+    {
+        handler(nullptr, ctx);
+    }
+}
+
+}  // namespace Stmf4
+}  // namespace MM
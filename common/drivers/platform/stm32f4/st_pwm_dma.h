@@ -0,0 +1,127 @@
+/**
+ * @file st_pwm_dma.h
+ * @brief Stream duty tables into a timer's CCRs on every update event
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details The timer's update DMA request triggers a DMAR burst (TIMx_DCR)
+ * that copies one frame - one word per channel - into consecutive CCR
+ * registers. Ramps and LED/buzzer patterns then run with no CPU work per
+ * PWM period. Tables come from duty_ramp.h.
+ *
+ * Two modes:
+ * - play(): one pass over a table, then the last frame stays in effect
+ * - stream(): DMA double-buffer mode; the handler refills whichever
+ *   buffer the DMA just finished while it plays the other
+ *
+ * F411 update-event requests (RM0383 table 27/28): TIM1_UP DMA2 S5 ch6,
+ * TIM2_UP DMA1 S1/S7 ch3, TIM3_UP DMA1 S2 ch5, TIM4_UP DMA1 S6 ch2,
+ * TIM5_UP DMA1 S0/S6 ch6.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "duty_ramp.h"
+#include "st_pwm.h"
+#include "stm32f411xe.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+
+struct StPwmDmaParams
+{
+    TIM_TypeDef* base_addr;
+    PwmChannel first_channel;  ///< Burst starts at this CCR
+    uint8_t num_channels;      ///< Consecutive CCRs written per frame
+    DMA_Stream_TypeDef* stream;
+    uint8_t dma_channel;  ///< CHSEL of the timer's UP request
+    IRQn_Type irq;        ///< The stream's interrupt
+};
+
+/**
+ * @class PwmDma
+ * @note The timer and its channels are set up by HwPwm or PwmGroup first.
+ *       The BSP enables the DMA clock and calls irq_handler() from the
+ *       stream's IRQ handler.
+ */
+class PwmDma
+{
+public:
+    /// Called from the DMA interrupt with the buffer that is free to fill
+    /// (stream), or nullptr when a play() pass has finished
+    using Handler = void (*)(uint32_t* buffer, void* ctx);
+
+    explicit PwmDma(const StPwmDmaParams& params_);
+
+    /**
+     * @brief Set up the timer burst registers and enable the stream IRQ
+     * @return true if successful, false otherwise
+     */
+    bool init();
+
+    /**
+     * @brief Play @p table once (frames x num_channels words)
+     * @return false if busy or the size is not whole frames
+     */
+    bool play(std::span<const uint32_t> table, Handler done = nullptr,
+              void* ctx = nullptr);
+
+    template <size_t Frames, size_t Channels>
+    bool play(const DutyTable<Frames, Channels>& table,
+              Handler done = nullptr, void* ctx = nullptr)
+    {
+        if (Channels != num_channels)
+            return false;
+        return play(std::span<const uint32_t>(table.data), done, ctx);
+    }
+
+    /**
+     * @brief Loop over two equally sized buffers until stop()
+     * @param refill Called each time one buffer has been fully played
+     * @return false if busy or the sizes are invalid
+     */
+    bool stream(std::span<uint32_t> buffer0, std::span<uint32_t> buffer1,
+                Handler refill, void* ctx);
+
+    /**
+     * @brief Stop after the current frame; CCRs keep their last value
+     */
+    void stop();
+
+    bool busy() const
+    {
+        return active;
+    }
+
+    void irq_handler();
+
+private:
+    bool start(const uint32_t* m0, const uint32_t* m1, size_t words,
+               Handler handler_, void* ctx_);
+    void disable_stream();
+    void clear_flags();
+
+    TIM_TypeDef* base_addr;
+    PwmChannel first_channel;
+    uint8_t num_channels;
+    DMA_Stream_TypeDef* stream_regs;
+    uint8_t dma_channel;
+    IRQn_Type irq;
+
+    DMA_TypeDef* dma;
+    uint8_t flag_shift;             ///< Position of the stream in xISR/xIFCR
+    volatile uint32_t* flag_clear;  ///< LIFCR or HIFCR
+    const volatile uint32_t* flag_status;
+
+    Handler handler;
+    void* ctx;
+    uint32_t* buffers[2];
+    volatile bool active;
+    bool double_buffer;
+};
+
+}  // namespace Stmf4
+}  // namespace MM
@@ -0,0 +1,211 @@
+#include "st_pwm_group.h"
+#include "reg_helpers.h"
+#include "st_clock.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+static constexpr uint8_t kTimCcmrxOcxmBitWidth = 3;
+static constexpr uint8_t kTimCr1CmsBitWidth = 2;
+static constexpr uint8_t kTimCr1DirBitWidth = 1;
+
+static inline bool is_timer_1_to_5(const TIM_TypeDef* t)
+{
+    return (t == TIM1 || t == TIM2 || t == TIM3 || t == TIM4 || t == TIM5);
+}
+
+static PwmTiming group_timing(const TIM_TypeDef* t, PwmMode mode,
+                              uint32_t frequency)
+{
+    const bool wide = t == TIM2 || t == TIM5;
+    return pwm_timing(timer_clock_hz(t), frequency,
+                      mode != PwmMode::EDGE_ALIGNED,
+                      wide ? 0xFFFFFFFFu : 0xFFFFu);
+}
+
+PwmGroup::PwmGroup(const StPwmGroupParams& params)
+    : base_addr{params.base_addr},
+      channels{params.channels[0], params.channels[1], params.channels[2],
+               params.channels[3]},
+      num_channels{params.num_channels},
+      settings{params.settings},
+      initial_frequency{params.frequency},
+      complementary{params.complementary},
+      dead_time_ns{params.dead_time_ns},
+      current_frequency{0},
+      full_scale{0}
+{
+}
+
+volatile uint32_t* PwmGroup::ccr(PwmChannel channel) const
+{
+    // CCR1..CCR4 are consecutive registers
+    return &base_addr->CCR1 + (static_cast<uint8_t>(channel) - 1u);
+}
+
+bool PwmGroup::init()
+{
+    // TIM9..TIM11 have at most two channels and no group use
+    if (base_addr == nullptr || !is_timer_1_to_5(base_addr))
+    {
+        return false;
+    }
+    if (num_channels < 1 || num_channels > 4)
+    {
+        return false;
+    }
+    if (complementary && base_addr != TIM1)
+    {
+        return false;
+    }
+
+    uint32_t used = 0;
+    for (uint8_t i = 0; i < num_channels; i++)
+    {
+        const auto ch = static_cast<uint8_t>(channels[i]);
+        if (ch < 1 || ch > 4 || (used & (1u << ch)) != 0)
+        {
+            return false;
+        }
+        // TIM1 CH4 has no complementary output
+        if (complementary && ch == 4)
+        {
+            return false;
+        }
+        used |= 1u << ch;
+    }
+
+    const PwmTiming timing =
+        group_timing(base_addr, settings.mode, initial_frequency);
+    if (!timing.valid)
+    {
+        return false;
+    }
+
+    base_addr->CR1 = 0;
+    base_addr->CCER = 0;
+
+    for (uint8_t i = 0; i < num_channels; i++)
+    {
+        const uint8_t index = static_cast<uint8_t>(channels[i]) - 1u;
+        volatile uint32_t* ccmr =
+            index < 2 ? &base_addr->CCMR1 : &base_addr->CCMR2;
+        const uint32_t shift = (index % 2u) * 8u;
+
+        // Output, PWM mode, CCR preload
+        *ccmr &= ~(TIM_CCMR1_CC1S_Msk << shift);
+        SetReg(ccmr, static_cast<uint32_t>(settings.output_mode),
+               TIM_CCMR1_OC1M_Pos + shift, kTimCcmrxOcxmBitWidth);
+        *ccmr |= TIM_CCMR1_OC1PE << shift;
+        *ccr(channels[i]) = 0;
+
+        uint32_t ccer = TIM_CCER_CC1E << (index * 4u);
+        if (complementary)
+        {
+            ccer |= TIM_CCER_CC1NE << (index * 4u);
+        }
+        base_addr->CCER |= ccer;
+    }
+
+    SetReg(&base_addr->CR1, static_cast<uint32_t>(settings.mode),
+           TIM_CR1_CMS_Pos, kTimCr1CmsBitWidth);
+    SetReg(&base_addr->CR1, static_cast<uint32_t>(settings.dir),
+           TIM_CR1_DIR_Pos, kTimCr1DirBitWidth);
+    full_scale = timing.full_scale;
+    base_addr->PSC = timing.psc;
+    base_addr->ARR = timing.arr;
+    base_addr->CR1 |= TIM_CR1_ARPE;
+
+    if (base_addr == TIM1)
+    {
+        // Dead time counts kernel clock periods (CKD = 0)
+        const uint64_t ticks =
+            (static_cast<uint64_t>(dead_time_ns) * timer_clock_hz(TIM1) +
+             999'999'999ull) /
+            1'000'000'000ull;
+        const uint32_t dtg = complementary
+                                 ? dead_time_dtg(static_cast<uint32_t>(ticks))
+                                 : 0u;
+        base_addr->RCR = 0;
+        base_addr->BDTR = dtg | TIM_BDTR_MOE;
+    }
+
+    current_frequency = timing.frequency_hz;
+
+    // Timer is stopped, so latching the preloads here cannot glitch
+    base_addr->CNT = 0;
+    base_addr->EGR = TIM_EGR_UG;
+    base_addr->SR = 0;
+
+    base_addr->CR1 |= TIM_CR1_CEN;
+    return true;
+}
+
+bool PwmGroup::set_frequency(uint32_t frequency)
+{
+    if (!(base_addr->CR1 & TIM_CR1_CEN_Msk))
+    {
+        return false;
+    }
+
+    const PwmTiming timing = group_timing(base_addr, settings.mode, frequency);
+    if (!timing.valid)
+    {
+        return false;
+    }
+
+    // Everything below is preloaded; with UDIS set the next update moves
+    // PSC, ARR and all rescaled CCRs together, and no EGR.UG is needed
+    base_addr->CR1 |= TIM_CR1_UDIS;
+    for (uint8_t i = 0; i < num_channels; i++)
+    {
+        volatile uint32_t* reg = ccr(channels[i]);
+        *reg = rescale_ccr(*reg, full_scale, timing.full_scale);
+    }
+    base_addr->PSC = timing.psc;
+    base_addr->ARR = timing.arr;
+    base_addr->CR1 &= ~TIM_CR1_UDIS;
+
+    full_scale = timing.full_scale;
+    current_frequency = timing.frequency_hz;
+    return true;
+}
+
+bool PwmGroup::set_duty(uint8_t index, uint16_t duty_permille)
+{
+    if (index >= num_channels || duty_permille > kDutyMax)
+    {
+        return false;
+    }
+    *ccr(channels[index]) = duty_ccr_permille(full_scale, duty_permille);
+    return true;
+}
+
+bool PwmGroup::set_duties(std::span<const uint16_t> duty_permille)
+{
+    if (duty_permille.size() != num_channels)
+    {
+        return false;
+    }
+    for (uint16_t duty : duty_permille)
+    {
+        if (duty > kDutyMax)
+        {
+            return false;
+        }
+    }
+
+    // With UDIS set no update event can transfer a half-written set of
+    // preloads; the next one after clearing it moves them all at once
+    base_addr->CR1 |= TIM_CR1_UDIS;
+    for (uint8_t i = 0; i < num_channels; i++)
+    {
+        *ccr(channels[i]) = duty_ccr_permille(full_scale, duty_permille[i]);
+    }
+    base_addr->CR1 &= ~TIM_CR1_UDIS;
+    return true;
+}
+
+}  // namespace Stmf4
+}  // namespace MM
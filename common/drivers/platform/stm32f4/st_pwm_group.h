@@ -0,0 +1,109 @@
+/**
+ * @file st_pwm_group.h
+ * @brief Several PWM channels of one timer with a shared period
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Where HwPwm owns a single channel, PwmGroup configures the timer
+ * once and drives 1-4 of its channels together. CCRx and ARR are preloaded
+ * and duty changes are made with the update event disabled (CR1.UDIS), so
+ * every channel switches to its new duty on the same PWM period boundary,
+ * e.g. both wheels of a differential drive. Nothing after init() writes
+ * EGR.UG, which would restart the period and glitch all outputs.
+ *
+ * On TIM1, CH1-CH3 can also drive their complementary CHxN pins with a
+ * hardware dead time for H-bridge half-bridges.
+ */
+
+#pragma once
+#include <cstdint>
+#include <span>
+#include "st_pwm.h"
+#include "st_pwm_timing.h"
+#include "stm32f411xe.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+
+struct StPwmGroupParams
+{
+    TIM_TypeDef* base_addr;
+    PwmChannel channels[4];
+    uint8_t num_channels;
+    StPwmSettings settings;
+    uint32_t frequency;     ///< Initial PWM frequency in Hz
+    bool complementary;     ///< TIM1 CH1-3 only: also drive CHxN
+    uint32_t dead_time_ns;  ///< Inserted on each CHx/CHxN transition
+};
+
+class PwmGroup
+{
+public:
+    /// Full scale of the duty arguments (permille)
+    static constexpr uint16_t kDutyMax = 1000;
+
+    explicit PwmGroup(const StPwmGroupParams& params_);
+
+    /**
+     * @brief Configure the timer and every channel, outputs at 0 % duty
+     * @details PSC and ARR come from pwm_timing(), so the period gets the
+     * largest ARR the timer width allows at the requested frequency.
+     * @note The BSP enables the timer clock and the AF pins
+     * @return true if successful, false otherwise
+     */
+    bool init();
+
+    /**
+     * @brief Change the shared PWM frequency
+     * @details PSC, ARR and every CCR are preloaded and written with the
+     * update event disabled, so the new period starts at the next update
+     * with each channel's duty fraction kept.
+     * @return true if the frequency is reachable, false otherwise
+     */
+    bool set_frequency(uint32_t frequency);
+
+    /**
+     * @brief Set one channel's duty
+     * @param index Position of the channel in StPwmGroupParams::channels
+     * @param duty_permille Duty in 1/1000 (0..kDutyMax)
+     * @return true if successful, false otherwise
+     */
+    bool set_duty(uint8_t index, uint16_t duty_permille);
+
+    /**
+     * @brief Set every channel's duty, applied on the same update event
+     * @param duty_permille One value per channel, in channel order
+     * @return true if successful, false otherwise (nothing is changed)
+     */
+    bool set_duties(std::span<const uint16_t> duty_permille);
+
+    uint32_t frequency() const
+    {
+        return current_frequency;
+    }
+
+    /**
+     * @brief Number of duty steps: ARR + 1 edge-aligned, ARR center-aligned
+     */
+    uint32_t resolution() const
+    {
+        return full_scale;
+    }
+
+private:
+    volatile uint32_t* ccr(PwmChannel channel) const;
+
+    TIM_TypeDef* base_addr;
+    PwmChannel channels[4];
+    uint8_t num_channels;
+    StPwmSettings settings;
+    uint32_t initial_frequency;
+    bool complementary;
+    uint32_t dead_time_ns;
+    uint32_t current_frequency;
+    uint32_t full_scale;  ///< CCR for 100 % duty
+};
+
+}  // namespace Stmf4
+}  // namespace MM
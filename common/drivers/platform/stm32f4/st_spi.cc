@@ -1,4 +1,3 @@
-
 /**
  * @file st_spi.cc
  * @author Kent Hong
@@ -24,10 +23,40 @@ namespace Stmf4
  *
  */
 HwSpi::HwSpi(SPI_TypeDef* instance_, StSpiSettings& settings_)
-    : instance(instance_), settings(settings_)
+    : instance(instance_),
+      settings(settings_),
+      use_dma(false),
+      rx_dma{},
+      tx_dma{},
+      dma_channel(0),
+      dma_error(false),
+      dma_fill(0),
+      dma_sink(0)
 {
 }
 
+// Interrupt priority. In FreeRTOS builds it must stay numerically above
+// configMAX_SYSCALL_INTERRUPT_PRIORITY (5) so give_from_isr() is legal
+static constexpr uint32_t kIrqPriority = 6;
+
+// Per-transfer timeout: fixed overhead plus a slow-clock per-byte budget
+static constexpr uint32_t kDmaTimeoutBaseUs = 1000;
+static constexpr uint32_t kDmaTimeoutPerByteUs = 100;
+
+// Bit offset of streams 0..3 (and 4..7) within LISR/HISR
+static constexpr uint8_t kFlagShift[4] = {0, 6, 16, 22};
+static constexpr uint32_t kAllFlags = 0x3Du;  // FEIF, DMEIF, TEIF, HTIF, TCIF
+static constexpr uint32_t kTcif = 1u << 5;
+static constexpr uint32_t kTeif = 1u << 3;
+static constexpr uint32_t kStreamStride = 0x18u;
+static constexpr uint32_t kStreamOffset = 0x10u;
+static constexpr size_t kMaxDmaBytes = 0xFFFFu;  // NDTR is 16 bits
+
+static inline uint32_t bus_address(const volatile void* p)
+{
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(p));
+}
+
 /**
  * @brief Read data from a slave device.
  * 
@@ -38,42 +67,13 @@ HwSpi::HwSpi(SPI_TypeDef* instance_, StSpiSettings& settings_)
  */
 bool HwSpi::read(std::span<uint8_t> rx_data)
 {
-
     // Check if SPI is already in communication
     if (instance->SR & SPI_SR_BSY)
     {
         return false;
     }
 
-    for (size_t i = 0; i < rx_data.size(); i++)
-    {
-        int timeout = 1000;
-        while (!(instance->SR & SPI_SR_TXE) && --timeout > 0)
-        {
-            MM::Utils::DelayUs(1);
-        }
-        if (timeout == 0)
-            return false;
-
-        *(volatile uint8_t*)&instance->DR = 0x00;
-
-        timeout = 1000;
-        while (!(instance->SR & SPI_SR_RXNE) && --timeout > 0)
-        {
-            MM::Utils::DelayUs(1);
-        }
-        if (timeout == 0)
-            return false;
-
-        rx_data[i] = *(volatile uint8_t*)&instance->DR;
-    }
-
-    // Wait until transmission is complete
-    while (instance->SR & SPI_SR_BSY)
-    {
-    }
-
-    return true;
+    return transfer(nullptr, rx_data.data(), rx_data.size());
 }
 
 /**
@@ -86,42 +86,13 @@ bool HwSpi::read(std::span<uint8_t> rx_data)
  */
 bool HwSpi::write(std::span<uint8_t> tx_data)
 {
-
     // Check if SPI is already in communication
     if (instance->SR & SPI_SR_BSY)
     {
         return false;
     }
 
-    for (size_t i = 0; i < tx_data.size(); i++)
-    {
-        int timeout = 1000;
-        while (!(instance->SR & SPI_SR_TXE) && --timeout > 0)
-        {
-            MM::Utils::DelayUs(1);
-        }
-        if (timeout == 0)
-            return false;
-
-        *(volatile uint8_t*)&instance->DR = tx_data[i];
-
-        timeout = 1000;
-        while (!(instance->SR & SPI_SR_RXNE) && --timeout > 0)
-        {
-            MM::Utils::DelayUs(1);
-        }
-        if (timeout == 0)
-            return false;
-
-        (void)(*(volatile uint8_t*)&instance->DR);
-    }
-
-    // Wait until transmission is complete
-    while (instance->SR & SPI_SR_BSY)
-    {
-    }
-
-    return true;
+    return transfer(tx_data.data(), nullptr, tx_data.size());
 }
 
 /**
@@ -148,37 +119,33 @@ bool HwSpi::seq_transfer(std::span<uint8_t> tx_data, std::span<uint8_t> rx_data)
     }
 
     /*
-     * First send all tx bytes and clear the RXNE flag for each transmitted
-     * byte (we don't use these intermediate bytes for flash commands).
+     * First send all tx bytes and drop what comes back (we don't use these
+     * intermediate bytes for flash commands), then clock out dummy bytes to
+     * read the expected response from the slave into rx_data.
      */
-    for (size_t i = 0; i < tx_data.size(); i++)
-    {
-        int timeout = 1000;
-        while (!(instance->SR & SPI_SR_TXE) && --timeout > 0)
-        {
-            MM::Utils::DelayUs(1);
-        }
-        if (timeout == 0)
-            return false;
-
-        *(volatile uint8_t*)&instance->DR = tx_data[i];
-
-        timeout = 1000;
-        while (!(instance->SR & SPI_SR_RXNE) && --timeout > 0)
-        {
-            MM::Utils::DelayUs(1);
-        }
-        if (timeout == 0)
-            return false;
+    return transfer(tx_data.data(), nullptr, tx_data.size()) &&
+           transfer(nullptr, rx_data.data(), rx_data.size());
+}
 
-        (void)(*(volatile uint8_t*)&instance->DR);
+/**
+ * @brief Full-duplex transfer over DMA or, when short, by polling
+ *
+ * @param tx Bytes to send, or nullptr to clock out zeros
+ * @param rx Destination for received bytes, or nullptr to discard them
+ * @param len Bytes clocked in each direction
+ */
+bool HwSpi::transfer(const uint8_t* tx, uint8_t* rx, size_t len)
+{
+    if (use_dma && len >= kDmaMinBytes)
+    {
+        return transfer_dma(tx, rx, len);
     }
+    return transfer_polled(tx, rx, len);
+}
 
-    /*
-     * Now generate clock pulses by sending dummy bytes to read the expected
-     * response from the slave into rx_data[0..rx_len-1].
-     */
-    for (size_t j = 0; j < rx_data.size(); j++)
+bool HwSpi::transfer_polled(const uint8_t* tx, uint8_t* rx, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
     {
         int timeout = 1000;
         while (!(instance->SR & SPI_SR_TXE) && --timeout > 0)
@@ -188,7 +155,7 @@ bool HwSpi::seq_transfer(std::span<uint8_t> tx_data, std::span<uint8_t> rx_data)
         if (timeout == 0)
             return false;
 
-        *(volatile uint8_t*)&instance->DR = 0x00;
+        *(volatile uint8_t*)&instance->DR = tx != nullptr ? tx[i] : 0x00;
 
         timeout = 1000;
         while (!(instance->SR & SPI_SR_RXNE) && --timeout > 0)
@@ -198,7 +165,9 @@ bool HwSpi::seq_transfer(std::span<uint8_t> tx_data, std::span<uint8_t> rx_data)
         if (timeout == 0)
             return false;
 
-        rx_data[j] = *(volatile uint8_t*)&instance->DR;
+        const uint8_t byte = *(volatile uint8_t*)&instance->DR;
+        if (rx != nullptr)
+            rx[i] = byte;
     }
 
     // Wait until transmission is complete
@@ -275,5 +244,150 @@ bool HwSpi::init()
 
     return true;
 }
+
+bool HwSpi::locate(DMA_Stream_TypeDef* regs, DmaStream& out)
+{
+    if (regs == nullptr)
+    {
+        return false;
+    }
+
+    // Locate the stream's controller and its slot in the flag registers
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(regs);
+    DMA_TypeDef* dma = addr >= DMA2_BASE ? DMA2 : DMA1;
+    const uintptr_t dma_base = reinterpret_cast<uintptr_t>(dma);
+    const uint32_t index = (addr - dma_base - kStreamOffset) / kStreamStride;
+    if (index > 7)
+    {
+        return false;
+    }
+    out.regs = regs;
+    out.flag_shift = kFlagShift[index % 4];
+    out.flag_clear = index < 4 ? &dma->LIFCR : &dma->HIFCR;
+    out.flag_status = index < 4 ? &dma->LISR : &dma->HISR;
+    return true;
+}
+
+void HwSpi::stop_stream(const DmaStream& stream)
+{
+    stream.regs->CR &= ~DMA_SxCR_EN;
+    while (stream.regs->CR & DMA_SxCR_EN)
+    {
+    }
+    *stream.flag_clear = kAllFlags << stream.flag_shift;
+}
+
+bool HwSpi::enable_dma(const StSpiDmaParams& params)
+{
+    if (params.channel > 7 || !locate(params.rx_stream, rx_dma) ||
+        !locate(params.tx_stream, tx_dma))
+    {
+        return false;
+    }
+    dma_channel = params.channel;
+
+    instance->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+    stop_stream(rx_dma);
+    stop_stream(tx_dma);
+    NVIC_SetPriority(params.rx_irq, kIrqPriority);
+    NVIC_ClearPendingIRQ(params.rx_irq);
+    NVIC_EnableIRQ(params.rx_irq);
+    use_dma = true;
+    return true;
+}
+
+/**
+ * @brief Full-duplex transfer by DMA; the RX stream finishes last
+ *
+ * @param tx Bytes to send, or nullptr to clock out zeros
+ * @param rx Destination for received bytes, or nullptr to discard them
+ * @param len Bytes clocked in each direction
+ */
+bool HwSpi::transfer_dma(const uint8_t* tx, uint8_t* rx, size_t len)
+{
+    while (len > 0)
+    {
+        const size_t chunk = len < kMaxDmaBytes ? len : kMaxDmaBytes;
+
+        done.reset();
+        dma_error = false;
+        stop_stream(rx_dma);
+        stop_stream(tx_dma);
+
+        // Drop a stale byte and any overrun so RX starts with this transfer
+        (void)(*(volatile uint8_t*)&instance->DR);
+        (void)instance->SR;
+
+        // Peripheral to memory, bytes; the sink is not incremented
+        rx_dma.regs->PAR = bus_address(&instance->DR);
+        rx_dma.regs->M0AR = bus_address(rx != nullptr ? rx : &dma_sink);
+        rx_dma.regs->NDTR = static_cast<uint32_t>(chunk);
+        rx_dma.regs->FCR = 0;  // Direct mode
+        rx_dma.regs->CR =
+            (static_cast<uint32_t>(dma_channel) << DMA_SxCR_CHSEL_Pos) |
+            DMA_SxCR_PL_1 |  // High priority, so RX never overruns
+            (rx != nullptr ? DMA_SxCR_MINC : 0u) | DMA_SxCR_TCIE |
+            DMA_SxCR_TEIE;
+
+        // Memory to peripheral, bytes; the fill byte is not incremented
+        tx_dma.regs->PAR = bus_address(&instance->DR);
+        tx_dma.regs->M0AR = bus_address(tx != nullptr ? tx : &dma_fill);
+        tx_dma.regs->NDTR = static_cast<uint32_t>(chunk);
+        tx_dma.regs->FCR = 0;
+        tx_dma.regs->CR =
+            (static_cast<uint32_t>(dma_channel) << DMA_SxCR_CHSEL_Pos) |
+            DMA_SxCR_PL_0 | (tx != nullptr ? DMA_SxCR_MINC : 0u) |
+            DMA_SxCR_DIR_0;
+
+        // RX request first, then the streams, then TX (RM0383, SPI DMA)
+        instance->CR2 |= SPI_CR2_RXDMAEN;
+        rx_dma.regs->CR |= DMA_SxCR_EN;
+        tx_dma.regs->CR |= DMA_SxCR_EN;
+        instance->CR2 |= SPI_CR2_TXDMAEN;
+
+        const uint32_t timeout_us =
+            kDmaTimeoutBaseUs +
+            kDmaTimeoutPerByteUs * static_cast<uint32_t>(chunk);
+        const bool taken = done.take(timeout_us);
+        if (!taken || dma_error)
+        {
+            instance->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+            stop_stream(rx_dma);
+            stop_stream(tx_dma);
+            return false;
+        }
+
+        // Every byte is in, so TX is empty; let the last frame finish
+        while (instance->SR & SPI_SR_BSY)
+        {
+        }
+        instance->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+
+        if (tx != nullptr)
+            tx += chunk;
+        if (rx != nullptr)
+            rx += chunk;
+        len -= chunk;
+    }
+
+    return true;
+}
+
+void HwSpi::irq_handler()
+{
+    const uint32_t status = *rx_dma.flag_status >> rx_dma.flag_shift;
+    *rx_dma.flag_clear = kAllFlags << rx_dma.flag_shift;
+
+    if (status & kTeif)
+    {
+        dma_error = true;
+    }
+    else if ((status & kTcif) == 0)
+    {
+        return;
+    }
+
+    done.give_from_isr();
+}
 }  // namespace Stmf4
-}  // namespace MM
\ No newline at end of file
+}  // namespace MM
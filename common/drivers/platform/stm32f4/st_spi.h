@@ -12,6 +12,7 @@
 #include <cstddef>
 #include <span>
 #include "reg_helpers.h"
+#include "rtos.h"
 #include "spi.h"
 #include "stm32f411xe.h"
 
@@ -100,6 +101,20 @@ struct StSpiSettings
     SpiRxThreshold threshold;
 };
 
+/**
+ * @brief DMA streams for one SPI peripheral
+ * @details F411 pairs that share a channel (RM0383 table 27/28): SPI1 DMA2
+ * S0/S2 RX + S3/S5 TX ch3, SPI2 DMA1 S3 RX + S4 TX ch0, SPI3 DMA1 S0/S2 RX
+ * + S5/S7 TX ch0, SPI4 DMA2 S0 RX + S1 TX ch4.
+ */
+struct StSpiDmaParams
+{
+    DMA_Stream_TypeDef* rx_stream;
+    DMA_Stream_TypeDef* tx_stream;
+    uint8_t channel;   ///< CHSEL of both requests
+    IRQn_Type rx_irq;  ///< The RX stream's interrupt
+};
+
 class HwSpi : public Spi
 {
 public:
@@ -112,10 +127,54 @@ public:
     bool seq_transfer(std::span<uint8_t> tx_data,
                       std::span<uint8_t> rx_data) override;
 
+    /**
+     * @brief Move transfers of kDmaMinBytes or more onto DMA
+     * @details The caller then blocks on a semaphore (and yields under
+     * FreeRTOS) instead of spinning on the status flags. A transfer costs
+     * one RX transfer-complete interrupt, or two for seq_transfer(): one
+     * for the command and one for the data. Shorter transfers stay polled,
+     * as they end before a task switch would. The BSP enables the DMA
+     * clock and calls irq_handler() from the RX stream's IRQ handler.
+     */
+    bool enable_dma(const StSpiDmaParams& params);
+
+    /**
+     * @brief RX stream interrupt; signals the waiting transfer
+     */
+    void irq_handler();
+
+    /// Below this, a transfer is polled even with DMA enabled
+    static constexpr size_t kDmaMinBytes = 16;
+
 private:
+    struct DmaStream
+    {
+        DMA_Stream_TypeDef* regs;
+        volatile uint32_t* flag_clear;  ///< LIFCR or HIFCR
+        const volatile uint32_t* flag_status;
+        uint8_t flag_shift;  ///< Position of the stream in xISR/xIFCR
+    };
+
+    static bool locate(DMA_Stream_TypeDef* regs, DmaStream& out);
+    static void stop_stream(const DmaStream& stream);
+
+    bool transfer(const uint8_t* tx, uint8_t* rx, size_t len);
+    bool transfer_polled(const uint8_t* tx, uint8_t* rx, size_t len);
+    bool transfer_dma(const uint8_t* tx, uint8_t* rx, size_t len);
+
     // Member variables
     SPI_TypeDef* instance;
     StSpiSettings settings;
+
+    // DMA transfer state
+    bool use_dma;
+    DmaStream rx_dma;
+    DmaStream tx_dma;
+    uint8_t dma_channel;
+    Rtos::BinarySemaphore done;
+    volatile bool dma_error;
+    uint8_t dma_fill;  ///< Clocked out when there is nothing to send
+    uint8_t dma_sink;  ///< Received bytes nobody asked for
 };
 }  // namespace Stmf4
 }  // namespace MM
\ No newline at end of file
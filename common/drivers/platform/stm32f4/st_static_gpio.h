@@ -0,0 +1,81 @@
+/**
+ * @file st_static_gpio.h
+ * @brief GPIO pin fixed at compile time
+ * @author TJ
+ * @date 2026-10-18
+ * @details The port address and pin masks are template constants, so
+ * set()/read() inline to a single BSRR store or IDR load with no vtable or
+ * shift at run time. The type is empty and satisfies MM::GpioLike, so it
+ * drops into code templated on the pin type (e.g. ChipSelect).
+ *
+ * @code
+ * using FlashCs = MM::Stmf4::StaticGpio<GPIOA_BASE, 4>;
+ * MM::ChipSelect<FlashCs> cs{flash_cs_pin};
+ * @endcode
+ */
+
+#pragma once
+#include <cstdint>
+#include "gpio.h"
+#include "st_gpio.h"
+#include "stm32f411xe.h"
+
+namespace MM
+{
+namespace Stmf4
+{
+
+/**
+ * @tparam PortBase GPIOx_BASE of the port (register pointers are not
+ *         usable as template arguments, their addresses are)
+ * @tparam Pin Pin number 0..15
+ */
+template <uintptr_t PortBase, uint8_t Pin>
+class StaticGpio
+{
+    static_assert(Pin < ST_GPIO_MAX_PINS, "GPIO pin out of range");
+
+public:
+    static constexpr uintptr_t port_base = PortBase;
+    static constexpr uint8_t pin = Pin;
+    static constexpr uint32_t set_mask = 1u << Pin;
+    static constexpr uint32_t reset_mask = 1u << (Pin + 16);
+
+    static GPIO_TypeDef* port()
+    {
+        return reinterpret_cast<GPIO_TypeDef*>(PortBase);
+    }
+
+    /**
+     * @brief Configure mode, type, speed, pull and AF
+     * @details Not time-critical, so it reuses the HwGpio code path.
+     * @return true if successful, false otherwise
+     */
+    static bool init(const StGpioSettings& settings)
+    {
+        HwGpio pin_config{StGpioParams{Pin, port(), settings}};
+        return pin_config.init();
+    }
+
+    static bool set(const bool active)
+    {
+        port()->BSRR = active ? set_mask : reset_mask;
+        return true;
+    }
+
+    static bool toggle()
+    {
+        return set((port()->ODR & set_mask) == 0u);
+    }
+
+    static bool read()
+    {
+        return (port()->IDR & set_mask) != 0u;
+    }
+};
+
+static_assert(GpioLike<StaticGpio<GPIOA_BASE, 5>>);
+static_assert(sizeof(StaticGpio<GPIOA_BASE, 5>) == 1);
+
+}  // namespace Stmf4
+}  // namespace MM
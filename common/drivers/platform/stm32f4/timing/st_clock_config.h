@@ -0,0 +1,207 @@
+/**
+ * @file st_clock_config.h
+ * @brief Compile-time PLL and bus-prescaler solver for the STM32F411
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details Pure constexpr math with no register access, so it builds on
+ * the host too. clock_config<Hz>() fails to compile when no legal PLL
+ * setting reaches the requested SYSCLK.
+ *
+ * F411 limits (RM0383 6.3.2, DS10314 6.3): VCO input 1-2 MHz, VCO output
+ * 100-432 MHz, SYSCLK/HCLK <= 100 MHz, PCLK1 <= 50 MHz, PCLK2 <= 100 MHz,
+ * 48 MHz domain <= 48 MHz.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace MM
+{
+namespace Stmf4
+{
+
+enum class ClockSource : uint8_t
+{
+    HSI = 0,
+    HSE = 1
+};
+
+/**
+ * @struct ClockTree
+ * @brief Bus frequencies derived from a clock configuration (Hz)
+ * @details Timer kernel clocks run at 2 x PCLK when their APB prescaler is
+ * not 1 (RM0383 6.2).
+ */
+struct ClockTree
+{
+    uint32_t sysclk_hz;
+    uint32_t hclk_hz;
+    uint32_t pclk1_hz;
+    uint32_t pclk2_hz;
+    uint32_t apb1_timer_hz;  ///< TIM2..TIM5
+    uint32_t apb2_timer_hz;  ///< TIM1, TIM9..TIM11
+    uint32_t pll48_hz;       ///< USB OTG FS / SDIO domain (0 without PLL)
+};
+
+/**
+ * @struct ClockConfig
+ * @brief Register-level PLL/prescaler settings plus the resulting tree
+ */
+struct ClockConfig
+{
+    bool valid;
+    bool use_pll;
+    ClockSource source;
+    uint32_t source_hz;
+    uint32_t pllm;           ///< 2..63
+    uint32_t plln;           ///< 50..432
+    uint32_t pllp;           ///< 2, 4, 6 or 8
+    uint32_t pllq;           ///< 2..15
+    uint32_t ahb_div;        ///< 1, 2, 4 ... 512
+    uint32_t apb1_div;       ///< 1, 2, 4, 8, 16
+    uint32_t apb2_div;       ///< 1, 2, 4, 8, 16
+    uint32_t flash_latency;  ///< Wait states at 2.7-3.6 V
+    ClockTree tree;
+};
+
+inline constexpr uint32_t kHsiHz = 16'000'000;
+inline constexpr uint32_t kMaxSysclkHz = 100'000'000;
+inline constexpr uint32_t kMaxPclk1Hz = 50'000'000;
+inline constexpr uint32_t kMaxPclk2Hz = 100'000'000;
+inline constexpr uint32_t kMaxPll48Hz = 48'000'000;
+
+namespace ClockMath
+{
+
+/**
+ * @brief Flash wait states for HCLK at 2.7-3.6 V (30 MHz per state)
+ */
+constexpr uint32_t flash_latency(uint32_t hclk_hz)
+{
+    return (hclk_hz - 1u) / 30'000'000u;
+}
+
+/**
+ * @brief Smallest power-of-two APB divider keeping PCLK under @p max_hz
+ */
+constexpr uint32_t apb_div(uint32_t hclk_hz, uint32_t max_hz)
+{
+    uint32_t div = 1;
+    while (div < 16 && hclk_hz / div > max_hz)
+        div *= 2;
+    return div;
+}
+
+constexpr uint32_t timer_clock(uint32_t pclk_hz, uint32_t apb_div)
+{
+    return apb_div == 1 ? pclk_hz : 2 * pclk_hz;
+}
+
+/**
+ * @brief Fill in prescalers, wait states and the derived tree
+ */
+constexpr ClockConfig finish(ClockConfig c, uint32_t sysclk_hz)
+{
+    c.ahb_div = 1;
+    c.apb1_div = apb_div(sysclk_hz, kMaxPclk1Hz);
+    c.apb2_div = apb_div(sysclk_hz, kMaxPclk2Hz);
+    c.flash_latency = flash_latency(sysclk_hz);
+
+    ClockTree& t = c.tree;
+    t.sysclk_hz = sysclk_hz;
+    t.hclk_hz = sysclk_hz / c.ahb_div;
+    t.pclk1_hz = t.hclk_hz / c.apb1_div;
+    t.pclk2_hz = t.hclk_hz / c.apb2_div;
+    t.apb1_timer_hz = timer_clock(t.pclk1_hz, c.apb1_div);
+    t.apb2_timer_hz = timer_clock(t.pclk2_hz, c.apb2_div);
+    t.pll48_hz = 0;
+    if (c.use_pll)
+        t.pll48_hz = c.source_hz / c.pllm * c.plln / c.pllq;
+
+    c.valid = true;
+    return c;
+}
+
+/**
+ * @brief Search PLLM/N/P/Q for an exact SYSCLK
+ * @details PLLM is tried from the 2 MHz VCO input ST recommends (lowest
+ * jitter) downwards; PLLQ is the smallest keeping the 48 MHz domain legal.
+ */
+constexpr ClockConfig solve(uint32_t sysclk_hz, ClockSource source,
+                            uint32_t source_hz)
+{
+    ClockConfig c{};
+    c.source = source;
+    c.source_hz = source_hz;
+
+    if (sysclk_hz == 0 || sysclk_hz > kMaxSysclkHz || source_hz == 0)
+        return c;
+
+    if (sysclk_hz == source_hz)
+        return finish(c, sysclk_hz);
+
+    constexpr uint32_t kPllp[] = {2, 4, 6, 8};
+    for (uint32_t m = 2; m <= 63; m++)
+    {
+        if (source_hz % m != 0)
+            continue;
+        const uint32_t vco_in = source_hz / m;
+        if (vco_in < 1'000'000 || vco_in > 2'000'000)
+            continue;
+
+        for (uint32_t p : kPllp)
+        {
+            const uint64_t vco_out = static_cast<uint64_t>(sysclk_hz) * p;
+            if (vco_out < 100'000'000 || vco_out > 432'000'000 ||
+                vco_out % vco_in != 0)
+                continue;
+            const uint32_t n = static_cast<uint32_t>(vco_out / vco_in);
+            if (n < 50 || n > 432)
+                continue;
+
+            uint32_t q = 2;
+            while (q < 15 && vco_out / q > kMaxPll48Hz)
+                q++;
+            if (vco_out / q > kMaxPll48Hz)
+                continue;
+
+            c.use_pll = true;
+            c.pllm = m;
+            c.plln = n;
+            c.pllp = p;
+            c.pllq = q;
+            return finish(c, sysclk_hz);
+        }
+    }
+    return c;
+}
+
+}  // namespace ClockMath
+
+/**
+ * @brief Compile-time clock configuration for an exact SYSCLK
+ * @tparam SysclkHz Target SYSCLK (= HCLK) in Hz
+ * @tparam Source PLL input
+ * @tparam SourceHz HSE crystal frequency (ignored for HSI)
+ */
+template <uint32_t SysclkHz, ClockSource Source = ClockSource::HSI,
+          uint32_t SourceHz = kHsiHz>
+consteval ClockConfig clock_config()
+{
+    constexpr ClockConfig c = ClockMath::solve(
+        SysclkHz, Source, Source == ClockSource::HSI ? kHsiHz : SourceHz);
+    static_assert(c.valid, "No legal PLL setting for this SYSCLK/source");
+    static_assert(c.tree.pclk1_hz <= kMaxPclk1Hz &&
+                      c.tree.pclk2_hz <= kMaxPclk2Hz,
+                  "APB clock out of range");
+    return c;
+}
+
+/// Reset state: 16 MHz HSI, no PLL, every prescaler 1
+inline constexpr ClockConfig kResetClock = clock_config<kHsiHz>();
+
+/// Full speed from the internal oscillator (M=8, N=100, P=2, Q=5)
+inline constexpr ClockConfig kClock100MHz = clock_config<100'000'000>();
+
+}  // namespace Stmf4
+}  // namespace MM
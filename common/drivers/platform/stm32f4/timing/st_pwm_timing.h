@@ -0,0 +1,159 @@
+/**
+ * @file st_pwm_timing.h
+ * @brief PSC/ARR selection for the finest PWM duty resolution
+ * @author Bex Saw
+ * @date 2026-10-18
+ * @details Pure constexpr math, so it builds and is tested on the host.
+ * For a given kernel clock and PWM frequency the smallest prescaler that
+ * lets the period fit in ARR is chosen: every extra prescaler step costs
+ * duty resolution. At 100 MHz a 20 kHz edge-aligned PWM gets ARR = 4999,
+ * i.e. 5000 duty levels instead of the 100 of the fixed ARR = 99 mode.
+ * Duty is expressed against the full scale (the CCR for 100 %), which
+ * differs from ARR + 1 in center-aligned mode.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace MM
+{
+namespace Stmf4
+{
+
+struct PwmTiming
+{
+    bool valid;
+    uint32_t psc;           ///< Register value (divider - 1)
+    uint32_t arr;           ///< Register value
+    uint32_t full_scale;    ///< CCR for 100 % duty, = number of duty steps
+    uint32_t frequency_hz;  ///< Actual frequency after rounding
+};
+
+/**
+ * @brief CCR value for 100 % duty at a given ARR
+ * @details Edge-aligned the counter runs 0..ARR, ARR + 1 counts per
+ * period. Center-aligned it runs 0..ARR..0, 2 x ARR counts per period,
+ * and the output is active for 2 x CCR of them, so ARR is full duty.
+ */
+constexpr uint32_t pwm_full_scale(uint32_t arr, bool center_aligned)
+{
+    return center_aligned ? arr : arr + 1u;
+}
+
+/**
+ * @brief Pick PSC/ARR for @p frequency_hz with the largest possible ARR
+ * @param timer_clock_hz Timer kernel clock
+ * @param center_aligned Counter runs up and down (period is 2 x ARR)
+ * @param max_arr 0xFFFF for 16-bit timers, 0xFFFFFFFF for TIM2/TIM5
+ */
+constexpr PwmTiming pwm_timing(uint32_t timer_clock_hz, uint32_t frequency_hz,
+                               bool center_aligned, uint32_t max_arr = 0xFFFF)
+{
+    PwmTiming t{};
+    if (timer_clock_hz == 0 || frequency_hz == 0)
+        return t;
+
+    // Counts per period (edge) or per half period (center), which is also
+    // the duty full scale. It must fit in a uint32_t.
+    const uint64_t rate =
+        static_cast<uint64_t>(frequency_hz) * (center_aligned ? 2u : 1u);
+    const uint64_t ticks = (timer_clock_hz + rate / 2) / rate;
+    const uint64_t span = center_aligned
+                              ? max_arr
+                              : (max_arr < 0xFFFFFFFFu ? max_arr + 1ull
+                                                       : 0xFFFFFFFFull);
+
+    const uint64_t psc_plus1 = (ticks + span - 1) / span;
+    if (psc_plus1 < 1 || psc_plus1 > 65536)
+        return t;
+
+    const uint64_t denom = psc_plus1 * rate;
+    const uint64_t counts = (timer_clock_hz + denom / 2) / denom;
+    if (counts < 2 || counts > span)  // Need at least two duty levels
+        return t;
+
+    t.valid = true;
+    t.psc = static_cast<uint32_t>(psc_plus1 - 1);
+    t.full_scale = static_cast<uint32_t>(counts);
+    t.arr = center_aligned ? t.full_scale : t.full_scale - 1u;
+    t.frequency_hz = static_cast<uint32_t>(
+        timer_clock_hz / (psc_plus1 * counts * (center_aligned ? 2u : 1u)));
+    return t;
+}
+
+/**
+ * @brief CCR for a duty given in Q16 (65536 = 100 %), rounded to nearest
+ * @param full_scale CCR for 100 % duty, see pwm_full_scale()
+ */
+constexpr uint32_t duty_ccr_q16(uint32_t full_scale, uint32_t duty_q16)
+{
+    if (duty_q16 > 0x10000u)
+        duty_q16 = 0x10000u;
+    return static_cast<uint32_t>(
+        (static_cast<uint64_t>(full_scale) * duty_q16 + 0x8000u) >> 16);
+}
+
+/**
+ * @brief CCR for a duty given in 1/1000, rounded to nearest
+ * @param full_scale CCR for 100 % duty, see pwm_full_scale()
+ */
+constexpr uint32_t duty_ccr_permille(uint32_t full_scale,
+                                     uint32_t duty_permille)
+{
+    if (duty_permille > 1000u)
+        duty_permille = 1000u;
+    return static_cast<uint32_t>(
+        (static_cast<uint64_t>(full_scale) * duty_permille + 500u) / 1000u);
+}
+
+/**
+ * @brief Move a CCR to a new full scale, keeping the duty fraction
+ * @param ccr Current CCR
+ * @param old_full_scale Full scale @p ccr was computed for
+ * @param new_full_scale Full scale the result is for
+ */
+constexpr uint32_t rescale_ccr(uint32_t ccr, uint32_t old_full_scale,
+                               uint32_t new_full_scale)
+{
+    if (old_full_scale == 0)
+        return 0;
+    return static_cast<uint32_t>(
+        (static_cast<uint64_t>(ccr) * new_full_scale + old_full_scale / 2u) /
+        old_full_scale);
+}
+
+/**
+ * @brief Encode a dead time for TIM1 BDTR.DTG (RM0383 13.4.18)
+ * @param ticks Dead time in timer kernel clock periods (CKD = 0)
+ * @return DTG value giving the shortest dead time >= @p ticks, clamped to
+ *         the 1008-tick maximum
+ */
+constexpr uint8_t dead_time_dtg(uint32_t ticks)
+{
+    if (ticks <= 127)
+        return static_cast<uint8_t>(ticks);
+    if (ticks <= 254)
+        return static_cast<uint8_t>(0x80 | ((ticks + 1) / 2 - 64));
+    if (ticks <= 504)
+        return static_cast<uint8_t>(0xC0 | ((ticks + 7) / 8 - 32));
+    if (ticks <= 1008)
+        return static_cast<uint8_t>(0xE0 | ((ticks + 15) / 16 - 32));
+    return 0xFF;
+}
+
+/**
+ * @brief Dead time in ticks produced by a DTG value
+ */
+constexpr uint32_t dead_time_ticks(uint8_t dtg)
+{
+    if ((dtg & 0x80) == 0)
+        return dtg;
+    if ((dtg & 0xC0) == 0x80)
+        return (64u + (dtg & 0x3Fu)) * 2u;
+    if ((dtg & 0xE0) == 0xC0)
+        return (32u + (dtg & 0x1Fu)) * 8u;
+    return (32u + (dtg & 0x1Fu)) * 16u;
+}
+
+}  // namespace Stmf4
+}  // namespace MM
@@ -0,0 +1,148 @@
+/**
+ * @file st_clock_config_test.cc
+ * @brief Host checks of the F411 PLL and prescaler solver
+ * @author Kent Hong
+ * @date 2026-10-18
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <utility>
+#include "st_clock_config.h"
+
+namespace MM::Stmf4
+{
+namespace
+{
+
+/**
+ * @brief Every F411 limit a solved configuration has to respect
+ */
+void expect_legal(const ClockConfig& c, uint32_t sysclk_hz)
+{
+    ASSERT_TRUE(c.valid);
+    EXPECT_EQ(c.tree.sysclk_hz, sysclk_hz);
+    EXPECT_LE(c.tree.hclk_hz, kMaxSysclkHz);
+    EXPECT_LE(c.tree.pclk1_hz, kMaxPclk1Hz);
+    EXPECT_LE(c.tree.pclk2_hz, kMaxPclk2Hz);
+    EXPECT_EQ(c.flash_latency, (c.tree.hclk_hz - 1) / 30'000'000);
+
+    if (!c.use_pll)
+    {
+        EXPECT_EQ(c.source_hz, sysclk_hz);
+        return;
+    }
+
+    const uint32_t vco_in = c.source_hz / c.pllm;
+    const uint64_t vco_out = static_cast<uint64_t>(vco_in) * c.plln;
+    EXPECT_EQ(c.source_hz % c.pllm, 0u);
+    EXPECT_GE(vco_in, 1'000'000u);
+    EXPECT_LE(vco_in, 2'000'000u);
+    EXPECT_GE(vco_out, 100'000'000u);
+    EXPECT_LE(vco_out, 432'000'000u);
+    EXPECT_GE(c.pllm, 2u);
+    EXPECT_LE(c.pllm, 63u);
+    EXPECT_GE(c.plln, 50u);
+    EXPECT_LE(c.plln, 432u);
+    EXPECT_TRUE(c.pllp == 2 || c.pllp == 4 || c.pllp == 6 || c.pllp == 8);
+    EXPECT_GE(c.pllq, 2u);
+    EXPECT_LE(c.pllq, 15u);
+    EXPECT_EQ(vco_out / c.pllp, sysclk_hz);
+    EXPECT_LE(c.tree.pll48_hz, kMaxPll48Hz);
+}
+
+TEST(ClockConfigTest, FullSpeedFromHsi)
+{
+    constexpr ClockConfig c = kClock100MHz;
+    EXPECT_EQ(c.source, ClockSource::HSI);
+    EXPECT_EQ(c.pllm, 8u);
+    EXPECT_EQ(c.plln, 100u);
+    EXPECT_EQ(c.pllp, 2u);
+    EXPECT_EQ(c.pllq, 5u);
+    EXPECT_EQ(c.flash_latency, 3u);
+    EXPECT_EQ(c.apb1_div, 2u);
+    EXPECT_EQ(c.apb2_div, 1u);
+    EXPECT_EQ(c.tree.pclk1_hz, 50'000'000u);
+    EXPECT_EQ(c.tree.pclk2_hz, 100'000'000u);
+    // APB1 is divided, so its timers run at 2 x PCLK1
+    EXPECT_EQ(c.tree.apb1_timer_hz, 100'000'000u);
+    EXPECT_EQ(c.tree.apb2_timer_hz, 100'000'000u);
+    EXPECT_EQ(c.tree.pll48_hz, 40'000'000u);
+    expect_legal(c, 100'000'000);
+}
+
+TEST(ClockConfigTest, ResetClockHasNoPll)
+{
+    constexpr ClockConfig c = kResetClock;
+    EXPECT_FALSE(c.use_pll);
+    EXPECT_EQ(c.flash_latency, 0u);
+    EXPECT_EQ(c.apb1_div, 1u);
+    EXPECT_EQ(c.tree.apb1_timer_hz, kHsiHz);
+    EXPECT_EQ(c.tree.pll48_hz, 0u);
+    expect_legal(c, kHsiHz);
+}
+
+TEST(ClockConfigTest, HseCrystals)
+{
+    // 25 MHz is the usual Black Pill crystal, 8 MHz the Nucleo ST-LINK MCO
+    constexpr ClockConfig c25 =
+        clock_config<100'000'000, ClockSource::HSE, 25'000'000>();
+    EXPECT_EQ(c25.source, ClockSource::HSE);
+    EXPECT_EQ(c25.source_hz, 25'000'000u);
+    expect_legal(c25, 100'000'000);
+
+    // 96 MHz gives USB its exact 48 MHz
+    constexpr ClockConfig c8 =
+        clock_config<96'000'000, ClockSource::HSE, 8'000'000>();
+    expect_legal(c8, 96'000'000);
+    EXPECT_EQ(c8.tree.pll48_hz, 48'000'000u);
+}
+
+TEST(ClockConfigTest, UnreachableTargetsAreInvalid)
+{
+    using ClockMath::solve;
+    EXPECT_FALSE(solve(0, ClockSource::HSI, kHsiHz).valid);
+    EXPECT_FALSE(solve(120'000'000, ClockSource::HSI, kHsiHz).valid);
+    EXPECT_FALSE(solve(100'000'000, ClockSource::HSE, 0).valid);
+    // Not a whole multiple of any legal VCO input
+    EXPECT_FALSE(solve(99'999'999, ClockSource::HSI, kHsiHz).valid);
+}
+
+TEST(ClockConfigTest, EverySolvedFrequencyIsLegal)
+{
+    // Sweep the whole range in 1 MHz steps from both common sources
+    uint32_t solved = 0;
+    for (uint32_t mhz = 1; mhz <= 100; mhz++)
+    {
+        const uint32_t hz = mhz * 1'000'000;
+        for (const auto& [source, source_hz] :
+             {std::pair{ClockSource::HSI, kHsiHz},
+              std::pair{ClockSource::HSE, 25'000'000u}})
+        {
+            const ClockConfig c = ClockMath::solve(hz, source, source_hz);
+            if (!c.valid)
+                continue;
+            SCOPED_TRACE(mhz);
+            expect_legal(c, hz);
+            solved++;
+        }
+    }
+    // Everything from 13 MHz up is reachable with a 1-2 MHz VCO input
+    EXPECT_GE(solved, 2u * 88u);
+}
+
+TEST(ClockConfigTest, PrescalerHelpers)
+{
+    using namespace ClockMath;
+    EXPECT_EQ(apb_div(100'000'000, kMaxPclk1Hz), 2u);
+    EXPECT_EQ(apb_div(50'000'000, kMaxPclk1Hz), 1u);
+    EXPECT_EQ(apb_div(51'000'000, kMaxPclk1Hz), 2u);
+    EXPECT_EQ(flash_latency(30'000'000), 0u);
+    EXPECT_EQ(flash_latency(30'000'001), 1u);
+    EXPECT_EQ(flash_latency(90'000'001), 3u);
+    EXPECT_EQ(timer_clock(25'000'000, 1), 25'000'000u);
+    EXPECT_EQ(timer_clock(25'000'000, 4), 50'000'000u);
+}
+
+}  // namespace
+}  // namespace MM::Stmf4
@@ -0,0 +1,223 @@
+/**
+ * @file st_pwm_timing_test.cc
+ * @brief Host checks of the PWM period, duty and dead-time arithmetic
+ * @author Bex Saw
+ * @date 2026-10-18
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <initializer_list>
+#include "st_pwm_timing.h"
+
+namespace MM::Stmf4
+{
+namespace
+{
+
+TEST(PwmTimingTest, DeadTimeRanges)
+{
+    // One value from each of the four DTG encodings
+    EXPECT_EQ(dead_time_dtg(100), 100u);
+    EXPECT_EQ(dead_time_ticks(dead_time_dtg(100)), 100u);
+    EXPECT_EQ(dead_time_ticks(dead_time_dtg(201)), 202u);
+    EXPECT_EQ(dead_time_ticks(dead_time_dtg(300)), 304u);
+    EXPECT_EQ(dead_time_ticks(dead_time_dtg(1000)), 1008u);
+    EXPECT_EQ(dead_time_dtg(2000), 0xFFu);
+    EXPECT_EQ(dead_time_ticks(0xFF), 1008u);
+}
+
+TEST(PwmTimingTest, DeadTimeIsShortestNotBelowRequest)
+{
+    for (uint32_t ticks = 0; ticks <= 1008; ticks++)
+    {
+        SCOPED_TRACE(ticks);
+        const uint8_t dtg = dead_time_dtg(ticks);
+        const uint32_t produced = dead_time_ticks(dtg);
+        EXPECT_GE(produced, ticks);
+
+        // No DTG value lies in [ticks, produced)
+        for (uint32_t other = 0; other < 256; other++)
+        {
+            const uint32_t t = dead_time_ticks(static_cast<uint8_t>(other));
+            EXPECT_FALSE(t >= ticks && t < produced);
+        }
+    }
+}
+
+/**
+ * @brief Timer counts in one PWM period for a solved timing
+ */
+uint64_t period_counts(const PwmTiming& t, bool center_aligned)
+{
+    const uint64_t counts = center_aligned
+                                ? 2ull * t.arr
+                                : static_cast<uint64_t>(t.arr) + 1u;
+    return (static_cast<uint64_t>(t.psc) + 1u) * counts;
+}
+
+TEST(PwmTimingTest, EdgeAlignedValues)
+{
+    const PwmTiming t = pwm_timing(100'000'000, 20'000, false);
+    ASSERT_TRUE(t.valid);
+    EXPECT_EQ(t.psc, 0u);
+    EXPECT_EQ(t.arr, 4999u);
+    EXPECT_EQ(t.full_scale, 5000u);
+    EXPECT_EQ(t.frequency_hz, 20'000u);
+    EXPECT_EQ(period_counts(t, false), 5000u);
+
+    EXPECT_EQ(pwm_timing(100'000'000, 1'000, false).frequency_hz, 1'000u);
+    EXPECT_EQ(pwm_full_scale(4999, false), 5000u);
+}
+
+TEST(PwmTimingTest, CenterAlignedPeriodIsTwiceArr)
+{
+    // Up 0..ARR and back down is 2 x ARR counts, not 2 x (ARR + 1)
+    const PwmTiming t = pwm_timing(100'000'000, 20'000, true);
+    ASSERT_TRUE(t.valid);
+    EXPECT_EQ(t.psc, 0u);
+    EXPECT_EQ(t.arr, 2500u);
+    EXPECT_EQ(t.full_scale, 2500u);
+    EXPECT_EQ(period_counts(t, true), 5000u);
+    EXPECT_EQ(t.frequency_hz, 20'000u);
+    EXPECT_EQ(pwm_full_scale(2500, true), 2500u);
+
+    // Full duty is CCR = ARR
+    EXPECT_EQ(duty_ccr_q16(t.full_scale, 0x10000), t.arr);
+    EXPECT_EQ(duty_ccr_permille(t.full_scale, 500), 1250u);
+}
+
+TEST(PwmTimingTest, WideTimersAndLimits)
+{
+    // TIM2/TIM5 need no prescaler where 16-bit timers would
+    const PwmTiming wide = pwm_timing(16'000'000, 100, false, 0xFFFFFFFF);
+    ASSERT_TRUE(wide.valid);
+    EXPECT_EQ(wide.psc, 0u);
+    EXPECT_EQ(wide.arr, 159'999u);
+    const PwmTiming narrow = pwm_timing(16'000'000, 100, false);
+    ASSERT_TRUE(narrow.valid);
+    EXPECT_GT(narrow.psc, 0u);
+
+    // The full scale always fits in 32 bits
+    const PwmTiming slow = pwm_timing(100'000'000, 1, false, 0xFFFFFFFF);
+    ASSERT_TRUE(slow.valid);
+    EXPECT_EQ(slow.full_scale, 100'000'000u);
+
+    EXPECT_FALSE(pwm_timing(100'000'000, 80'000'000, false).valid);
+    EXPECT_FALSE(pwm_timing(100'000'000, 0, false).valid);
+    EXPECT_FALSE(pwm_timing(0, 20'000, false).valid);
+    // 1 Hz on a 16-bit timer still fits with PSC = 1525
+    EXPECT_EQ(pwm_timing(100'000'000, 1, false).psc, 1525u);
+}
+
+TEST(PwmTimingTest, DutyRounding)
+{
+    EXPECT_EQ(duty_ccr_q16(5000, 0x10000), 5000u);
+    EXPECT_EQ(duty_ccr_q16(5000, 0x8000), 2500u);
+    EXPECT_EQ(duty_ccr_q16(5000, 0x20000), 5000u);
+    EXPECT_EQ(duty_ccr_permille(5000, 333), 1665u);
+    EXPECT_EQ(duty_ccr_permille(100, 5), 1u);
+    EXPECT_EQ(duty_ccr_permille(100, 4), 0u);
+}
+
+/**
+ * @brief Worst Q16 duty error over a sweep, in CCR steps
+ */
+double worst_quantization_steps(uint32_t full_scale)
+{
+    double worst = 0.0;
+    for (uint32_t duty = 0; duty <= 0x10000u; duty += 0x101u)
+    {
+        const double wanted = static_cast<double>(duty) / 65536.0;
+        const double got =
+            static_cast<double>(duty_ccr_q16(full_scale, duty)) / full_scale;
+        const double err = (got > wanted ? got - wanted : wanted - got) *
+                           full_scale;
+        worst = err > worst ? err : worst;
+    }
+    return worst;
+}
+
+TEST(PwmTimingTest, FrequencySweepQuantization)
+{
+    // 20 Hz to 100 kHz at the reset and full-speed timer clocks
+    for (uint32_t clock_hz : {16'000'000u, 100'000'000u})
+    {
+        for (bool center : {false, true})
+        {
+            for (uint32_t f = 20; f <= 100'000; f = f * 5 / 4)
+            {
+                SCOPED_TRACE(testing::Message() << clock_hz << " Hz clock, "
+                                                << f << " Hz, center "
+                                                << center);
+                const PwmTiming t = pwm_timing(clock_hz, f, center);
+                ASSERT_TRUE(t.valid);
+                EXPECT_EQ(t.full_scale, pwm_full_scale(t.arr, center));
+
+                // Within half a CCR step of the requested duty; exact ties
+                // occur, so allow for the double rounding
+                EXPECT_LE(worst_quantization_steps(t.full_scale), 0.5 + 1e-9);
+
+                // Largest ARR: one prescaler step less would overflow it
+                const uint64_t span = center ? 0xFFFFu : 0x10000u;
+                const uint64_t counts = clock_hz / (f * (center ? 2u : 1u));
+                if (t.psc > 0)
+                    EXPECT_GT(counts / t.psc, span);
+
+                // Actual frequency within one count of the request
+                const double period =
+                    static_cast<double>(period_counts(t, center)) / clock_hz;
+                const double step =
+                    static_cast<double>(t.psc + 1u) * (center ? 2 : 1) /
+                    clock_hz;
+                EXPECT_NEAR(period, 1.0 / f, step);
+            }
+        }
+    }
+}
+
+TEST(PwmTimingTest, MotorResolutionVsPercentMode)
+{
+    // 20 kHz: 5000 steps in MAX resolution vs 100 in PERCENT mode
+    const PwmTiming t = pwm_timing(100'000'000, 20'000, false);
+    EXPECT_EQ(t.full_scale / 100u, 50u);
+    EXPECT_LE(worst_quantization_steps(t.full_scale) / t.full_scale,
+              0.5 / 5000.0);
+}
+
+TEST(PwmTimingTest, RescaleKeepsDutyFraction)
+{
+    // 25 % of a 1000-step period moved to 5000 steps and back
+    EXPECT_EQ(rescale_ccr(250, 1000, 5000), 1250u);
+    EXPECT_EQ(rescale_ccr(1250, 5000, 1000), 250u);
+    EXPECT_EQ(rescale_ccr(0, 1000, 5000), 0u);
+    EXPECT_EQ(rescale_ccr(100, 0, 5000), 0u);
+    // Full duty stays full duty, edge to center alike
+    EXPECT_EQ(rescale_ccr(1000, 1000, 2500), 2500u);
+    // 32-bit timers do not overflow the intermediate product
+    EXPECT_EQ(rescale_ccr(0x80000000u, 0xFFFFFFFFu, 100), 50u);
+
+    // Rounded to nearest: never more than half a step off
+    for (uint32_t ccr = 0; ccr <= 1000; ccr += 7)
+    {
+        const uint32_t scaled = rescale_ccr(ccr, 1000, 2500);
+        EXPECT_LE(scaled * 1000u > ccr * 2500u ? scaled * 1000u - ccr * 2500u
+                                               : ccr * 2500u - scaled * 1000u,
+                  500u);
+    }
+}
+
+TEST(PwmTimingTest, GroupMotorFrequency)
+{
+    // Differential drive: 20 kHz on a 16-bit TIM3/TIM4 at 100 MHz
+    const PwmTiming t = pwm_timing(100'000'000, 20'000, false);
+    ASSERT_TRUE(t.valid);
+    EXPECT_EQ(duty_ccr_permille(t.full_scale, 0), 0u);
+    EXPECT_EQ(duty_ccr_permille(t.full_scale, 1), 5u);
+    EXPECT_EQ(duty_ccr_permille(t.full_scale, 1000), 5000u);
+    // Clamped above full scale
+    EXPECT_EQ(duty_ccr_permille(t.full_scale, 1200), 5000u);
+}
+
+}  // namespace
+}  // namespace MM::Stmf4
@@ -0,0 +1,45 @@
+/**
+ * @file alarm.h
+ * @brief One-shot hardware alarm interface
+ * @author Kent Hong
+ * @date 2026-10-18
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace MM
+{
+
+/**
+ * @class Alarm
+ * @brief A single compare channel against the microsecond timebase
+ * @details Backs the software TimerService: only the earliest pending
+ * deadline is ever programmed into the hardware.
+ */
+class Alarm
+{
+public:
+    using Handler = void (*)(void* ctx);
+
+    /**
+    * @brief Set the function called (from interrupt context) on expiry
+    */
+    virtual void set_handler(Handler handler, void* ctx) = 0;
+
+    /**
+    * @brief Fire once when now_us() reaches @p deadline_us
+    * @details A deadline already in the past fires as soon as possible.
+    * Re-arming replaces the previous deadline.
+    */
+    virtual void arm(uint32_t deadline_us) = 0;
+
+    /**
+    * @brief Cancel the pending deadline, if any
+    */
+    virtual void disarm() = 0;
+
+    ~Alarm() = default;
+};
+
+}  // namespace MM
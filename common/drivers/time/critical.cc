@@ -0,0 +1,27 @@
+#include "critical.h"
+
+#ifdef STM32F4xx
+#include "stm32f4xx.h"
+#endif
+
+namespace MM::Utils
+{
+
+CriticalSection::CriticalSection()
+{
+#ifdef STM32F4xx
+    primask = __get_PRIMASK();
+    __disable_irq();
+#else
+    primask = 0;
+#endif
+}
+
+CriticalSection::~CriticalSection()
+{
+#ifdef STM32F4xx
+    __set_PRIMASK(primask);
+#endif
+}
+
+}  // namespace MM::Utils
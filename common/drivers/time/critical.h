@@ -0,0 +1,33 @@
+/**
+ * @file critical.h
+ * @brief Scoped interrupt lock
+ * @author Kent Hong
+ * @date 2026-10-18
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace MM::Utils
+{
+
+/**
+ * @class CriticalSection
+ * @brief Masks interrupts for its lifetime and restores the previous state
+ * @details Nests safely because PRIMASK is saved rather than cleared on
+ * exit. No-op on native builds.
+ */
+class CriticalSection
+{
+public:
+    CriticalSection();
+    ~CriticalSection();
+
+    CriticalSection(const CriticalSection&) = delete;
+    CriticalSection& operator=(const CriticalSection&) = delete;
+
+private:
+    uint32_t primask;
+};
+
+}  // namespace MM::Utils
@@ -1,35 +1,47 @@
 #include "delay.h"
-
-#ifdef STM32F4xx
-#include "stm32f4xx.h"
-#endif
+#include "timebase.h"
 
 namespace MM::Utils
 {
 
-void DelayMs(uint32_t ms)
+/**
+ * @brief Wait @p count steps of @p step_cycles each
+ * @details Each target is advanced from the previous target rather than
+ * re-read from the counter, so loop overhead does not accumulate and every
+ * wait stays well inside the 2^31-cycle window of reached().
+ */
+static void wait_steps(uint32_t count, uint32_t step_cycles)
 {
-#ifdef STM32F4xx
-    // Embedded target: busy-wait loop
-    for (uint32_t i = 0; i < ms * 4000; i++)
+    uint32_t target = now_cycles();
+    while (count-- > 0)
     {
-        __NOP();
+        target += step_cycles;
+        wait_until_cycles(target);
     }
-#else
-    (void)ms;
-#endif
+}
+
+/**
+ * @brief Start the timebase with the reset defaults if nobody has yet
+ * @details Keeps the delays usable in BSP code that runs before the clock
+ * tree is configured.
+ */
+static void ensure_timebase()
+{
+    if (!timebase_initialised())
+        timebase_init(TimebaseConfig{});
+}
+
+void DelayMs(uint32_t ms)
+{
+    ensure_timebase();
+    wait_steps(ms, cycles_per_us() * 1000u);
 }
 
 void DelayUs(uint32_t us)
 {
-#ifdef STM32F4xx
-    for (uint32_t i = 0; i < us * 4; i++)
-    {
-        __NOP();
-    }
-#else
-    (void)us;
-#endif
+    ensure_timebase();
+    wait_steps(us / 1000u, cycles_per_us() * 1000u);
+    wait_steps(1, (us % 1000u) * cycles_per_us());
 }
 
 }  // namespace MM::Utils
@@ -5,6 +5,8 @@ namespace MM::Utils
 {
 /**
     * @brief Delays execution for a specified number of milliseconds.
+    * @details Busy-waits on the timebase cycle counter, so the duration is
+    * independent of optimisation level and flash wait states.
     * @param ms The number of milliseconds to delay.
     */
 void DelayMs(uint32_t ms);
@@ -0,0 +1,72 @@
+/**
+ * @file sim_alarm.h
+ * @brief Alarm backed by the simulated native timebase
+ * @author Kent Hong
+ * @date 2026-10-18
+ */
+
+#pragma once
+#include "alarm.h"
+#include "timebase.h"
+
+namespace MM
+{
+
+/**
+ * @class SimAlarm
+ * @brief Host-side Alarm: the simulation loop polls it instead of an IRQ
+ * @details Typical loop: pending() gives the next deadline, the host
+ * advances the simulated clock to it, then poll() fires the handler.
+ */
+class SimAlarm : public Alarm
+{
+public:
+    void set_handler(Handler handler_, void* ctx_) override
+    {
+        handler = handler_;
+        ctx = ctx_;
+    }
+
+    void arm(uint32_t deadline_us) override
+    {
+        deadline = deadline_us;
+        armed = true;
+    }
+
+    void disarm() override
+    {
+        armed = false;
+    }
+
+    /**
+    * @brief Get the armed deadline
+    * @return false if nothing is armed
+    */
+    bool pending(uint32_t& deadline_us) const
+    {
+        deadline_us = deadline;
+        return armed;
+    }
+
+    /**
+    * @brief Fire the handler if the clock has reached the deadline
+    * @return true if the handler ran
+    */
+    bool poll()
+    {
+        if (!armed || !Utils::reached(deadline, Utils::now_us()))
+            return false;
+        armed = false;
+        if (handler != nullptr)
+            handler(ctx);
+        return true;
+    }
+
+private:
+    Handler handler = nullptr;
+    void* ctx = nullptr;
+    uint32_t deadline = 0;
+    bool armed = false;
+};
+
+}  // namespace MM
@@ -0,0 +1,159 @@
+#include "timebase.h"
+#include "critical.h"
+
+#ifdef STM32F4xx
+#include "stm32f4xx.h"
+#endif
+
+namespace MM::Utils
+{
+
+namespace
+{
+
+TimebaseConfig active;
+bool initialised = false;
+
+}  // namespace
+
+uint32_t cycles_per_us()
+{
+    return active.core_clock_hz / 1'000'000u;
+}
+
+uint32_t now_ms()
+{
+    return now_us() / 1000u;
+}
+
+#ifdef STM32F4xx
+
+namespace
+{
+
+TIM_TypeDef* timer = nullptr;
+
+// Software extension of CYCCNT, used for now_us() when no timer is given
+uint32_t last_cycles = 0;
+uint64_t cycles_high = 0;
+
+}  // namespace
+
+bool timebase_init(const TimebaseConfig& config)
+{
+    if (config.core_clock_hz < 1'000'000u)
+        return false;
+    if (config.timer_base != 0 && config.timer_clock_hz < 1'000'000u)
+        return false;
+
+    active = config;
+
+    // DWT cycle counter; TRCENA gates the whole DWT block
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    last_cycles = 0;
+    cycles_high = 0;
+
+    timer = reinterpret_cast<TIM_TypeDef*>(config.timer_base);
+    if (timer != nullptr)
+    {
+        // Free-running 1 MHz up-counter over the full 32-bit range
+        timer->CR1 = 0;
+        timer->PSC = config.timer_clock_hz / 1'000'000u - 1u;
+        timer->ARR = 0xFFFFFFFFu;
+        timer->CNT = 0;
+        timer->EGR = TIM_EGR_UG;  // Load PSC now rather than at overflow
+        timer->SR = 0;
+        timer->CR1 = TIM_CR1_CEN;
+    }
+
+    initialised = true;
+    return true;
+}
+
+uint32_t now_cycles()
+{
+    return DWT->CYCCNT;
+}
+
+uint32_t now_us()
+{
+    if (timer != nullptr)
+        return timer->CNT;
+
+    // Called from both thread and interrupt context, so update the
+    // extension with interrupts masked
+    uint64_t total;
+    {
+        CriticalSection lock;
+        const uint32_t cycles = DWT->CYCCNT;
+        cycles_high += cycles - last_cycles;
+        last_cycles = cycles;
+        total = cycles_high;
+    }
+    return static_cast<uint32_t>(total / cycles_per_us());
+}
+
+#else
+
+namespace
+{
+
+// Simulated clock for native builds
+uint64_t sim_cycles = 0;
+
+}  // namespace
+
+bool timebase_init(const TimebaseConfig& config)
+{
+    if (config.core_clock_hz < 1'000'000u)
+        return false;
+
+    active = config;
+    sim_cycles = 0;
+    initialised = true;
+    return true;
+}
+
+uint32_t now_cycles()
+{
+    return static_cast<uint32_t>(sim_cycles);
+}
+
+uint32_t now_us()
+{
+    return static_cast<uint32_t>(sim_cycles / cycles_per_us());
+}
+
+void timebase_advance_us(uint32_t us)
+{
+    sim_cycles += static_cast<uint64_t>(us) * cycles_per_us();
+}
+
+#endif
+
+bool timebase_initialised()
+{
+    return initialised;
+}
+
+const TimebaseConfig& timebase_config()
+{
+    return active;
+}
+
+void wait_until_cycles(uint32_t target)
+{
+#ifdef STM32F4xx
+    while (!reached(target, now_cycles()))
+    {
+    }
+#else
+    // Nothing else advances simulated time, so jump straight to the target
+    if (!reached(target, now_cycles()))
+        sim_cycles += target - now_cycles();
+#endif
+}
+
+}  // namespace MM::Utils
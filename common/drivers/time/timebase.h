@@ -0,0 +1,147 @@
+/**
+ * @file timebase.h
+ * @brief Monotonic cycle/microsecond timebase and deadline helpers
+ * @author Kent Hong
+ * @date 2026-10-18
+ * @details On the STM32 the cycle count comes from the DWT CYCCNT register
+ * and microseconds from an optional free-running 32-bit timer (TIM2/TIM5)
+ * prescaled to 1 MHz. Without a timer, microseconds are derived from a
+ * software-extended CYCCNT. The native build runs on a simulated clock that
+ * only moves when a delay is executed or timebase_advance_us() is called,
+ * so host runs are deterministic.
+ *
+ * All 32-bit values wrap; compare them with elapsed()/Deadline, never with
+ * a plain '<'.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace MM::Utils
+{
+
+struct TimebaseConfig
+{
+    /// HCLK in Hz (rate of CYCCNT). Reset default is the 16 MHz HSI.
+    uint32_t core_clock_hz = 16'000'000;
+
+    /// Kernel clock of the timer in Hz (2 x PCLK1 when APB1 is divided)
+    uint32_t timer_clock_hz = 16'000'000;
+
+    /// Base address of a 32-bit TIM (e.g. TIM5_BASE), 0 for CYCCNT only.
+    /// The BSP must enable the timer's RCC clock first.
+    uintptr_t timer_base = 0;
+};
+
+/**
+ * @brief Start the cycle counter and the microsecond timer
+ * @details May be called again after a clock change. Delays used before
+ * the first call initialise the timebase with the defaults.
+ * @return true if successful, false if the config is invalid
+ */
+bool timebase_init(const TimebaseConfig& config);
+
+/**
+ * @brief Whether timebase_init() has succeeded at least once
+ */
+bool timebase_initialised();
+
+/**
+ * @brief Configuration of the last successful timebase_init()
+ */
+const TimebaseConfig& timebase_config();
+
+/**
+ * @brief Current core cycle count (wraps every 2^32 cycles)
+ */
+uint32_t now_cycles();
+
+/**
+ * @brief Current time in microseconds (wraps every ~71 minutes)
+ * @note Without a timer the count is a software extension of CYCCNT, which
+ * only sees one wrap between calls. Something must call now_us() at least
+ * once per 2^32 core cycles (~43 s at 100 MHz) or time is lost.
+ */
+uint32_t now_us();
+
+/**
+ * @brief Current time in milliseconds
+ */
+uint32_t now_ms();
+
+/**
+ * @brief Core cycles per microsecond for the active config
+ */
+uint32_t cycles_per_us();
+
+/**
+ * @brief Wrap-safe time elapsed since an earlier reading
+ */
+constexpr uint32_t elapsed(uint32_t since, uint32_t now)
+{
+    return now - since;
+}
+
+/**
+ * @brief Wrap-safe check that @p now is at or past @p target
+ * @note Valid while the two are less than 2^31 ticks apart.
+ */
+constexpr bool reached(uint32_t target, uint32_t now)
+{
+    return static_cast<int32_t>(now - target) >= 0;
+}
+
+/**
+ * @brief Busy-wait until now_cycles() reaches @p target
+ * @details On native builds this advances the simulated clock instead.
+ */
+void wait_until_cycles(uint32_t target);
+
+#ifndef STM32F4xx
+/**
+ * @brief Advance the simulated clock (native builds only)
+ */
+void timebase_advance_us(uint32_t us);
+#endif
+
+/**
+ * @class Deadline
+ * @brief Microsecond timeout stored as start + duration
+ * @details Storing the duration rather than an absolute target keeps
+ * expired() correct across the counter wrap for any duration < 2^32 us.
+ */
+class Deadline
+{
+public:
+    static Deadline in_us(uint32_t us)
+    {
+        return Deadline(now_us(), us);
+    }
+
+    static Deadline in_ms(uint32_t ms)
+    {
+        return Deadline(now_us(), ms * 1000u);
+    }
+
+    bool expired() const
+    {
+        return elapsed(start, now_us()) >= duration;
+    }
+
+    uint32_t remaining_us() const
+    {
+        const uint32_t spent = elapsed(start, now_us());
+        return spent >= duration ? 0 : duration - spent;
+    }
+
+private:
+    Deadline(uint32_t start_, uint32_t duration_)
+        : start(start_), duration(duration_)
+    {
+    }
+
+    uint32_t start;
+    uint32_t duration;
+};
+
+}  // namespace MM::Utils